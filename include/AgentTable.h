@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Types.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace PixelEngine {
+
+using AgentHandle = uint16_t;
+
+// What a Person did on its last update (for queries and debug display)
+enum class AgentState : uint8_t {
+    Idle,
+    Walking,
+    Falling,
+    Climbing,
+    Building,
+    COUNT
+};
+
+// Structure-of-arrays state of every live Person, indexed by handle.
+//
+// A Person cell only stores its handle (velocity_y plus the lifetime bits,
+// 14 bits in all); health, personality, facing and the AI clock live here.
+// World keeps the table current from set_material / swap_cells, and a
+// spatial hash of 16×16 buckets answers "any Person near here" without
+// scanning cells.
+//
+// Threading: slots never move and buckets never straddle a chunk, so a
+// chunk task may read and write the agents and buckets inside its window
+// like it does cells. Only spawn/despawn touch shared state and take the
+// lock. Inside a chunk task (SpawnScope open) they keep handle numbers off
+// thread timing: spawn takes a provisional slot from the top SPAWN_RESERVE,
+// despawn holds the freed slot back, and commit() settles both serially in
+// chunk order.
+class AgentTable {
+public:
+    static constexpr uint32_t CAPACITY = 1u << 14;     // Handle fits 8 + 6 cell bits
+    static constexpr AgentHandle INVALID = 0xFFFF;
+    static constexpr int32_t BUCKET_SHIFT = 4;         // 16×16 cells per bucket
+    static constexpr uint8_t MAX_HEALTH = 127;
+    static constexpr uint32_t SPAWN_RESERVE = 1024;    // Provisional slots per frame
+    static constexpr uint32_t FINAL_CAPACITY = CAPACITY - SPAWN_RESERVE;
+
+    // Spawns and despawns made by one chunk task of the phased schedule
+    struct SpawnLog {
+        std::vector<AgentHandle> spawned;   // Provisional handles, in spawn order
+        std::vector<AgentHandle> released;  // Freed final handles, in despawn order
+    };
+
+    // Routes this thread's spawn/despawn through a log until destroyed
+    class SpawnScope {
+    public:
+        explicit SpawnScope(SpawnLog& log) : previous_(tls_log_) { tls_log_ = &log; }
+        ~SpawnScope() { tls_log_ = previous_; }
+
+        SpawnScope(const SpawnScope&) = delete;
+        SpawnScope& operator=(const SpawnScope&) = delete;
+
+    private:
+        SpawnLog* previous_;
+    };
+
+    AgentTable();
+
+    // Size the spatial hash for a world; drops every agent
+    void resize(int32_t width, int32_t height);
+
+    // Register a Person at (x, y) with default state. Returns INVALID when
+    // the table (or, in a SpawnScope, the reserve) is full. Thread-safe.
+    AgentHandle spawn(int32_t x, int32_t y);
+    void despawn(AgentHandle handle);
+
+    // Settle a chunk task's log: its released slots go back to the free
+    // list, then each surviving provisional agent moves to a final slot and
+    // rehandle(x, y, handle) rewrites its cell (INVALID if the table is
+    // full). Serial: call for every log in chunk order, then end_spawns().
+    template <typename Fn>
+    void commit(SpawnLog& log, Fn&& rehandle) {
+        free_.insert(free_.end(), log.released.begin(), log.released.end());
+        for (AgentHandle provisional : log.spawned) {
+            if (!alive_[provisional]) continue;  // Gone again during the phases
+            int32_t x = x_[provisional];
+            int32_t y = y_[provisional];
+            rehandle(x, y, settle(provisional));
+        }
+        log.spawned.clear();
+        log.released.clear();
+    }
+
+    // Every log is committed: the reserve is free for the next frame
+    void end_spawns() { reserve_used_ = 0; }
+
+    // The agent's cell moved
+    void move(AgentHandle handle, int32_t x, int32_t y);
+
+    bool is_at(AgentHandle handle, int32_t x, int32_t y) const {
+        return handle < CAPACITY && alive_[handle] && x_[handle] == x && y_[handle] == y;
+    }
+
+    // Agent standing at (x, y), or INVALID (hash lookup)
+    AgentHandle find_at(int32_t x, int32_t y) const;
+
+    // True if an agent stands within the square of the given radius
+    bool any_within(int32_t x, int32_t y, int32_t radius) const;
+
+    // Call fn(handle) for every agent inside the rectangle (inclusive)
+    template <typename Fn>
+    void for_each_within(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y, Fn&& fn) const {
+        int32_t bx0 = std::max(min_x, 0) >> BUCKET_SHIFT;
+        int32_t by0 = std::max(min_y, 0) >> BUCKET_SHIFT;
+        int32_t bx1 = std::min(max_x >> BUCKET_SHIFT, buckets_wide_ - 1);
+        int32_t by1 = std::min(max_y >> BUCKET_SHIFT, buckets_high_ - 1);
+        for (int32_t by = by0; by <= by1; ++by) {
+            for (int32_t bx = bx0; bx <= bx1; ++bx) {
+                for (AgentHandle h = buckets_[by * buckets_wide_ + bx]; h != INVALID; h = next_[h]) {
+                    if (x_[h] >= min_x && x_[h] <= max_x && y_[h] >= min_y && y_[h] <= max_y) {
+                        fn(h);
+                    }
+                }
+            }
+        }
+    }
+
+    // Call fn(handle) for every live agent, in handle order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (uint32_t h = 0; h < high_water_; ++h) {
+            if (alive_[h]) fn(static_cast<AgentHandle>(h));
+        }
+    }
+
+    size_t get_count() const { return count_; }
+    size_t get_state_count(AgentState state) const;
+
+    void clear();
+
+    // Per-agent state
+    int32_t get_x(AgentHandle h) const { return x_[h]; }
+    int32_t get_y(AgentHandle h) const { return y_[h]; }
+
+    uint8_t get_health(AgentHandle h) const { return health_[h]; }
+    void set_health(AgentHandle h, uint8_t health) { health_[h] = health > MAX_HEALTH ? MAX_HEALTH : health; }
+    void damage_health(AgentHandle h, uint8_t amount) { health_[h] = health_[h] > amount ? health_[h] - amount : 0; }
+
+    // Stable per-agent seed for building choices
+    uint8_t get_personality(AgentHandle h) const { return personality_[h]; }
+    void set_personality(AgentHandle h, uint8_t personality) { personality_[h] = personality; }
+
+    bool is_facing_right(AgentHandle h) const { return facing_right_[h] != 0; }
+    void set_facing_right(AgentHandle h, bool right) { facing_right_[h] = right ? 1 : 0; }
+
+    // Frame counter (0-63) timing the AI's periodic behaviors
+    uint8_t get_clock(AgentHandle h) const { return clock_[h]; }
+    void set_clock(AgentHandle h, uint8_t clock) { clock_[h] = clock & 63; }
+
+    AgentState get_state(AgentHandle h) const { return state_[h]; }
+    void set_state(AgentHandle h, AgentState state) { state_[h] = state; }
+
+private:
+    int32_t bucket_of(int32_t x, int32_t y) const {
+        return (y >> BUCKET_SHIFT) * buckets_wide_ + (x >> BUCKET_SHIFT);
+    }
+    void link(AgentHandle h);
+    void unlink(AgentHandle h);
+
+    // Next final slot, or INVALID (caller holds the lock)
+    AgentHandle take_slot();
+    // Move a provisional agent to a final slot; returns it
+    AgentHandle settle(AgentHandle provisional);
+
+    // Columns, CAPACITY entries each
+    std::vector<int16_t> x_;
+    std::vector<int16_t> y_;
+    std::vector<uint8_t> health_;
+    std::vector<uint8_t> personality_;
+    std::vector<uint8_t> facing_right_;
+    std::vector<uint8_t> clock_;
+    std::vector<AgentState> state_;
+    std::vector<uint8_t> alive_;
+
+    // Spatial hash: per-bucket doubly linked lists threaded through the slots
+    std::vector<AgentHandle> next_;
+    std::vector<AgentHandle> prev_;
+    std::vector<AgentHandle> buckets_;
+    int32_t buckets_wide_ = 0;
+    int32_t buckets_high_ = 0;
+
+    std::vector<AgentHandle> free_;  // LIFO, keeps high_water_ low
+    uint32_t high_water_ = 0;        // Slots [0, high_water_) have been used
+    uint32_t reserve_used_ = 0;      // Provisional slots handed out this frame
+    size_t count_ = 0;
+    std::mutex mutex_;
+
+    static inline thread_local SpawnLog* tls_log_ = nullptr;
+};
+
+} // namespace PixelEngine
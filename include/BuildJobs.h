@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PixelEngine {
+
+class World;
+
+// One block of a structure blueprint
+struct BuildBlock {
+    int16_t x;
+    int16_t y;
+    MaterialID material;
+};
+
+// Resumable construction jobs for Person villages.
+//
+// A build_* function no longer stamps its structure in one update_person
+// call: its place_building_block calls are recorded into a blueprint, and
+// step() places a bounded number of blocks per frame (per job and in total),
+// bottom row first, so buildings visibly grow instead of popping in.
+// Jobs are only created and stepped on the simulation's serial path.
+class BuildJobQueue {
+public:
+    static constexpr uint32_t MAX_JOBS = 32;                 // Concurrent construction sites
+    static constexpr uint32_t BLOCKS_PER_JOB_PER_FRAME = 4;  // Growth speed of one site
+    static constexpr uint32_t BLOCKS_PER_FRAME = 48;         // Global per-frame budget
+
+    // Open a blueprint. Fails if every construction slot is busy.
+    bool begin_job();
+
+    // Append a block to the open blueprint (ignored when none is open)
+    void record_block(int32_t x, int32_t y, MaterialID material);
+
+    // Close the blueprint. The job is dropped (returns false) if it is empty
+    // or its bounding box overlaps a site still under construction.
+    bool end_job();
+
+    // True if the rectangle intersects a site still under construction
+    bool overlaps_site(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y) const;
+
+    // Place up to BLOCKS_PER_FRAME blocks across all jobs, round-robin.
+    // Returns the number of blocks placed.
+    uint32_t step(World& world);
+
+    void clear();
+
+    size_t get_job_count() const { return jobs_.size() - (recording_ ? 1 : 0); }
+    uint32_t get_pending_blocks() const;
+
+private:
+    struct Job {
+        int32_t min_x, min_y, max_x, max_y;  // Bounding box of the blueprint
+        std::vector<BuildBlock> blocks;      // Sorted bottom row first
+        size_t next_block = 0;
+    };
+
+    std::vector<Job> jobs_;  // While recording, the open blueprint is jobs_.back()
+    bool recording_ = false;
+    size_t next_job_ = 0;    // Round-robin start for the next step()
+};
+
+} // namespace PixelEngine
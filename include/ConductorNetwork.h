@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace PixelEngine {
+
+class World;
+
+// Connected components of conductor cells (Metal, Copper, Gold, Silver,
+// Steel; 8-connected), so a charge reaches a whole circuit in one frame.
+//
+// World reports every cell that starts or stops conducting (set_material,
+// swap_cells, raw blast writes) and Lightning reports the conductors it
+// touches; both only queue work under a lock, so chunk tasks may call them.
+// step() then applies the frame's changes serially: a new conductor joins
+// (and merges) its neighbours' networks, a removed one marks its network
+// for a relabel by flood fill, and every energized network pulses Sparks
+// into the empty cells around it. Costs follow the networks that changed,
+// not the grid.
+class ConductorNetwork {
+public:
+    static bool is_conductor(MaterialID material) {
+        return material == MaterialID::Metal || material == MaterialID::Copper ||
+               material == MaterialID::Gold || material == MaterialID::Silver ||
+               material == MaterialID::Steel;
+    }
+
+    void resize(int32_t width, int32_t height);
+
+    // Cell (x, y) started or stopped conducting. Thread-safe.
+    void note_change(int32_t x, int32_t y);
+
+    // Charge the network holding the conductor at (x, y); it pulses at the
+    // next step(). Thread-safe.
+    void energize(int32_t x, int32_t y);
+
+    // Apply this frame's changes and pulse energized networks. Serial,
+    // after the cell pass.
+    void step(World& world);
+
+    void clear();
+
+    // Network id of a conductor cell as of the last step() (0 = none)
+    uint32_t get_network(int32_t x, int32_t y) const { return labels_[static_cast<size_t>(y) * width_ + x]; }
+    size_t get_network_size(uint32_t id) const { return networks_[id].size; }
+    size_t get_network_count() const { return networks_.size() - 1 - free_ids_.size(); }
+    size_t get_pulse_count() const { return pulse_count_; }
+
+private:
+    struct Network {
+        std::vector<int32_t> cells;  // Cell indices; may hold stale entries (label check)
+        size_t size = 0;             // Live cells
+        bool dirty = false;          // Lost a cell: may have split
+    };
+
+    uint32_t new_network();
+    void free_network(uint32_t id);
+    void add_cell(const World& world, int32_t index);
+    void remove_cell(int32_t index);
+    void relabel(const World& world, uint32_t id);
+    void pulse(World& world, uint32_t id);
+
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    std::vector<uint32_t> labels_;   // Per cell: network id, 0 = not a conductor
+    std::vector<Network> networks_;  // Indexed by id; [0] unused
+    std::vector<uint32_t> free_ids_;
+    size_t pulse_count_ = 0;
+
+    // Queued by the cell pass (cell indices), drained by step()
+    std::mutex mutex_;
+    std::vector<int32_t> changes_;
+    std::vector<int32_t> charges_;
+
+    // Scratch for step()
+    std::vector<int32_t> pending_;
+    std::vector<uint32_t> ids_;
+    std::vector<int32_t> stack_;
+};
+
+} // namespace PixelEngine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Types.h"
+#include "EventQueue.h"
 #include <bitset>
 #include <vector>
 #include <array>
@@ -93,6 +94,7 @@ public:
 
     // Query unlocked status
     bool is_material_unlocked(MaterialID id) const;
+    const MaterialBitset& get_unlocked_materials() const { return unlocked_materials_; }
     int get_unlocked_count() const;
     int get_total_materials() const;
 
@@ -107,6 +109,11 @@ public:
                                   MaterialID result_a, MaterialID result_b,
                                   uint32_t frame_number);
 
+    // Drain simulation events queued this frame (main thread, once per frame).
+    // Recipes and materials that can no longer produce a discovery are muted
+    // so the simulation stops reporting them. Hint levels are refreshed once.
+    void drain_events(DiscoveryEventQueue& queue, uint32_t frame_number);
+
     // Manual unlock (for achievements, debugging)
     void unlock_material(MaterialID id);
 
@@ -143,6 +150,8 @@ private:
 
     void init_combination_tracking();
     int find_combination_index(MaterialID a, MaterialID b) const;
+    bool apply_combination(int idx, uint32_t frame_number);
+    bool apply_material_spawned(MaterialID id, uint32_t frame_number);
     void update_hint_levels();
 };
 
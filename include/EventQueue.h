@@ -0,0 +1,204 @@
+#pragma once
+
+#include "Types.h"
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace PixelEngine {
+
+// Kind of discovery event emitted by the simulation
+enum class DiscoveryEventType : uint8_t {
+    Combination = 0,      // A recipe from the combination table fired
+    MaterialSpawned = 1   // A material appeared in the world (Story Mode safety net)
+};
+
+// Compact event record (4 bytes) - copied through the ring by value
+struct DiscoveryEvent {
+    DiscoveryEventType type;
+    MaterialID material;    // MaterialSpawned: the material that appeared
+    uint16_t recipe_index;  // Combination: index into the combination table
+
+    DiscoveryEvent()
+        : type(DiscoveryEventType::Combination)
+        , material(MaterialID::Empty)
+        , recipe_index(0) {}
+};
+
+// Bounded lock-free multi-producer / single-consumer ring for discovery events.
+//
+// Producers are simulation threads (material rules, World::set_material); the
+// single consumer is the main thread, which drains the ring once per frame.
+// Duplicate events are collapsed at the producer: each recipe / material owns
+// one "suppressed" bit that stays set while an event for it is queued, or for
+// as long as the consumer has muted it (e.g. the material is already
+// unlocked). In steady state a producer therefore only performs a relaxed load.
+class DiscoveryEventQueue {
+public:
+    static constexpr uint32_t CAPACITY = 1024;    // Must be a power of two
+    static constexpr uint32_t MAX_RECIPES = 512;  // Recipes beyond this are not deduplicated
+
+    DiscoveryEventQueue() { clear(); }
+
+    DiscoveryEventQueue(const DiscoveryEventQueue&) = delete;
+    DiscoveryEventQueue& operator=(const DiscoveryEventQueue&) = delete;
+
+    // Producer side (thread-safe). Returns false if collapsed or the ring is full.
+    bool push_combination(uint16_t recipe_index) {
+        DiscoveryEvent event;
+        event.type = DiscoveryEventType::Combination;
+        event.recipe_index = recipe_index;
+        if (recipe_index >= MAX_RECIPES) {
+            return push(event);
+        }
+        return push_collapsed(recipe_bits_.data(), recipe_index, event);
+    }
+
+    bool push_material_spawned(MaterialID id) {
+        DiscoveryEvent event;
+        event.type = DiscoveryEventType::MaterialSpawned;
+        event.material = id;
+        return push_collapsed(material_bits_.data(), static_cast<uint32_t>(id), event);
+    }
+
+    // Consumer side (main thread only). Calls fn(const DiscoveryEvent&) for
+    // every queued event and returns the number of events drained.
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        size_t count = 0;
+        DiscoveryEvent event;
+        while (pop(event)) {
+            // Release the dedupe bit first so the callback may re-mute it
+            if (event.type == DiscoveryEventType::Combination) {
+                if (event.recipe_index < MAX_RECIPES) {
+                    release(recipe_bits_.data(), recipe_muted_.data(), event.recipe_index);
+                }
+            } else {
+                release(material_bits_.data(), material_muted_.data(),
+                        static_cast<uint32_t>(event.material));
+            }
+            fn(event);
+            ++count;
+        }
+        return count;
+    }
+
+    // Stop reporting a recipe / material until clear() (consumer only)
+    void mute_combination(uint16_t recipe_index) {
+        if (recipe_index < MAX_RECIPES) {
+            mute(recipe_bits_.data(), recipe_muted_.data(), recipe_index);
+        }
+    }
+
+    void mute_material(MaterialID id) {
+        mute(material_bits_.data(), material_muted_.data(), static_cast<uint32_t>(id));
+    }
+
+    // Discard queued events and unmute everything (consumer only, while no
+    // producer is running - e.g. when switching game modes)
+    void clear() {
+        for (uint32_t i = 0; i < CAPACITY; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        head_.store(0, std::memory_order_relaxed);
+        tail_ = 0;
+        for (auto& word : recipe_bits_) word.store(0, std::memory_order_relaxed);
+        for (auto& word : material_bits_) word.store(0, std::memory_order_relaxed);
+        recipe_muted_.fill(0);
+        material_muted_.fill(0);
+        dropped_.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    // Events lost because the ring was full (diagnostics)
+    uint32_t get_dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        DiscoveryEvent event;
+    };
+
+    std::array<Slot, CAPACITY> slots_;
+    alignas(64) std::atomic<uint32_t> head_;   // Next slot claimed by producers
+    alignas(64) uint32_t tail_;                // Next slot read by the consumer
+
+    // Suppressed bits (queued or muted), read by producers
+    std::array<std::atomic<uint64_t>, MAX_RECIPES / 64> recipe_bits_;
+    std::array<std::atomic<uint64_t>, 256 / 64> material_bits_;
+
+    // Muted bits (consumer only)
+    std::array<uint64_t, MAX_RECIPES / 64> recipe_muted_;
+    std::array<uint64_t, 256 / 64> material_muted_;
+
+    std::atomic<uint32_t> dropped_;
+
+    bool push_collapsed(std::atomic<uint64_t>* bits, uint32_t index, const DiscoveryEvent& event) {
+        std::atomic<uint64_t>& word = bits[index >> 6];
+        const uint64_t bit = uint64_t(1) << (index & 63);
+
+        // Cheap shared read first: already queued or muted
+        if (word.load(std::memory_order_relaxed) & bit) return false;
+        if (word.fetch_or(bit, std::memory_order_acq_rel) & bit) return false;
+
+        if (!push(event)) {
+            word.fetch_and(~bit, std::memory_order_acq_rel);  // Allow a retry later
+            return false;
+        }
+        return true;
+    }
+
+    // Vyukov-style bounded queue: each slot's sequence number tells producers
+    // whether it is free for the current lap and the consumer whether it is full.
+    bool push(const DiscoveryEvent& event) {
+        uint32_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & MASK];
+            uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(seq - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.event = event;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;  // Full
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(DiscoveryEvent& out) {
+        Slot& slot = slots_[tail_ & MASK];
+        uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+        if (static_cast<int32_t>(seq - (tail_ + 1)) < 0) {
+            return false;  // Empty
+        }
+        out = slot.event;
+        slot.sequence.store(tail_ + CAPACITY, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    static void release(std::atomic<uint64_t>* bits, const uint64_t* muted, uint32_t index) {
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        if (!(muted[index >> 6] & bit)) {
+            bits[index >> 6].fetch_and(~bit, std::memory_order_acq_rel);
+        }
+    }
+
+    static void mute(std::atomic<uint64_t>* bits, uint64_t* muted, uint32_t index) {
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        muted[index >> 6] |= bit;
+        bits[index >> 6].fetch_or(bit, std::memory_order_acq_rel);
+    }
+};
+
+} // namespace PixelEngine
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Types.h"
+#include <cstdint>
+
+namespace PixelEngine {
+
+class World;
+
+// Every explosive material's blast
+enum class BlastType : uint8_t {
+    TNT = 0,
+    C4,
+    Firework,   // Confetti burst into empty cells only
+    Bomb,
+    Nuke,
+    IceBomb,    // Freezes instead of destroying
+    FireBomb,
+    COUNT
+};
+
+namespace Explosions {
+
+// Apply a blast centred at (x, y).
+//
+// Each blast is a disk split into concentric rings; every ring maps the
+// material under it through a precomputed 256-entry table (optionally one
+// of two tables picked 1-in-N at random). The disk is cached as per-row
+// half-widths, so the blast is written as contiguous row runs straight into
+// chunk memory, followed by one chunk-activation pass over its bounding box
+// and one discovery notification per material it produced.
+void detonate(World& world, int32_t x, int32_t y, BlastType type);
+
+// Outer radius of a blast in cells
+int32_t get_blast_radius(BlastType type);
+
+} // namespace Explosions
+
+} // namespace PixelEngine
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PixelEngine {
+
+class World;
+
+// Shared gravity field of Black_Hole (attractor) and White_Hole (repeller) cells.
+//
+// Hole cells no longer scan their whole well. Each one registers itself per
+// frame into an 8×8-cell tile; step() merges every tile's registrations into
+// one source (integer centroid, mass = cell count), gives each tile in reach
+// the source that pulls it hardest, and runs the pull / push once for every
+// cell of those tiles. Cost follows the affected area, not holes × area.
+class GravityField {
+public:
+    static constexpr int32_t TILE_SIZE = 8;
+
+    enum class SourceKind : uint8_t {
+        Attractor = 0,  // Black_Hole
+        Repeller,       // White_Hole
+        COUNT
+    };
+
+    void resize(int32_t width, int32_t height);
+
+    // Register a hole cell for this frame. Safe to call from parallel chunk tasks.
+    void add_source(int32_t x, int32_t y, SourceKind kind);
+
+    // Merge this frame's sources and apply the field. Serial, after the cell pass.
+    void step(World& world);
+
+    void clear();
+
+    // Merged sources / affected tiles of the last step() (all kinds)
+    size_t get_source_count() const;
+    size_t get_affected_tile_count() const { return affected_tiles_.size(); }
+
+private:
+    // Integer sums, so merging is order-independent and stays deterministic
+    struct Accumulator {
+        std::atomic<uint32_t> mass{0};
+        std::atomic<uint32_t> sum_x{0};
+        std::atomic<uint32_t> sum_y{0};
+    };
+
+    struct Source {
+        int32_t x;
+        int32_t y;
+        uint32_t mass;
+    };
+
+    static constexpr size_t KIND_COUNT = static_cast<size_t>(SourceKind::COUNT);
+
+    void collect_sources(SourceKind kind);
+    void assign_tiles(SourceKind kind);
+    void apply_tile(World& world, SourceKind kind, int32_t tile);
+
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    int32_t tiles_wide_ = 0;
+    int32_t tiles_high_ = 0;
+
+    std::unique_ptr<Accumulator[]> accumulators_[KIND_COUNT];
+    std::atomic<uint32_t> occupied_tiles_[KIND_COUNT] = {};  // Tiles with mass this frame
+    std::vector<Source> sources_[KIND_COUNT];
+    std::vector<int32_t> tile_source_[KIND_COUNT];  // Per tile: index into sources_, -1 = none
+    std::vector<int32_t> affected_tiles_;           // Tiles with any source, ascending
+};
+
+} // namespace PixelEngine
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PixelEngine {
+
+class World;
+
+// Communicating-vessels solver for resting liquid bodies.
+//
+// Per-cell flow moves water a few cells sideways per frame, so a wide basin
+// takes thousands of frames to level and keeps its chunks awake meanwhile.
+// Every few frames step() labels the connected bodies of one resting liquid
+// (Materials::LEVELED_LIQUIDS) that touch an active chunk (scanline fill,
+// labels never cleared: each body gets a fresh id) and levels each body in
+// bulk: surface cells of the highest columns move into the lowest free spots
+// along the body (open cells above its surface, or cells beside it resting
+// on a solid, a powder or the body itself) until no spot is two or more rows
+// below a surface. Falling water (velocity_y above one frame of gravity) is
+// not part of a body, so streams and waterfalls still fall by the cell
+// rules. Once a solve has moved MAX_MOVES_PER_STEP cells it stops, and the
+// next one starts from the chunk where it stopped.
+//
+// Runs serially after the cell pass; the result depends only on the world.
+class LiquidLeveler {
+public:
+    static constexpr uint32_t INTERVAL = 4;               // Frames between solves
+    static constexpr uint32_t MAX_MOVES_PER_STEP = 4096;  // Cells relocated per solve
+
+    void resize(int32_t width, int32_t height);
+
+    // Level bodies that touch an active chunk. Returns the number of cells moved.
+    uint32_t step(World& world);
+
+    // Bodies labeled by the last solve
+    size_t get_body_count() const { return body_count_; }
+
+private:
+    struct Span {
+        int16_t y, x0, x1;
+    };
+
+    // Surface cell or free spot, ordered for the heaps
+    struct Slot {
+        int16_t x, y;
+    };
+
+    bool is_body_cell(const World& world, int32_t x, int32_t y) const;
+    bool is_supported(const World& world, int32_t x, int32_t y) const;
+    uint32_t scan_chunk(World& world, int32_t chunk_x, int32_t chunk_y, uint32_t first_label, uint32_t budget);
+    void label_body(World& world, int32_t seed_x, int32_t seed_y);
+    uint32_t level_body(World& world, uint32_t budget);
+
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    uint32_t frame_ = 0;
+    size_t body_count_ = 0;
+    int32_t resume_chunk_ = 0;  // Chunk index the next solve starts from
+
+    std::vector<uint32_t> labels_;  // Body id per cell; stale ids are simply older
+    uint32_t next_label_ = 1;
+    uint32_t current_label_ = 0;
+    MaterialID current_material_ = MaterialID::Empty;
+
+    // Scratch for the body being solved
+    std::vector<Span> spans_;
+    std::vector<Slot> stack_;
+    std::vector<Slot> tops_;
+    std::vector<Slot> holes_;
+};
+
+} // namespace PixelEngine
@@ -2,7 +2,10 @@
 
 #include "Types.h"
 #include <array>
+#include <bit>
+#include <bitset>
 #include <random>
+#include <vector>
 
 namespace PixelEngine {
 
@@ -17,15 +20,15 @@ struct MaterialDef {
     Color base_color;
     uint8_t color_variance; // Random color variation (0-255)
 
-    MaterialDef()
+    constexpr MaterialDef()
         : id(MaterialID::Empty)
         , state(MaterialState::Empty)
         , density(0.0f)
         , base_color()
         , color_variance(0) {}
 
-    MaterialDef(MaterialID id, MaterialState state, float density,
-                Color color, uint8_t variance = 0)
+    constexpr MaterialDef(MaterialID id, MaterialState state, float density,
+                          Color color, uint8_t variance = 0)
         : id(id)
         , state(state)
         , density(density)
@@ -36,24 +39,34 @@ struct MaterialDef {
     Color get_color(std::mt19937& rng) const;
 };
 
-// Material system - manages all material definitions
+// Palette category of a material in the UI (Materials.def)
+enum class PaletteCategory : uint8_t {
+    Basic, Powders, Liquids, Gases, Solids, Organic, Special, Fantasy,
+    None  // Not placeable from the palette
+};
+
+// Every material's definition, by id, built at compile time from Materials.def
+inline constexpr std::array<MaterialDef, static_cast<size_t>(MaterialID::COUNT)> MATERIAL_DEFS = {{
+#define MATERIAL(Name, Id, Update, State, Density, R, G, B, A, Variance, ...) \
+    MaterialDef(MaterialID::Name, MaterialState::State, Density, Color(R, G, B, A), Variance),
+#include "Materials.def"
+}};
+
+// Material system - hands out material definitions and colors
 class MaterialSystem {
 public:
     MaterialSystem();
 
     // Get material definition
     const MaterialDef& get_material(MaterialID id) const {
-        return materials_[static_cast<size_t>(id)];
+        return MATERIAL_DEFS[static_cast<size_t>(id)];
     }
 
     // Get random color for material
     Color get_material_color(MaterialID id);
 
 private:
-    std::array<MaterialDef, static_cast<size_t>(MaterialID::COUNT)> materials_;
     std::mt19937 rng_;
-
-    void initialize_materials();
 };
 
 // Material update functions (simulation rules)
@@ -77,262 +90,177 @@ inline void update_stone(World& world, int32_t x, int32_t y) {
     (void)y;
 }
 
-// Sand falls down, slides diagonally if blocked
-void update_sand(World& world, int32_t x, int32_t y);
-
-// Water falls down, spreads horizontally
-void update_water(World& world, int32_t x, int32_t y);
-
-// Steam rises and disperses
-void update_steam(World& world, int32_t x, int32_t y);
-
-// Oil flows like water but slower, floats on water
-void update_oil(World& world, int32_t x, int32_t y);
-
-// Fire rises, spreads to flammable materials, has lifetime
-void update_fire(World& world, int32_t x, int32_t y);
-
-// Wood is static, but can burn and float
-void update_wood(World& world, int32_t x, int32_t y);
-
-// Acid corrodes solids and flows like water
-void update_acid(World& world, int32_t x, int32_t y);
-
-// Lava burns and solidifies on contact with water
-void update_lava(World& world, int32_t x, int32_t y);
-
-// Ash rises slowly then settles
-void update_ash(World& world, int32_t x, int32_t y);
-
-// Grass is static but can burn
-void update_grass(World& world, int32_t x, int32_t y);
-
-// Smoke rises and dissipates
-void update_smoke(World& world, int32_t x, int32_t y);
-
-// Person: Autonomous agent that walks, falls, reproduces
-void update_person(World& world, int32_t x, int32_t y);
-
-// ============================================================================
-// NEW MATERIAL UPDATE FUNCTIONS
-// ============================================================================
-
-// Powders (10-19)
-void update_dirt(World& world, int32_t x, int32_t y);
-void update_gravel(World& world, int32_t x, int32_t y);
-void update_snow(World& world, int32_t x, int32_t y);
-void update_gunpowder(World& world, int32_t x, int32_t y);
-void update_salt(World& world, int32_t x, int32_t y);
-void update_coal(World& world, int32_t x, int32_t y);
-void update_sawdust(World& world, int32_t x, int32_t y);
-void update_glass_powder(World& world, int32_t x, int32_t y);
-
-// Liquids (20-29)
-void update_honey(World& world, int32_t x, int32_t y);
-void update_mud(World& world, int32_t x, int32_t y);
-void update_blood(World& world, int32_t x, int32_t y);
-void update_poison(World& world, int32_t x, int32_t y);
-void update_slime(World& world, int32_t x, int32_t y);
-void update_milk(World& world, int32_t x, int32_t y);
-void update_alcohol(World& world, int32_t x, int32_t y);
-void update_mercury(World& world, int32_t x, int32_t y);
-void update_petrol(World& world, int32_t x, int32_t y);
-void update_glue(World& world, int32_t x, int32_t y);
-
-// Gases (30-39)
-void update_toxic_gas(World& world, int32_t x, int32_t y);
-void update_hydrogen(World& world, int32_t x, int32_t y);
-void update_helium(World& world, int32_t x, int32_t y);
-void update_methane(World& world, int32_t x, int32_t y);
-void update_spark(World& world, int32_t x, int32_t y);
-void update_plasma(World& world, int32_t x, int32_t y);
-void update_dust(World& world, int32_t x, int32_t y);
-void update_spore(World& world, int32_t x, int32_t y);
-void update_confetti(World& world, int32_t x, int32_t y);
-
-// Solids (40-49)
-void update_metal(World& world, int32_t x, int32_t y);
-void update_gold(World& world, int32_t x, int32_t y);
-void update_ice(World& world, int32_t x, int32_t y);
-void update_glass(World& world, int32_t x, int32_t y);
-void update_brick(World& world, int32_t x, int32_t y);
-void update_obsidian(World& world, int32_t x, int32_t y);
-void update_diamond(World& world, int32_t x, int32_t y);
-void update_copper(World& world, int32_t x, int32_t y);
-void update_rubber(World& world, int32_t x, int32_t y);
-
-// Organic (50-59)
-void update_leaf(World& world, int32_t x, int32_t y);
-void update_moss(World& world, int32_t x, int32_t y);
-void update_vine(World& world, int32_t x, int32_t y);
-void update_fungus(World& world, int32_t x, int32_t y);
-void update_seed(World& world, int32_t x, int32_t y);
-void update_flower(World& world, int32_t x, int32_t y);
-void update_algae(World& world, int32_t x, int32_t y);
-void update_coral(World& world, int32_t x, int32_t y);
-void update_wax(World& world, int32_t x, int32_t y);
-void update_flesh(World& world, int32_t x, int32_t y);
-
-// Special (60-69)
-void update_clone(World& world, int32_t x, int32_t y);
-void update_void(World& world, int32_t x, int32_t y);
-void update_fuse(World& world, int32_t x, int32_t y);
-void update_tnt(World& world, int32_t x, int32_t y);
-void update_c4(World& world, int32_t x, int32_t y);
-void update_firework(World& world, int32_t x, int32_t y);
-void update_lightning(World& world, int32_t x, int32_t y);
-void update_portal_in(World& world, int32_t x, int32_t y);
-void update_portal_out(World& world, int32_t x, int32_t y);
-
-// Fantasy (70-79)
-void update_magic(World& world, int32_t x, int32_t y);
-void update_crystal(World& world, int32_t x, int32_t y);
-void update_ectoplasm(World& world, int32_t x, int32_t y);
-void update_antimatter(World& world, int32_t x, int32_t y);
-void update_fairy_dust(World& world, int32_t x, int32_t y);
-void update_dragon_fire(World& world, int32_t x, int32_t y);
-void update_frost(World& world, int32_t x, int32_t y);
-void update_ember(World& world, int32_t x, int32_t y);
-void update_stardust(World& world, int32_t x, int32_t y);
-void update_void_dust(World& world, int32_t x, int32_t y);
-
-// Rust (powder) - missing from above
-void update_rust(World& world, int32_t x, int32_t y);
-
-// Life (spawner particle) - falls and creates Person on safe ground
-void update_life(World& world, int32_t x, int32_t y);
-
-// ============================================================================
-// NEW MATERIALS (81-102)
-// ============================================================================
-
-// New Powders (81-85)
-void update_thermite_powder(World& world, int32_t x, int32_t y);
-void update_sugar(World& world, int32_t x, int32_t y);
-void update_iron_filings(World& world, int32_t x, int32_t y);
-void update_chalk(World& world, int32_t x, int32_t y);
-void update_calcium(World& world, int32_t x, int32_t y);
-
-// New Liquids (86-90)
-void update_tar(World& world, int32_t x, int32_t y);
-void update_juice(World& world, int32_t x, int32_t y);
-void update_sap(World& world, int32_t x, int32_t y);
-void update_bleach(World& world, int32_t x, int32_t y);
-void update_ink(World& world, int32_t x, int32_t y);
-
-// New Gases (91-93)
-void update_chlorine(World& world, int32_t x, int32_t y);
-void update_liquid_nitrogen(World& world, int32_t x, int32_t y);
-void update_oxygen(World& world, int32_t x, int32_t y);
-
-// New Solids (94-97)
-void update_concrete(World& world, int32_t x, int32_t y);
-void update_titanium(World& world, int32_t x, int32_t y);
-void update_clay(World& world, int32_t x, int32_t y);
-void update_charcoal(World& world, int32_t x, int32_t y);
-
-// New Organic (98-100)
-void update_bamboo(World& world, int32_t x, int32_t y);
-void update_honeycomb(World& world, int32_t x, int32_t y);
-void update_bone(World& world, int32_t x, int32_t y);
-
-// New Special (101-102)
-void update_napalm(World& world, int32_t x, int32_t y);
-void update_thermite(World& world, int32_t x, int32_t y);
-
-// ============================================================================
-// EXPANSION MATERIALS (103-161)
-// ============================================================================
-
-// Expansion: Basic (103-112)
-void update_bedrock(World& world, int32_t x, int32_t y);
-void update_ceramic(World& world, int32_t x, int32_t y);
-void update_granite(World& world, int32_t x, int32_t y);
-void update_marble(World& world, int32_t x, int32_t y);
-void update_sandstone(World& world, int32_t x, int32_t y);
-void update_limestone(World& world, int32_t x, int32_t y);
-void update_slate(World& world, int32_t x, int32_t y);
-void update_basalt(World& world, int32_t x, int32_t y);
-void update_quartz_block(World& world, int32_t x, int32_t y);
-void update_soil(World& world, int32_t x, int32_t y);
-
-// Expansion: Powders (113-117)
-void update_flour(World& world, int32_t x, int32_t y);
-void update_sulfur(World& world, int32_t x, int32_t y);
-void update_cement(World& world, int32_t x, int32_t y);
-void update_fertilizer(World& world, int32_t x, int32_t y);
-void update_volcanic_ash(World& world, int32_t x, int32_t y);
-
-// Expansion: Liquids (118-122)
-void update_brine(World& world, int32_t x, int32_t y);
-void update_coffee(World& world, int32_t x, int32_t y);
-void update_soap(World& world, int32_t x, int32_t y);
-void update_paint(World& world, int32_t x, int32_t y);
-void update_sewage(World& world, int32_t x, int32_t y);
-
-// Expansion: Gases (123-129)
-void update_ammonia(World& world, int32_t x, int32_t y);
-void update_carbon_dioxide(World& world, int32_t x, int32_t y);
-void update_nitrous(World& world, int32_t x, int32_t y);
-void update_steam_hot(World& world, int32_t x, int32_t y);
-void update_miasma(World& world, int32_t x, int32_t y);
-void update_pheromone(World& world, int32_t x, int32_t y);
-void update_nerve_gas(World& world, int32_t x, int32_t y);
-
-// Expansion: Solids (130-136)
-void update_silver(World& world, int32_t x, int32_t y);
-void update_platinum(World& world, int32_t x, int32_t y);
-void update_lead(World& world, int32_t x, int32_t y);
-void update_tin(World& world, int32_t x, int32_t y);
-void update_zinc(World& world, int32_t x, int32_t y);
-void update_bronze(World& world, int32_t x, int32_t y);
-void update_steel(World& world, int32_t x, int32_t y);
-
-// Expansion: Organic (137-143)
-void update_pollen(World& world, int32_t x, int32_t y);
-void update_root(World& world, int32_t x, int32_t y);
-void update_bark(World& world, int32_t x, int32_t y);
-void update_fruit(World& world, int32_t x, int32_t y);
-void update_egg(World& world, int32_t x, int32_t y);
-void update_web(World& world, int32_t x, int32_t y);
-void update_mucus(World& world, int32_t x, int32_t y);
-
-// Expansion: Special (144-151)
-void update_bomb(World& world, int32_t x, int32_t y);
-void update_nuke(World& world, int32_t x, int32_t y);
-void update_laser(World& world, int32_t x, int32_t y);
-void update_black_hole(World& world, int32_t x, int32_t y);
-void update_white_hole(World& world, int32_t x, int32_t y);
-void update_acid_gas(World& world, int32_t x, int32_t y);
-void update_ice_bomb(World& world, int32_t x, int32_t y);
-void update_fire_bomb(World& world, int32_t x, int32_t y);
-
-// Expansion: Fantasy (152-161)
-void update_mana(World& world, int32_t x, int32_t y);
-void update_mirage(World& world, int32_t x, int32_t y);
-void update_holy_water(World& world, int32_t x, int32_t y);
-void update_cursed(World& world, int32_t x, int32_t y);
-void update_blessed(World& world, int32_t x, int32_t y);
-void update_soul(World& world, int32_t x, int32_t y);
-void update_spirit(World& world, int32_t x, int32_t y);
-void update_aether(World& world, int32_t x, int32_t y);
-void update_nether(World& world, int32_t x, int32_t y);
-void update_phoenix_ash(World& world, int32_t x, int32_t y);
-
-// Discovery system callback types
-using CombinationCallback = void(*)(MaterialID mat_a, MaterialID mat_b,
-                                     MaterialID result_a, MaterialID result_b,
-                                     uint32_t frame_number);
-
-using MaterialUnlockChecker = bool(*)(MaterialID);
+// One rule per material, named in Materials.def (update_empty and
+// update_stone above are inline no-ops)
+#define MATERIAL(Name, Id, Update, ...) void Update(World& world, int32_t x, int32_t y);
+#include "Materials.def"
+
+// Dense per-id tables generated from Materials.def. Simulation dispatches
+// through UPDATE_FUNCTIONS; the UI reads labels and palette placement.
+using UpdateFunction = void (*)(World& world, int32_t x, int32_t y);
+inline constexpr UpdateFunction UPDATE_FUNCTIONS[] = {
+#define MATERIAL(Name, Id, Update, ...) &Update,
+#include "Materials.def"
+};
+inline constexpr const char* MATERIAL_LABELS[] = {
+#define MATERIAL(Name, Id, Update, State, Density, R, G, B, A, Variance, Palette, Slot, Label) Label,
+#include "Materials.def"
+};
+inline constexpr PaletteCategory MATERIAL_PALETTE[] = {
+#define MATERIAL(Name, Id, Update, State, Density, R, G, B, A, Variance, Palette, ...) PaletteCategory::Palette,
+#include "Materials.def"
+};
+inline constexpr int8_t MATERIAL_PALETTE_SLOT[] = {
+#define MATERIAL(Name, Id, Update, State, Density, R, G, B, A, Variance, Palette, Slot, ...) Slot,
+#include "Materials.def"
+};
+
+// The tables are indexed by id, so Materials.def must list ids 0, 1, 2, ...
+constexpr bool registry_is_dense() {
+    constexpr MaterialID ids[] = {
+#define MATERIAL(Name, ...) MaterialID::Name,
+#include "Materials.def"
+    };
+    for (size_t i = 0; i < std::size(ids); ++i) {
+        if (static_cast<size_t>(ids[i]) != i) return false;
+    }
+    return std::size(ids) == static_cast<size_t>(MaterialID::COUNT);
+}
+static_assert(registry_is_dense(), "Materials.def rows must be in id order with no gaps");
+
+// Combination recipes compiled for try_material_combination. Row m holds a
+// 256-bit mask of the materials m reacts with, so the per-neighbour probe
+// is one bit test in one cache line. A pair's outcomes (every recipe for
+// it, not just the last one listed) share one random draw: outcome i fires
+// when the draw is <= its cumulative limit, so each keeps its 1-in-chance
+// odds without a modulo. In Story Mode the world builds the table from
+// the unlocked recipes only (World::set_reaction_filter).
+struct ReactionOutcome {
+    uint32_t limit;           // Fires when draw <= limit (cumulative within the pair)
+    uint16_t recipe;          // Index into the recipe list (discovery events)
+    MaterialID self_result;   // What the probing cell becomes
+    MaterialID other_result;  // What the neighbour becomes
+};
+
+struct alignas(64) ReactionRow {
+    uint64_t partners[4] = {};  // Bit n: some recipe pairs this material with n
+    uint32_t first_pair = 0;    // Pair index of the lowest partner
+    uint8_t word_rank[4] = {};  // Partners in the words before each word
+
+    bool reacts_with(MaterialID other) const {
+        uint8_t n = static_cast<uint8_t>(other);
+        return (partners[n >> 6] >> (n & 63)) & 1;
+    }
+
+    // Pair index of a partner (reacts_with(other) must hold)
+    uint32_t pair_index(MaterialID other) const {
+        uint8_t n = static_cast<uint8_t>(other);
+        uint64_t below = partners[n >> 6] & ((uint64_t{1} << (n & 63)) - 1);
+        return first_pair + word_rank[n >> 6] + static_cast<uint32_t>(std::popcount(below));
+    }
+};
+static_assert(sizeof(ReactionRow) == 64, "one probe, one cache line");
+
+class ReactionTable {
+public:
+    // Compile every recipe, or with `allowed` only those whose two inputs it holds
+    void build(const std::bitset<256>* allowed = nullptr);
+
+    const ReactionRow& row(MaterialID material) const { return rows_[static_cast<uint8_t>(material)]; }
+    bool has_reactions(MaterialID material) const {
+        const ReactionRow& r = row(material);
+        return (r.partners[0] | r.partners[1] | r.partners[2] | r.partners[3]) != 0;
+    }
+
+    // Outcome of one roll for a pair (row.reacts_with(other) must hold), or nullptr
+    const ReactionOutcome* roll(const ReactionRow& row, MaterialID other, uint32_t draw) const {
+        uint32_t pair = row.pair_index(other);
+        for (uint32_t i = pair_starts_[pair]; i < pair_starts_[pair + 1]; ++i) {
+            if (draw <= outcomes_[i].limit) return &outcomes_[i];
+        }
+        return nullptr;
+    }
+
+private:
+    std::array<ReactionRow, 256> rows_;
+    std::vector<uint32_t> pair_starts_;  // Pair k's outcomes: [pair_starts_[k], pair_starts_[k + 1])
+    std::vector<ReactionOutcome> outcomes_;
+};
+
+// Lookup tables for Simulation's rest kernel. A "plain" powder's rule is:
+// react with specific neighbours, otherwise fall/slide like sand
+// (update_sand / generic_powder_update). A "plain" liquid's rule is: react
+// through try_material_combination, otherwise fall, slide diagonally down or
+// spread sideways onto empty cells of its own row (update_water, update_oil,
+// generic_slow_liquid_update). The kernel uses these tables to find cells
+// that can neither move nor react without running their rule; the answer
+// only depends on the materials around the cell, so it holds until one of
+// them changes. All arrays are indexed by the raw MaterialID byte.
+struct RestKernelTables {
+    std::array<uint16_t, 256> powder_bit;          // Plain powder -> its own bit, 0 otherwise
+    std::array<uint16_t, 256> reacts_with;         // Neighbour -> bits of plain powders it can trigger
+    std::array<uint16_t, 256> liquid_bit;          // Plain liquid -> its own bit, 0 otherwise
+    std::array<uint16_t, 256> liquid_reacts_with;  // Neighbour -> bits of plain liquids it can trigger
+    std::array<uint8_t, 256> liquid_reach;         // Plain liquid -> farthest sideways move
+    std::array<uint8_t, 256> move_rank;            // Density rank of a falling cell (1-254)
+    std::array<uint8_t, 256> sink_key;             // Target: 0 = empty, 255 = solid, else density rank
+};
+
+// Widest liquid_reach (water spreads up to 4 cells): a cell's rest state
+// depends on the cells up to this far along its row and one row up / down
+constexpr int32_t REST_KERNEL_REACH = 4;
+
+// A falling cell can enter a cell iff sink_key[target] < move_rank[mover]
+void build_rest_kernel_tables(const MaterialSystem& material_system, RestKernelTables& tables);
+
+// Materials whose per-frame rule does nothing. The cell pass never calls
+// them and treats them like resting cells; whatever happens to them is done
+// by a neighbour's rule (Acid, Fire, Lightning, ...) or a World pass.
+constexpr MaterialID INERT_MATERIALS[] = {
+    MaterialID::Empty, MaterialID::Stone, MaterialID::Metal, MaterialID::Gold, MaterialID::Glass,
+    MaterialID::Brick, MaterialID::Obsidian, MaterialID::Diamond, MaterialID::Portal_Out,
+    MaterialID::Concrete, MaterialID::Titanium, MaterialID::Bedrock, MaterialID::Ceramic,
+    MaterialID::Granite, MaterialID::Slate, MaterialID::Basalt, MaterialID::Quartz_Block,
+    MaterialID::Silver, MaterialID::Platinum, MaterialID::Lead, MaterialID::Tin, MaterialID::Bronze,
+    MaterialID::Root,
+};
+
+// Slow growers roll their growth on random ticks instead of every frame:
+// Simulation picks CHUNK_SIZE² / RANDOM_TICK_INTERVAL random cells per
+// chunk holding any of them (asleep or not) each frame and calls
+// random_tick(), so each cell is ticked once per RANDOM_TICK_INTERVAL frames
+// on average. Their per-frame rules keep only what reacts to neighbours
+// (burning, combinations, falling), so settled growth can sleep.
+constexpr uint32_t RANDOM_TICK_INTERVAL = 16;  // Fastest grower: Fertilizer, 1 in 30 frames
+constexpr MaterialID RANDOM_TICK_MATERIALS[] = {
+    MaterialID::Moss, MaterialID::Vine, MaterialID::Fungus, MaterialID::Coral, MaterialID::Bamboo,
+    MaterialID::Fertilizer, MaterialID::Root, MaterialID::Egg, MaterialID::Cursed,
+};
+void random_tick(World& world, int32_t x, int32_t y, MaterialID material);
+
+// Liquids the LiquidLeveler pours level in bulk: the plain liquids of the
+// rest kernel (PLAIN_LIQUIDS), whose rule only falls, slides and spreads,
+// so moving a resting cell skips nothing but time.
+constexpr MaterialID LEVELED_LIQUIDS[] = {
+    MaterialID::Water, MaterialID::Oil, MaterialID::Honey, MaterialID::Blood,
+    MaterialID::Slime, MaterialID::Ink, MaterialID::Paint, MaterialID::Mucus,
+};
+
+// Black_Hole / White_Hole reach. Beyond the hole's own few cells, the pull
+// and push are applied by World::gravity_field() rather than by each cell.
+constexpr int32_t BLACK_HOLE_GRAVITY_WELL = 30;
+constexpr int32_t BLACK_HOLE_PHOTON_SPHERE = 3;
+constexpr int32_t WHITE_HOLE_PUSH_RADIUS = 15;
+
+// Pull / push the cell at (px, py), offset (dx, dy) from a hole of the given
+// merged mass (number of hole cells). Moved cells are marked updated.
+void apply_black_hole_pull(World& world, int32_t px, int32_t py, int32_t dx, int32_t dy, uint32_t mass);
+void apply_white_hole_push(World& world, int32_t px, int32_t py, int32_t dx, int32_t dy, uint32_t mass);
 
 } // namespace Materials
 
-// Discovery system integration (defined in Material.cpp, called from main.cpp)
-void set_discovery_callback(Materials::CombinationCallback callback);
-void set_story_mode(bool active);
-void set_material_unlock_checker(Materials::MaterialUnlockChecker checker);
-void set_current_frame(uint32_t frame);
+// Discovery system integration: combinations are reported through
+// World::discovery_events() and filtered by World::set_reaction_filter()
 
 // Get combination data for DiscoverySystem initialization
 const void* get_combinations_data();
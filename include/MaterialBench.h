@@ -0,0 +1,13 @@
+#pragma once
+
+namespace PixelEngine {
+
+// Headless per-material benchmark: PixelEngine --bench [options]
+//
+// Each material gets a fresh walled world, half filled with it at random,
+// stepped single-threaded with rest detection off so every cell runs its
+// rule every frame. Reports nanoseconds per live cell per frame; compare
+// runs before and after a rule change.
+int run_material_bench_cli(int argc, char* argv[]);
+
+} // namespace PixelEngine
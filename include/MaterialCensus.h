@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Types.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace PixelEngine {
+
+// Live count of every material, per chunk, plus a per-material bitmap of
+// the chunks that contain it.
+//
+// World updates it on every write (set_material, cross-chunk swap_cells,
+// raw blast writes, clear_world), so questions like "where are the Person
+// cells" or "is there any Portal_Out" never need a grid scan. Chunk counts
+// are only touched by the task that owns the chunk's phase window; the
+// presence bits are shared between neighbouring chunks and flip atomically.
+class MaterialCensus {
+public:
+    static constexpr size_t MATERIAL_COUNT = static_cast<size_t>(MaterialID::COUNT);
+
+    // All chunks start out Empty
+    void resize(int32_t chunk_count);
+
+    // One cell of chunk `chunk_index` changed from `from` to `to`
+    void replace(int32_t chunk_index, MaterialID from, MaterialID to) {
+        if (from == to) return;
+        uint16_t* counts = counts_[chunk_index].data();
+        if (--counts[static_cast<size_t>(from)] == 0) {
+            clear_presence(from, chunk_index);
+        }
+        if (counts[static_cast<size_t>(to)]++ == 0) {
+            set_presence(to, chunk_index);
+        }
+    }
+
+    // Chunk reset to all Empty
+    void reset_chunk(int32_t chunk_index);
+
+    uint32_t get_chunk_count(int32_t chunk_index, MaterialID material) const {
+        return counts_[chunk_index][static_cast<size_t>(material)];
+    }
+    bool chunk_contains(int32_t chunk_index, MaterialID material) const {
+        return (presence_word(material, chunk_index).load(std::memory_order_relaxed) >> (chunk_index & 63)) & 1;
+    }
+
+    // True if any chunk holds the material
+    bool contains(MaterialID material) const;
+
+    // Total cells of the material (sums the chunks holding it)
+    uint32_t get_count(MaterialID material) const;
+
+    // Counts of every material, indexed by MaterialID
+    void get_histogram(std::array<uint32_t, MATERIAL_COUNT>& histogram) const;
+
+    // Call fn(chunk_index) for every chunk holding the material, in index order
+    template <typename Fn>
+    void for_each_chunk_with(MaterialID material, Fn&& fn) const {
+        const std::atomic<uint64_t>* words = &presence_[static_cast<size_t>(material) * words_per_material_];
+        for (int32_t word = 0; word < words_per_material_; ++word) {
+            uint64_t bits = words[word].load(std::memory_order_relaxed);
+            while (bits) {
+                int32_t bit = __builtin_ctzll(bits);
+                bits &= bits - 1;
+                fn(word * 64 + bit);
+            }
+        }
+    }
+
+private:
+    std::atomic<uint64_t>& presence_word(MaterialID material, int32_t chunk_index) {
+        return presence_[static_cast<size_t>(material) * words_per_material_ + (chunk_index >> 6)];
+    }
+    const std::atomic<uint64_t>& presence_word(MaterialID material, int32_t chunk_index) const {
+        return presence_[static_cast<size_t>(material) * words_per_material_ + (chunk_index >> 6)];
+    }
+    void set_presence(MaterialID material, int32_t chunk_index) {
+        presence_word(material, chunk_index).fetch_or(1ull << (chunk_index & 63), std::memory_order_relaxed);
+    }
+    void clear_presence(MaterialID material, int32_t chunk_index) {
+        presence_word(material, chunk_index).fetch_and(~(1ull << (chunk_index & 63)), std::memory_order_relaxed);
+    }
+
+    int32_t words_per_material_ = 0;
+    std::vector<std::array<uint16_t, MATERIAL_COUNT>> counts_;  // Per chunk, indexed by MaterialID
+    std::unique_ptr<std::atomic<uint64_t>[]> presence_;         // MATERIAL_COUNT × words_per_material_
+};
+
+} // namespace PixelEngine
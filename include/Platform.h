@@ -21,6 +21,12 @@ enum class ToolMode : uint8_t {
     Pipette = 5     // Inspect/pick material under cursor
 };
 
+// One mouse position in world coordinates
+struct MouseSample {
+    int32_t x;
+    int32_t y;
+};
+
 // Input state
 struct InputState {
     bool mouse_left_down;
@@ -28,6 +34,13 @@ struct InputState {
     int32_t mouse_x;
     int32_t mouse_y;
 
+    // Every position reported while a button was held since the last update
+    // (oldest first), so fast strokes can be drawn without gaps. The editor
+    // drains it each update; when full, the newest sample replaces the last.
+    static constexpr int32_t MAX_MOUSE_SAMPLES = 64;
+    MouseSample mouse_samples[MAX_MOUSE_SAMPLES];
+    int32_t mouse_sample_count;
+
     // Current window/view size (updated on resize)
     int32_t view_width;
     int32_t view_height;
@@ -93,6 +106,8 @@ struct InputState {
         , mouse_right_down(false)
         , mouse_x(0)
         , mouse_y(0)
+        , mouse_samples{}
+        , mouse_sample_count(0)
         , view_width(WORLD_WIDTH)
         , view_height(WORLD_HEIGHT)
         , selected_material(MaterialID::Sand)
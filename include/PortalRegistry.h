@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PixelEngine {
+
+// Live Portal_In / Portal_Out cells of a world, grouped by channel.
+//
+// World keeps it current from set_material, swap_cells and raw blast writes,
+// so Portal_In never scans the grid: it asks for an exit on its own channel.
+// A portal's channel is stored in its cell's lifetime bits (0-63); new
+// portals start on channel 0, so untouched scenes pair every entrance with
+// every exit as before. Each exit cell remembers its position in its
+// channel's list, so adding or removing one is O(1) (swap-pop).
+class PortalRegistry {
+public:
+    static constexpr uint32_t CHANNEL_COUNT = 64;
+
+    static bool is_portal(MaterialID material) {
+        return material == MaterialID::Portal_In || material == MaterialID::Portal_Out;
+    }
+
+    // Size the per-cell exit index for a world; drops every portal
+    void resize(int32_t width, int32_t height);
+
+    // Record a portal appearing / disappearing. Thread-safe (any cell update
+    // can create or destroy a portal); callers only pay for the lock when a
+    // portal is involved. Pass in_order = false from parallel chunk tasks:
+    // their edits arrive in thread-timing order, so the channel is sorted
+    // again before its next pick.
+    void add(int32_t x, int32_t y, MaterialID material, uint8_t channel, bool in_order = true);
+    void remove(int32_t x, int32_t y, MaterialID material, uint8_t channel, bool in_order = true);
+
+    // Pick one exit of the channel, spread over all its Portal_Out cells by
+    // `random`. Returns false if the channel has no exit. Serial only
+    // (Portal_In runs on the simulation's serial path).
+    bool pick_exit(uint8_t channel, uint32_t random, int32_t& x, int32_t& y);
+
+    bool has_exit(uint8_t channel) const { return !channels_[channel & (CHANNEL_COUNT - 1)].exits.empty(); }
+    size_t get_exit_count(uint8_t channel) const { return channels_[channel & (CHANNEL_COUNT - 1)].exits.size(); }
+    size_t get_entrance_count(uint8_t channel) const { return channels_[channel & (CHANNEL_COUNT - 1)].entrances; }
+
+    void clear();
+
+private:
+    struct Channel {
+        std::vector<uint32_t> exits;  // Packed (y << 16) | x
+        size_t entrances = 0;
+        bool in_order = true;         // Exit order follows from the edit order alone
+    };
+
+    // Slot of an exit cell: (index in its channel's exits << 6) | channel
+    static constexpr uint32_t NO_SLOT = ~0u;
+    static constexpr int32_t PAGE_SHIFT = 6;  // 64×64 cells per slot page
+
+    static uint32_t pack(int32_t x, int32_t y) {
+        return (static_cast<uint32_t>(y) << 16) | static_cast<uint32_t>(x);
+    }
+
+    // Slot of the cell, allocating its page on first use
+    uint32_t& slot_at(uint32_t packed);
+    void set_slots(uint32_t channel);
+
+    std::array<Channel, CHANNEL_COUNT> channels_;
+    // Per 64×64 block of cells, allocated when it gets its first exit
+    std::vector<std::unique_ptr<uint32_t[]>> slot_pages_;
+    int32_t pages_wide_ = 0;
+    std::mutex mutex_;
+};
+
+} // namespace PixelEngine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+namespace PixelEngine {
+
+// Buffered random stream behind World::random_int(). Eight xorshift32 lanes
+// advance in lockstep and refill BUFFER_SIZE draws at a time; the lanes do
+// not depend on each other, so the refill loop vectorizes (one 8 x 32-bit
+// shift / xor per step) and a draw is a load and an increment. The
+// sequence depends only on the seed.
+class RandomStream {
+public:
+    static constexpr uint32_t LANES = 8;
+    static constexpr uint32_t BUFFER_SIZE = 64;
+
+    explicit RandomStream(uint32_t seed_value = 1) { seed(seed_value); }
+
+    void seed(uint32_t seed_value) {
+        // Spread one seed over the lanes (murmur3 finalizer on a Weyl
+        // sequence); xorshift state must be non-zero
+        uint32_t weyl = seed_value;
+        for (uint32_t lane = 0; lane < LANES; ++lane) {
+            weyl += 0x9E3779B9u;
+            uint32_t h = weyl;
+            h ^= h >> 16;
+            h *= 0x85EBCA6Bu;
+            h ^= h >> 13;
+            h *= 0xC2B2AE35u;
+            h ^= h >> 16;
+            lanes_[lane] = h != 0 ? h : 0x9E3779B9u;
+        }
+        next_ = BUFFER_SIZE;  // Refill on the first draw
+    }
+
+    uint32_t next() {
+        if (next_ == BUFFER_SIZE) refill();
+        return buffer_[next_++];
+    }
+
+private:
+    void refill() {
+        for (uint32_t i = 0; i < BUFFER_SIZE; i += LANES) {
+            for (uint32_t lane = 0; lane < LANES; ++lane) {
+                uint32_t state = lanes_[lane];
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                lanes_[lane] = state;
+                buffer_[i + lane] = state;
+            }
+        }
+        next_ = 0;
+    }
+
+    uint32_t buffer_[BUFFER_SIZE];
+    uint32_t lanes_[LANES];
+    uint32_t next_;
+};
+
+} // namespace PixelEngine
@@ -2,6 +2,11 @@
 
 #include "World.h"
 #include "Material.h"
+#include "ThreadPool.h"
+#include "LiquidLeveler.h"
+#include <array>
+#include <memory>
+#include <vector>
 
 namespace PixelEngine {
 
@@ -13,10 +18,41 @@ public:
     // Run one simulation step
     void update();
 
+    // Threads used by update(); 0 = every hardware thread. One thread (the
+    // default) runs the original serial sweep, more switch to the phased
+    // chunk schedule.
+    void set_thread_count(uint32_t thread_count);
+    uint32_t get_thread_count() const { return pool_ ? pool_->get_thread_count() : 1; }
+
+    // Deterministic mode forces the phased schedule even on one thread, so
+    // the world after N frames is bit-identical for any thread count
+    // (replays, regression tests, lockstep).
+    void set_deterministic(bool deterministic) { deterministic_ = deterministic; }
+    bool is_deterministic() const { return deterministic_; }
+
+    // Rest detection (on by default): settled plain powders and liquids are
+    // skipped until something within reach changes, and chunks holding
+    // nothing else fall asleep within a few frames. Disabling runs every
+    // cell through its per-cell rule, for A/B comparisons.
+    void set_rest_detection_enabled(bool enabled) { rest_detection_enabled_ = enabled; }
+    bool is_rest_detection_enabled() const { return rest_detection_enabled_; }
+
+    // Bulk leveling of resting water bodies (off by default). Basins settle
+    // in a few frames instead of spreading a few cells per frame.
+    void set_liquid_leveling_enabled(bool enabled) { liquid_leveling_enabled_ = enabled; }
+    bool is_liquid_leveling_enabled() const { return liquid_leveling_enabled_; }
+
+    // Coarse temperature field (off by default). Melting and firing rules
+    // read one heat sample instead of scanning for hot neighbours, and heat
+    // reaches a few cells past its source.
+    void set_temperature_enabled(bool enabled) { world_.temperature_field().set_enabled(enabled); }
+    bool is_temperature_enabled() const { return world_.temperature_field().is_enabled(); }
+
     // Statistics
     uint64_t get_frame_count() const { return frame_count_; }
     uint32_t get_active_chunks() const { return active_chunk_count_; }
     uint32_t get_updated_cells() const { return updated_cell_count_; }
+    uint32_t get_active_super_chunks() const { return active_super_chunk_count_; }
 
 private:
     World& world_;
@@ -25,17 +61,85 @@ private:
     uint64_t frame_count_;
     uint32_t active_chunk_count_;
     uint32_t updated_cell_count_;
+    uint32_t active_super_chunk_count_;
 
     bool scan_direction_;  // Alternate scan direction each frame
+    bool deterministic_;
+    bool rest_detection_enabled_;
+    bool liquid_leveling_enabled_;
+
+    Materials::RestKernelTables rest_tables_;
+    LiquidLeveler liquid_leveler_;
+
+    std::unique_ptr<ThreadPool> pool_;  // nullptr when running on one thread
+
+    // Cell whose update may reach past the neighbouring chunks; the phased
+    // schedule runs these serially once all phases are done
+    struct DeferredCell {
+        int32_t x;
+        int32_t y;
+        MaterialID material;
+    };
+
+    // Per-chunk scratch for the phased schedule (own cache line: written by
+    // whichever thread runs the chunk)
+    struct alignas(64) ChunkTask {
+        RandomStream rng;
+        uint32_t updated_cells = 0;
+        std::vector<DeferredCell> deferred;
+        AgentTable::SpawnLog agents;
+    };
+    std::vector<ChunkTask> chunk_tasks_;
 
-    // Update a single chunk
-    void update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y);
+    // Active chunks of the running phase (chunk_x % 3, chunk_y % 3), and
+    // every chunk run this frame (sorted once the phases are done)
+    std::vector<uint32_t> phase_chunks_;
+    std::vector<uint32_t> ran_chunks_;
+
+    void update_serial();
+    void update_phased();
+    void run_deferred_cells();
+
+    // Random ticks (Materials::random_tick) for every chunk holding a slow
+    // grower, in chunk index order. Serial, after the cell pass.
+    void run_random_ticks();
+    static constexpr int32_t RANDOM_TICKS_PER_CHUNK =
+        CHUNK_SIZE * CHUNK_SIZE / static_cast<int32_t>(Materials::RANDOM_TICK_INTERVAL);
+    std::array<uint8_t, 256> has_random_tick_{};  // By raw MaterialID
+    std::vector<uint8_t> random_tick_marks_;       // Per chunk: queued in random_tick_chunks_
+    std::vector<int32_t> random_tick_chunks_;
+
+    // Cells on either side of a kernel row (REST_KERNEL_REACH)
+    static constexpr int32_t KERNEL_MARGIN = Materials::REST_KERNEL_REACH;
+    static constexpr int32_t KERNEL_ROW_SIZE = CHUNK_SIZE + 2 * KERNEL_MARGIN;
+
+    // Raw material ids of cells base_x-KERNEL_MARGIN .. base_x+63+KERNEL_MARGIN
+    // on row world_y (out of bounds reads as Stone, like World::get_material)
+    void load_kernel_row(int32_t base_x, int32_t world_y, uint8_t* row) const;
+
+    // Bitmask (bit = local x) of plain powders and liquids on this chunk row
+    // that can neither move nor react until a cell within reach changes
+    uint64_t find_resting_cells(int32_t base_x, int32_t world_y, int32_t lanes) const;
+
+    // Materials::INERT_MATERIALS by raw MaterialID; update_chunk skips them
+    // like Empty, so chunks of stone and settled cells sleep at the rest
+    // threshold
+    std::array<uint8_t, 256> is_inert_{};
+
+    // Update a single chunk, returns the number of cells that changed.
+    // With `deferred` set, wide-reach cells are queued instead of updated.
+    uint32_t update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y,
+                          std::vector<DeferredCell>* deferred = nullptr);
 
     // Update a single cell based on its material type
     void update_cell(int32_t x, int32_t y, MaterialID material);
 
     // Sleep inactive chunks after N frames
     static constexpr uint32_t CHUNK_SLEEP_THRESHOLD = 120;  // ~2 seconds
+
+    // Chunks whose cells all rest sleep sooner; long enough for the liquid
+    // leveler to see a settled body once
+    static constexpr uint32_t CHUNK_REST_SLEEP_THRESHOLD = LiquidLeveler::INTERVAL + 1;
 };
 
 } // namespace PixelEngine
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PixelEngine {
+
+class World;
+
+// Coarse heat map: one temperature per 4×4 cells.
+//
+// Heat rules used to rescan their 3×3 neighbourhood for hot material ids
+// every frame. With the field running, step() pins every sample holding a
+// source (Fire, Lava, ...) or sink (Liquid_Nitrogen, Frost) to that
+// material's temperature, diffuses the grid once (5-point stencil on int16
+// rows the compiler vectorizes) and wakes sleeping chunks whose heat-
+// sensitive cells just got hot enough. Rules then read one sample, and heat
+// carries a few samples past the cell that makes it.
+//
+// Temperatures are offsets from ambient (0), roughly in °C. Runs serially
+// after the cell pass; the result depends only on the world.
+class TemperatureField {
+public:
+    static constexpr int32_t SAMPLE_SHIFT = 2;  // 4×4 cells per sample
+    static constexpr int32_t SAMPLE_SIZE = 1 << SAMPLE_SHIFT;
+
+    // Reaction thresholds read by the material rules
+    static constexpr int16_t MELT_POINT = 40;   // Ice, snow, wax, honeycomb
+    static constexpr int16_t KILN_POINT = 150;  // Clay fires into brick
+
+    void resize(int32_t width, int32_t height);
+
+    // Off by default; rules fall back to neighbour scans while disabled.
+    // Disabling drops all stored heat.
+    void set_enabled(bool enabled);
+    bool is_enabled() const { return enabled_; }
+
+    // Temperature around cell (x, y), which must be in bounds
+    int16_t sample(int32_t x, int32_t y) const {
+        return current_[static_cast<size_t>((y >> SAMPLE_SHIFT) + 1) * stride_ + (x >> SAMPLE_SHIFT) + 1];
+    }
+
+    // Diffuse, apply this frame's sources and sinks, wake heated chunks.
+    // Serial, after the cell pass.
+    void step(World& world);
+
+    void clear();
+
+    // Temperature a source / sink material holds its sample at (0 = neither)
+    static int16_t get_material_temperature(MaterialID material);
+
+    // Sample rows holding non-ambient heat after the last step()
+    int32_t get_warm_row_count() const { return warm_row1_ >= warm_row0_ ? warm_row1_ - warm_row0_ + 1 : 0; }
+
+private:
+    void diffuse();
+    void apply_sources(World& world);
+    void wake_heated_chunks(World& world);
+
+    bool enabled_ = false;
+    int32_t width_ = 0;
+    int32_t height_ = 0;
+    int32_t samples_wide_ = 0;
+    int32_t samples_high_ = 0;
+    int32_t stride_ = 0;  // samples_wide_ + 2: one ambient sample of padding per side
+
+    // Padded grids (padding rows / columns stay ambient), swapped each step
+    std::vector<int16_t> current_;
+    std::vector<int16_t> next_;
+
+    // Sample rows that may hold non-ambient values (empty when row0 > row1)
+    int32_t warm_row0_ = 0;
+    int32_t warm_row1_ = -1;
+    int32_t stale_row0_ = 0;  // Rows of next_ that may hold an older step
+    int32_t stale_row1_ = -1;
+
+    std::vector<uint8_t> chunk_marks_;   // Per chunk: holds a source this step
+    std::vector<int32_t> marked_chunks_;
+};
+
+} // namespace PixelEngine
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PixelEngine {
+
+// Fixed-size worker pool for fork/join parallel loops.
+// The calling thread participates in every parallel_for, so a pool created
+// with thread_count == 1 spawns no workers and runs everything inline.
+class ThreadPool {
+public:
+    // thread_count == 0 picks std::thread::hardware_concurrency()
+    explicit ThreadPool(uint32_t thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Total threads used by parallel_for (workers + caller)
+    uint32_t get_thread_count() const { return static_cast<uint32_t>(workers_.size()) + 1; }
+
+    // Run fn(index) for index in [0, count) and block until all calls finish.
+    // Indices are handed out dynamically; fn must not call parallel_for.
+    void parallel_for(uint32_t count, const std::function<void(uint32_t)>& fn);
+
+private:
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+
+    // Current job (guarded by mutex_ for publication, counters are atomic)
+    const std::function<void(uint32_t)>* job_ = nullptr;
+    uint32_t job_count_ = 0;
+    uint64_t job_generation_ = 0;
+    std::atomic<uint32_t> next_index_{0};
+    uint32_t active_workers_ = 0;
+    bool stopping_ = false;
+
+    void worker_loop();
+    void run_indices(const std::function<void(uint32_t)>& fn, uint32_t count);
+};
+
+} // namespace PixelEngine
@@ -4,216 +4,11 @@
 
 namespace PixelEngine {
 
-// Material identifier (1 byte per cell)
+// Material identifier (1 byte per cell); ids and properties are listed
+// once, in Materials.def
 enum class MaterialID : uint8_t {
-    // === BASIC (0-9) ===
-    Empty = 0,
-    Stone = 1,
-    Sand = 2,
-    Water = 3,
-    Steam = 4,
-    Oil = 5,
-    Fire = 6,
-    Wood = 7,
-    Acid = 8,
-    Lava = 9,
-
-    // === POWDERS (10-19) ===
-    Ash = 10,
-    Dirt = 11,
-    Gravel = 12,
-    Snow = 13,
-    Gunpowder = 14,
-    Salt = 15,
-    Coal = 16,
-    Rust = 17,
-    Sawdust = 18,
-    Glass_Powder = 19,
-
-    // === LIQUIDS (20-29) ===
-    Honey = 20,
-    Mud = 21,
-    Blood = 22,
-    Poison = 23,
-    Slime = 24,
-    Milk = 25,
-    Alcohol = 26,
-    Mercury = 27,
-    Petrol = 28,
-    Glue = 29,
-
-    // === GASES (30-39) ===
-    Smoke = 30,
-    Toxic_Gas = 31,
-    Hydrogen = 32,
-    Helium = 33,
-    Methane = 34,
-    Spark = 35,
-    Plasma = 36,
-    Dust = 37,
-    Spore = 38,
-    Confetti = 39,
-
-    // === SOLIDS (40-49) ===
-    Grass = 40,
-    Metal = 41,
-    Gold = 42,
-    Ice = 43,
-    Glass = 44,
-    Brick = 45,
-    Obsidian = 46,
-    Diamond = 47,
-    Copper = 48,
-    Rubber = 49,
-
-    // === ORGANIC (50-59) ===
-    Leaf = 50,
-    Moss = 51,
-    Vine = 52,
-    Fungus = 53,
-    Seed = 54,
-    Flower = 55,
-    Algae = 56,
-    Coral = 57,
-    Wax = 58,
-    Flesh = 59,
-
-    // === SPECIAL (60-69) ===
-    Person = 60,
-    Clone = 61,
-    Void = 62,
-    Fuse = 63,
-    TNT = 64,
-    C4 = 65,
-    Firework = 66,
-    Lightning = 67,
-    Portal_In = 68,
-    Portal_Out = 69,
-
-    // === FANTASY (70-79) ===
-    Magic = 70,
-    Crystal = 71,
-    Ectoplasm = 72,
-    Antimatter = 73,
-    Fairy_Dust = 74,
-    Dragon_Fire = 75,
-    Frost = 76,
-    Ember = 77,
-    Stardust = 78,
-    Void_Dust = 79,
-
-    // === SPAWNERS (80) ===
-    Life = 80,       // Falling particle that spawns Person on safe ground
-
-    // === NEW POWDERS (81-85) ===
-    Thermite_Powder = 81, // Burns extremely hot when ignited
-    Sugar = 82,           // Sweet powder, dissolves in water, flammable
-    Iron_Filings = 83,    // Metal shavings, rusts with water
-    Chalk = 84,           // White chalk powder
-    Calcium = 85,         // Calcium powder, reactive with water
-
-    // === NEW LIQUIDS (86-90) ===
-    Tar = 86,        // Very slow black sticky liquid
-    Juice = 87,      // Orange liquid, evaporates
-    Sap = 88,        // Tree sap, amber colored
-    Bleach = 89,     // Corrosive to organics
-    Ink = 90,        // Dark liquid for staining
-
-    // === NEW GASES (91-93) ===
-    Chlorine = 91,   // Toxic green gas, sinks
-    Liquid_Nitrogen = 92, // Freezing gas effect
-    Oxygen = 93,     // Makes fires burn brighter
-
-    // === NEW SOLIDS (94-97) ===
-    Concrete = 94,   // Strong building material
-    Titanium = 95,   // Strong silvery metal
-    Clay = 96,       // Moldable, fires into brick
-    Charcoal = 97,   // Burnt wood, slow fuel
-
-    // === NEW ORGANIC (98-100) ===
-    Bamboo = 98,     // Fast-growing plant
-    Honeycomb = 99,  // Solid wax structure
-    Bone = 100,      // Skeletal remains
-
-    // === NEW SPECIAL (101-102) ===
-    Napalm = 101,    // Sticky spreading fire
-    Thermite = 102,  // Extremely hot burning
-
-    // === EXPANSION: BASIC (103-112) ===
-    Bedrock = 103,   // Indestructible foundation
-    Ceramic = 104,   // Fired clay pottery
-    Granite = 105,   // Speckled igneous rock
-    Marble = 106,    // Polished metamorphic rock
-    Sandstone = 107, // Compressed sand
-    Limestone = 108, // calcium rock
-    Slate = 109,     // Layered rock
-    Basalt = 110,    // Dark volcanic rock
-    Quartz_Block = 111, // Crystalline silica
-    Soil = 112,      // Rich earth, plants grow
-
-    // === EXPANSION: POWDERS (113-117) ===
-    Flour = 113,     // Explosive when dispersed
-    Sulfur = 114,    // Yellow powder, burns
-    Cement = 115,    // Hardens with water
-    Fertilizer = 116,// Helps plants grow
-    Volcanic_Ash = 117, // Volcanic powder
-
-    // === EXPANSION: LIQUIDS (118-122) ===
-    Brine = 118,     // Salt water
-    Coffee = 119,    // Brown stimulant
-    Soap = 120,      // Bubbly cleaner
-    Paint = 121,     // Colorful liquid
-    Sewage = 122,    // Gross waste liquid
-
-    // === EXPANSION: GASES (123-129) ===
-    Ammonia = 123,   // Pungent cleaning gas
-    Carbon_Dioxide = 124, // Heavy gas, sinks
-    Nitrous = 125,   // Laughing gas, light
-    Steam_Hot = 126, // Scalding steam
-    Miasma = 127,    // Disease gas
-    Pheromone = 128, // Attracts creatures
-    Nerve_Gas = 129, // Deadly to life
-
-    // === EXPANSION: SOLIDS (130-136) ===
-    Silver = 130,    // Precious metal
-    Platinum = 131,  // Rare metal
-    Lead = 132,      // Heavy soft metal
-    Tin = 133,       // Light metal
-    Zinc = 134,      // Reactive metal
-    Bronze = 135,    // Copper-tin alloy
-    Steel = 136,     // Iron-carbon alloy
-
-    // === EXPANSION: ORGANIC (137-143) ===
-    Pollen = 137,    // Plant reproduction
-    Root = 138,      // Underground plant
-    Bark = 139,      // Tree skin
-    Fruit = 140,     // Edible plant part
-    Egg = 141,       // Hatches creatures
-    Web = 142,       // Sticky spider silk
-    Mucus = 143,     // Biological slime
-
-    // === EXPANSION: SPECIAL (144-151) ===
-    Bomb = 144,      // Explodes on impact
-    Nuke = 145,      // Massive explosion
-    Laser = 146,     // Light beam
-    Black_Hole = 147,// Attracts matter
-    White_Hole = 148,// Repels matter
-    Acid_Gas = 149,  // Corrosive vapor
-    Ice_Bomb = 150,  // Freezing explosion
-    Fire_Bomb = 151, // Incendiary explosion
-
-    // === EXPANSION: FANTASY (152-161) ===
-    Mana = 152,      // Magic energy liquid
-    Mirage = 153,    // Illusory shimmer
-    Holy_Water = 154,// Blessed liquid
-    Cursed = 155,    // Dark corruption
-    Blessed = 156,   // Light purification
-    Soul = 157,      // Spirit essence
-    Spirit = 158,    // Ghost matter
-    Aether = 159,    // Heavenly gas
-    Nether = 160,    // Hellish gas
-    Phoenix_Ash = 161,// Rebirth powder
-
+#define MATERIAL(Name, Id, ...) Name = Id,
+#include "Materials.def"
     COUNT
 };
 
@@ -230,12 +25,12 @@ enum class MaterialState : uint8_t {
 struct Color {
     uint8_t r, g, b, a;
 
-    Color() : r(0), g(0), b(0), a(255) {}
-    Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+    constexpr Color() : r(0), g(0), b(0), a(255) {}
+    constexpr Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
         : r(r), g(g), b(b), a(a) {}
 
     // Convert to 32-bit RGBA for Metal texture
-    uint32_t to_rgba32() const {
+    constexpr uint32_t to_rgba32() const {
         return (r << 0) | (g << 8) | (b << 16) | (a << 24);
     }
 };
@@ -288,32 +83,18 @@ struct Cell {
     }
 
     // ========================================
-    // Person-specific state (reuses existing fields creatively)
+    // Person agent handle (see AgentTable)
     // ========================================
 
-    // Health for people (0-127, stored in velocity_y when person is grounded)
-    // When person is falling, velocity_y is used for actual velocity
-    // We track if person is grounded using a separate flag
-    uint8_t get_health() const {
-        // Health stored in positive range of velocity_y
-        return static_cast<uint8_t>(velocity_y > 0 ? velocity_y : 0);
+    // A Person cell holds only the handle of its agent: low 8 bits in
+    // velocity_y, high 6 bits in the lifetime field
+    uint16_t get_agent_handle() const {
+        return static_cast<uint16_t>(static_cast<uint8_t>(velocity_y) | (get_lifetime() << 8));
     }
-    void set_health(uint8_t health) {
-        velocity_y = static_cast<int8_t>(health > 127 ? 127 : health);
+    void set_agent_handle(uint16_t handle) {
+        velocity_y = static_cast<int8_t>(handle & 0xFF);
+        set_lifetime(static_cast<uint8_t>((handle >> 8) & 0x3F));
     }
-    void damage_health(uint8_t amount) {
-        int16_t new_health = static_cast<int16_t>(velocity_y) - amount;
-        velocity_y = static_cast<int8_t>(new_health < 0 ? 0 : new_health);
-    }
-
-    // Person facing direction (reuses flow_direction bit 1)
-    bool get_person_facing_right() const { return get_flow_direction(); }
-    void set_person_facing_right(bool right) { set_flow_direction(right); }
-
-    // Reproduction cooldown (6 bits from lifetime field, 0-63)
-    uint8_t get_reproduction_cooldown() const { return get_lifetime(); }
-    void set_reproduction_cooldown(uint8_t cooldown) { set_lifetime(cooldown); }
-    void decrement_reproduction_cooldown() { decrement_lifetime(); }
 };
 
 // 2D position
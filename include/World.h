@@ -2,6 +2,17 @@
 
 #include "Types.h"
 #include "Material.h"
+#include "EventQueue.h"
+#include "BuildJobs.h"
+#include "GravityField.h"
+#include "TemperatureField.h"
+#include "ConductorNetwork.h"
+#include "PortalRegistry.h"
+#include "MaterialCensus.h"
+#include "AgentTable.h"
+#include "RandomStream.h"
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <cstdint>
@@ -14,7 +25,13 @@ struct Chunk {
     bool is_active;  // Does this chunk have any moving materials?
     uint32_t sleep_counter;  // Frames since last movement
 
-    Chunk() : is_active(false), sleep_counter(0) {
+    // Rest state (see World::unsettle_region): bit x of resting[y] marks a
+    // cell the rest kernel proved stuck; bit y of stale_rows marks a row
+    // whose resting mask must be recomputed before it is trusted again
+    uint64_t resting[CHUNK_SIZE];
+    uint64_t stale_rows;
+
+    Chunk() : is_active(false), sleep_counter(0), resting{}, stale_rows(~0ull) {
         // Initialize all cells to empty
         for (int32_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i) {
             cells[i] = Cell(MaterialID::Empty);
@@ -31,6 +48,11 @@ struct Chunk {
     }
 };
 
+// Cells x0..x1 (inclusive) of row y, for World::stamp_spans
+struct RowSpan {
+    int32_t y, x0, x1;
+};
+
 // World - manages the entire simulation grid
 class World {
 public:
@@ -41,11 +63,25 @@ public:
     int32_t get_width() const { return width_; }
     int32_t get_height() const { return height_; }
 
-    // Cell access
-    Cell& get_cell(int32_t x, int32_t y);
-    const Cell& get_cell(int32_t x, int32_t y) const;
+    // Cell access. The hot accessors live here so the material kernels
+    // (see Materials) inline them and fold their constants through.
+    Cell& get_cell(int32_t x, int32_t y) {
+        Chunk& chunk = chunks_[(y / CHUNK_SIZE) * chunks_wide_ + x / CHUNK_SIZE];
+        return chunk.get_cell(x % CHUNK_SIZE, y % CHUNK_SIZE);
+    }
+
+    const Cell& get_cell(int32_t x, int32_t y) const {
+        const Chunk& chunk = chunks_[(y / CHUNK_SIZE) * chunks_wide_ + x / CHUNK_SIZE];
+        return chunk.get_cell(x % CHUNK_SIZE, y % CHUNK_SIZE);
+    }
+
+    MaterialID get_material(int32_t x, int32_t y) const {
+        if (!in_bounds(x, y)) {
+            return MaterialID::Stone;  // Out of bounds = solid wall
+        }
+        return get_cell(x, y).material_id;
+    }
 
-    MaterialID get_material(int32_t x, int32_t y) const;
     void set_material(int32_t x, int32_t y, MaterialID material);
 
     // Bounds checking
@@ -54,19 +90,278 @@ public:
     }
 
     // Movement and swapping (used by material update functions)
-    bool can_move_to(int32_t x, int32_t y, int32_t new_x, int32_t new_y) const;
-    bool try_move_cell(int32_t x, int32_t y, int32_t new_x, int32_t new_y);
-    void swap_cells(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+    bool can_move_to(int32_t x, int32_t y, int32_t new_x, int32_t new_y) const {
+        if (!in_bounds(new_x, new_y)) {
+            return false;
+        }
+
+        MaterialID target_material = get_cell(new_x, new_y).material_id;
+
+        // Can always move into empty space
+        if (target_material == MaterialID::Empty) {
+            return true;
+        }
+
+        const auto& current_def = material_system_.get_material(get_material(x, y));
+        const auto& target_def = material_system_.get_material(target_material);
+
+        // Solids can't be displaced
+        if (target_def.state == MaterialState::Solid) {
+            return false;
+        }
+
+        // Denser materials displace lighter ones (when moving down),
+        // lighter materials (gases) displace heavier ones (when moving up)
+        return (new_y > y && current_def.density > target_def.density) ||
+               (new_y < y && current_def.density < target_def.density);
+    }
+
+    bool try_move_cell(int32_t x, int32_t y, int32_t new_x, int32_t new_y) {
+        if (!can_move_to(x, y, new_x, new_y)) {
+            return false;
+        }
+
+        // Don't move if already updated this frame (prevents double-updates)
+        if (get_cell(x, y).was_updated()) {
+            return false;
+        }
+
+        swap_cells(x, y, new_x, new_y);
+        get_cell(new_x, new_y).mark_updated();
+        activate_chunk_at_position(new_x, new_y);
+        return true;
+    }
+
+    // Swap two cells with all their state. Keeps the census, rest state and
+    // conductor network current; moved Persons and portals take the
+    // out-of-line path (agent table / portal registry).
+    void swap_cells(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+        Cell& cell1 = get_cell(x1, y1);
+        Cell& cell2 = get_cell(x2, y2);
+
+        // Swap entire cell contents (material_id, flags, velocity_y)
+        // This preserves all per-cell state like health, lifetime, direction
+        Cell temp = cell1;
+        cell1 = cell2;
+        cell2 = temp;
+
+        if (cell1.material_id != cell2.material_id) {
+            // Only a swap across a chunk border changes chunk counts
+            int32_t chunk1 = world_to_chunk_index(x1, y1);
+            int32_t chunk2 = world_to_chunk_index(x2, y2);
+            if (chunk1 != chunk2) {
+                census_.replace(chunk1, cell2.material_id, cell1.material_id);
+                census_.replace(chunk2, cell1.material_id, cell2.material_id);
+            }
+            unsettle_cell(x1, y1);
+            unsettle_cell(x2, y2);
+
+            // A conductor moved (Gold / Silver / Copper powders, pushed metal)
+            if (ConductorNetwork::is_conductor(cell1.material_id) != ConductorNetwork::is_conductor(cell2.material_id)) {
+                conductors_.note_change(x1, y1);
+                conductors_.note_change(x2, y2);
+            }
+        }
+
+        if (has_swap_hooks(cell1.material_id) || has_swap_hooks(cell2.material_id)) {
+            run_swap_hooks(x1, y1, x2, y2);
+        }
+    }
 
     // Chunk access
-    Chunk* get_chunk(int32_t chunk_x, int32_t chunk_y);
-    const Chunk* get_chunk(int32_t chunk_x, int32_t chunk_y) const;
+    Chunk* get_chunk(int32_t chunk_x, int32_t chunk_y) {
+        if (chunk_x < 0 || chunk_x >= chunks_wide_ ||
+            chunk_y < 0 || chunk_y >= chunks_high_) {
+            return nullptr;
+        }
+        return &chunks_[chunk_y * chunks_wide_ + chunk_x];
+    }
+
+    const Chunk* get_chunk(int32_t chunk_x, int32_t chunk_y) const {
+        if (chunk_x < 0 || chunk_x >= chunks_wide_ ||
+            chunk_y < 0 || chunk_y >= chunks_high_) {
+            return nullptr;
+        }
+        return &chunks_[chunk_y * chunks_wide_ + chunk_x];
+    }
 
-    void activate_chunk(int32_t chunk_x, int32_t chunk_y);
-    void activate_chunk_at_position(int32_t world_x, int32_t world_y);
+    // Wake a chunk (and raise its super-chunk's flag)
+    void activate_chunk(int32_t chunk_x, int32_t chunk_y) {
+        Chunk* chunk = get_chunk(chunk_x, chunk_y);
+        if (chunk) {
+            chunk->is_active = true;
+            chunk->sleep_counter = 0;
+
+            // Read first: the flag is usually up, and a store would bounce the
+            // cache line between threads
+            std::atomic<uint8_t>& flag =
+                super_active_[(chunk_y >> SUPER_CHUNK_SHIFT) * supers_wide_ + (chunk_x >> SUPER_CHUNK_SHIFT)];
+            if (!flag.load(std::memory_order_relaxed)) {
+                flag.store(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void activate_chunk_at_position(int32_t world_x, int32_t world_y) {
+        if (in_bounds(world_x, world_y)) {
+            activate_chunk(world_x / CHUNK_SIZE, world_y / CHUNK_SIZE);
+        }
+    }
+
+    // Wake every chunk a set_material inside the rectangle could have woken
+    // (the rectangle grown by one cell). One pass for bulk writes; also
+    // unsettles the rectangle.
+    void activate_region(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y);
+
+    // Materials inside the rectangle changed: drop the rest state of every
+    // cell whose rest kernel reads them (the rectangle grown by
+    // REST_KERNEL_REACH along rows and one row up / down), mark those rows
+    // stale and wake their chunks. set_material, swap_cells and
+    // activate_region call this; chunk tasks only touch their own window.
+    void unsettle_region(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y);
+
+    // unsettle_region for one cell. Inline when the rest kernel's reach
+    // around it stays inside its chunk and the world.
+    void unsettle_cell(int32_t x, int32_t y) {
+        int32_t local_x = x % CHUNK_SIZE;
+        int32_t local_y = y % CHUNK_SIZE;
+        if (local_x < Materials::REST_KERNEL_REACH || local_x >= CHUNK_SIZE - Materials::REST_KERNEL_REACH ||
+            local_y < 1 || local_y >= CHUNK_SIZE - 1 ||
+            x + Materials::REST_KERNEL_REACH >= width_ || y + 1 >= height_) {
+            unsettle_region(x, y, x, y);
+            return;
+        }
+
+        int32_t chunk_x = x / CHUNK_SIZE;
+        int32_t chunk_y = y / CHUNK_SIZE;
+        Chunk& chunk = chunks_[chunk_y * chunks_wide_ + chunk_x];
+        uint64_t lanes = ((2ull << (2 * Materials::REST_KERNEL_REACH)) - 1) << (local_x - Materials::REST_KERNEL_REACH);
+        chunk.resting[local_y - 1] &= ~lanes;
+        chunk.resting[local_y] &= ~lanes;
+        chunk.resting[local_y + 1] &= ~lanes;
+        chunk.stale_rows |= 7ull << (local_y - 1);
+        activate_chunk(chunk_x, chunk_y);
+    }
+
+    // Call fn(Cell* cells, int32_t count, int32_t first_x) for the cells
+    // x0..x1 of row y, split into runs contiguous in chunk memory. The span
+    // is clipped to the world. Raw access: callers own activation, rest
+    // state and discovery reporting (see activate_region), must report material
+    // changes to census() and cells that start or stop conducting to
+    // conductors(), and must go through set_material when creating or
+    // destroying a portal or a Person.
+    template <typename Fn>
+    void for_each_row_span(int32_t y, int32_t x0, int32_t x1, Fn&& fn) {
+        if (y < 0 || y >= height_) return;
+        if (x0 < 0) x0 = 0;
+        if (x1 >= width_) x1 = width_ - 1;
+
+        int32_t chunk_y = y / CHUNK_SIZE;
+        int32_t row_offset = (y % CHUNK_SIZE) * CHUNK_SIZE;
+        while (x0 <= x1) {
+            int32_t chunk_x = x0 / CHUNK_SIZE;
+            int32_t local_x = x0 % CHUNK_SIZE;
+            int32_t count = CHUNK_SIZE - local_x;
+            if (count > x1 - x0 + 1) count = x1 - x0 + 1;
+
+            Chunk& chunk = chunks_[chunk_y * chunks_wide_ + chunk_x];
+            fn(&chunk.cells[row_offset + local_x], count, x0);
+            x0 += count;
+        }
+    }
+
+    // Editor write: set every cell covered by `spans` to `material` with
+    // the given lifetime and velocity (flow bits cleared). Spans may overlap
+    // and stick out of the world; they are clipped, sorted and merged in
+    // place, so each cell is written once. Portals and Persons (written or
+    // overwritten) go through set_material and keep their registry state.
+    // Unsettles each merged span, wakes each touched chunk once and reports one discovery
+    // event. Serial only.
+    void stamp_spans(std::vector<RowSpan>& spans, MaterialID material,
+                     uint8_t lifetime = 0, int8_t velocity_y = 0);
 
     int32_t get_chunks_wide() const { return chunks_wide_; }
     int32_t get_chunks_high() const { return chunks_high_; }
+    int32_t get_chunk_index(int32_t x, int32_t y) const { return world_to_chunk_index(x, y); }
+
+    // Super-chunks: SUPER_CHUNK_SIZE × SUPER_CHUNK_SIZE chunks sharing one
+    // activity flag, so chunk scans skip a quiet 4×4 block on one load.
+    // activate_chunk raises the flag (atomically: chunk tasks of different
+    // windows share super-chunks); refresh_super_chunks drops the flags
+    // whose chunks have all gone to sleep. A raised flag may be stale, an
+    // active chunk always has its flag raised.
+    static constexpr int32_t SUPER_CHUNK_SHIFT = 2;
+    static constexpr int32_t SUPER_CHUNK_SIZE = 1 << SUPER_CHUNK_SHIFT;
+
+    int32_t get_super_chunks_wide() const { return supers_wide_; }
+    int32_t get_super_chunks_high() const { return supers_high_; }
+
+    // Recount the active chunks of every flagged super-chunk and lower the
+    // flags of empty ones. Serial (between frames). Returns the number of
+    // super-chunks left active.
+    uint32_t refresh_super_chunks();
+
+    // Active chunks counted by the last refresh_super_chunks
+    uint32_t get_super_chunk_active_count(int32_t super_x, int32_t super_y) const {
+        return super_active_counts_[super_y * supers_wide_ + super_x];
+    }
+
+    // Call fn(chunk_x, chunk_y, Chunk&) for every active chunk. Rows run
+    // bottom-up or top-down, each row left to right or right to left;
+    // activity is checked when a chunk's turn comes, so chunks woken by
+    // earlier visits are seen. Cost: one flag per super-chunk plus the
+    // chunk headers of flagged super-chunks.
+    template <typename Fn>
+    void for_each_active_chunk(bool bottom_up, bool right_to_left, Fn&& fn) {
+        for (int32_t super_row = 0; super_row < supers_high_; ++super_row) {
+            int32_t super_y = bottom_up ? supers_high_ - 1 - super_row : super_row;
+            const std::atomic<uint8_t>* flags = &super_active_[super_y * supers_wide_];
+
+            bool any = false;
+            for (int32_t super_x = 0; super_x < supers_wide_ && !any; ++super_x) {
+                any = flags[super_x].load(std::memory_order_relaxed) != 0;
+            }
+            if (!any) continue;
+
+            int32_t first_y = super_y << SUPER_CHUNK_SHIFT;
+            int32_t rows = std::min(SUPER_CHUNK_SIZE, chunks_high_ - first_y);
+            for (int32_t row = 0; row < rows; ++row) {
+                int32_t chunk_y = bottom_up ? first_y + rows - 1 - row : first_y + row;
+                for (int32_t column = 0; column < supers_wide_; ++column) {
+                    int32_t super_x = right_to_left ? supers_wide_ - 1 - column : column;
+                    if (!flags[super_x].load(std::memory_order_relaxed)) continue;
+
+                    int32_t first_x = super_x << SUPER_CHUNK_SHIFT;
+                    int32_t columns = std::min(SUPER_CHUNK_SIZE, chunks_wide_ - first_x);
+                    for (int32_t i = 0; i < columns; ++i) {
+                        int32_t chunk_x = right_to_left ? first_x + columns - 1 - i : first_x + i;
+                        Chunk& chunk = chunks_[chunk_y * chunks_wide_ + chunk_x];
+                        if (chunk.is_active) fn(chunk_x, chunk_y, chunk);
+                    }
+                }
+            }
+        }
+    }
+
+    // Per-chunk / global material counts, kept current on every write
+    const MaterialCensus& census() const { return census_; }
+    MaterialCensus& census() { return census_; }
+
+    // Call fn(x, y, Cell&) for every cell of the material, visiting only the
+    // chunks the census lists (chunk order, then row-major)
+    template <typename Fn>
+    void for_each_cell_of(MaterialID material, Fn&& fn) {
+        census_.for_each_chunk_with(material, [&](int32_t chunk_index) {
+            Chunk& chunk = chunks_[chunk_index];
+            int32_t base_x = (chunk_index % chunks_wide_) * CHUNK_SIZE;
+            int32_t base_y = (chunk_index / chunks_wide_) * CHUNK_SIZE;
+            for (int32_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i) {
+                if (chunk.cells[i].material_id == material) {
+                    fn(base_x + i % CHUNK_SIZE, base_y + i / CHUNK_SIZE, chunk.cells[i]);
+                }
+            }
+        });
+    }
 
     // Clear updated flags (called at end of frame)
     void clear_updated_flags();
@@ -74,26 +369,89 @@ public:
     // Clear entire world back to empty
     void clear_world();
 
-    // Random number generator for deterministic simulation
+    // Reseed the world RNG (per-world seeds for batch runs / replays)
+    void seed_rng(uint32_t seed) { rng_.seed(seed); }
+
+    // Random number generator for deterministic simulation (never returns 0).
+    // Draws from the calling thread's RngScope stream if one is open.
     uint32_t random_int() {
-        // Simple xorshift PRNG (fast, deterministic)
-        rng_state_ ^= rng_state_ << 13;
-        rng_state_ ^= rng_state_ >> 17;
-        rng_state_ ^= rng_state_ << 5;
-        return rng_state_;
+        RandomStream& stream = tls_rng_ ? *tls_rng_ : rng_;
+        return stream.next();
     }
 
+    // Uniform in [0, n) by multiply-shift (Lemire): no division, and it
+    // keeps the draw's high bits. Use instead of random_int() % n.
+    uint32_t random_below(uint32_t n) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(random_int()) * n) >> 32);
+    }
+
+    // True on one draw in n on average
+    bool random_one_in(uint32_t n) { return random_below(n) == 0; }
+
+    // Redirects random_int() on the calling thread to a caller-owned stream
+    // while in scope. Parallel chunk tasks use this so each chunk draws from
+    // its own sequence regardless of which thread runs it.
+    class RngScope {
+    public:
+        explicit RngScope(RandomStream& stream) : previous_(tls_rng_) { tls_rng_ = &stream; }
+        ~RngScope() { tls_rng_ = previous_; }
+
+        RngScope(const RngScope&) = delete;
+        RngScope& operator=(const RngScope&) = delete;
+
+    private:
+        RandomStream* previous_;
+    };
+
     // Rendering - generate color buffer
     // background_color: RGBA color for empty cells (0 = transparent/black)
     void generate_color_buffer(uint32_t* buffer, uint32_t background_color = 0) const;
 
     MaterialSystem& get_material_system() { return material_system_; }
 
-    // Material spawn callback (for Story Mode discovery safety net)
-    using MaterialSpawnCallback = void(*)(MaterialID);
-    void set_material_spawn_callback(MaterialSpawnCallback callback) {
-        material_spawn_callback_ = callback;
-    }
+    // Discovery events (Story Mode). When enabled, combinations and material
+    // spawns are pushed onto a lock-free ring drained once per frame by the
+    // main thread; when disabled the simulation emits nothing.
+    void set_discovery_events_enabled(bool enabled) { discovery_events_enabled_ = enabled; }
+    bool discovery_events_enabled() const { return discovery_events_enabled_; }
+    DiscoveryEventQueue& discovery_events() { return discovery_events_; }
+
+    // Story Mode reaction filter: recompiles the combination table with only
+    // the recipes whose two materials are set in `unlocked`; nullptr (the
+    // default) allows every reaction. Call between frames when the set changes.
+    void set_reaction_filter(const std::bitset<256>* unlocked) { reactions_.build(unlocked); }
+    const Materials::ReactionTable& reactions() const { return reactions_; }
+
+    // Live portals of this world by channel, kept current by set_material / swap_cells
+    PortalRegistry& portal_registry() { return portal_registry_; }
+    const PortalRegistry& portal_registry() const { return portal_registry_; }
+
+    // Portal channel (0-63) of a Portal_In / Portal_Out cell; other cells are ignored
+    void set_portal_channel(int32_t x, int32_t y, uint8_t channel);
+    uint8_t get_portal_channel(int32_t x, int32_t y) const;
+
+    // Person construction sites, placed a few blocks per frame by Simulation
+    BuildJobQueue& build_jobs() { return build_jobs_; }
+    const BuildJobQueue& build_jobs() const { return build_jobs_; }
+
+    // Black_Hole / White_Hole field, applied by Simulation after the cell pass
+    GravityField& gravity_field() { return gravity_field_; }
+    const GravityField& gravity_field() const { return gravity_field_; }
+
+    // Coarse heat map read by the melting / firing rules (see Simulation)
+    TemperatureField& temperature_field() { return temperature_field_; }
+    const TemperatureField& temperature_field() const { return temperature_field_; }
+
+    // Connected conductor networks, energized by Lightning (see Simulation)
+    ConductorNetwork& conductors() { return conductors_; }
+    const ConductorNetwork& conductors() const { return conductors_; }
+
+    // Person agents, kept current by set_material / swap_cells
+    AgentTable& agents() { return agents_; }
+    const AgentTable& agents() const { return agents_; }
+
+    // Agent of the Person at (x, y), or AgentTable::INVALID
+    AgentHandle get_agent(int32_t x, int32_t y) const;
 
 private:
     int32_t width_;
@@ -104,8 +462,45 @@ private:
     std::vector<Chunk> chunks_;
     MaterialSystem& material_system_;
 
-    uint32_t rng_state_;
-    MaterialSpawnCallback material_spawn_callback_ = nullptr;
+    int32_t supers_wide_;
+    int32_t supers_high_;
+    std::unique_ptr<std::atomic<uint8_t>[]> super_active_;  // Per super-chunk: any chunk may be active
+    std::vector<uint8_t> super_active_counts_;               // Per super-chunk, as of the last refresh
+
+    // Chunks a stamp_spans call wakes, and per chunk whether it is listed
+    std::vector<int32_t> stamp_chunks_;
+    std::vector<uint8_t> stamp_marks_;
+
+    RandomStream rng_;
+    static inline thread_local RandomStream* tls_rng_ = nullptr;
+
+    // Only Simulation's chunk tasks open an RngScope
+    static bool in_chunk_task() { return tls_rng_ != nullptr; }
+    bool discovery_events_enabled_ = false;
+    DiscoveryEventQueue discovery_events_;
+    Materials::ReactionTable reactions_;
+    PortalRegistry portal_registry_;
+    MaterialCensus census_;
+    BuildJobQueue build_jobs_;
+    GravityField gravity_field_;
+    TemperatureField temperature_field_;
+    ConductorNetwork conductors_;
+    AgentTable agents_;
+
+    // unsettle_region without the wake-up. Grows and clips the rectangle
+    // in place to the cells whose rest state it dropped; false if none.
+    bool clear_rest_state(int32_t& min_x, int32_t& min_y, int32_t& max_x, int32_t& max_y);
+
+    // Persons and portals carry registry state that follows their cell
+    static bool has_swap_hooks(MaterialID material) {
+        return material == MaterialID::Person || PortalRegistry::is_portal(material);
+    }
+
+    // swap_cells' agent / portal bookkeeping, after the cells were swapped
+    void run_swap_hooks(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+
+    // Agent whose cell content sits at (x, y) (the table's view of its position)
+    AgentHandle resolve_agent(const Cell& cell, int32_t x, int32_t y) const;
 
     // Convert world coordinates to chunk index
     int32_t world_to_chunk_index(int32_t x, int32_t y) const {
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "World.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PixelEngine {
+
+// WorldFarm - owns K independent World/Simulation instances and steps them
+// in parallel on a thread pool. Used headless for batch jobs such as scene
+// thumbnail generation and material rule fuzzing.
+//
+// Each world runs single-threaded on one pool thread; worlds share no
+// mutable state, so results only depend on each world's seed and scene.
+class WorldFarm {
+public:
+    // Fills a freshly cleared world. Called on a pool thread.
+    using SceneLoader = std::function<void(World& world, uint32_t seed, int32_t index)>;
+
+    // Called on a pool thread after a world finished its frames
+    using OutputHook = std::function<void(const World& world, const Simulation& simulation,
+                                          int32_t index)>;
+
+    // thread_count == 0 uses every hardware thread
+    WorldFarm(int32_t world_count, int32_t width, int32_t height, uint32_t thread_count = 0);
+
+    void set_scene_loader(SceneLoader loader) { scene_loader_ = std::move(loader); }
+    void set_output_hook(OutputHook hook) { output_hook_ = std::move(hook); }
+
+    // Clear, seed and load every world. World i gets seed derive_seed(base_seed, i).
+    void load(uint32_t base_seed);
+
+    // Advance every world by `frames` simulation steps
+    void step(uint32_t frames);
+
+    // Invoke the output hook for every world
+    void emit_outputs();
+
+    // load + step + emit_outputs
+    void run(uint32_t base_seed, uint32_t frames);
+
+    int32_t get_world_count() const { return static_cast<int32_t>(slots_.size()); }
+    World& get_world(int32_t index) { return slots_[index]->world; }
+    Simulation& get_simulation(int32_t index) { return slots_[index]->simulation; }
+    uint32_t get_seed(int32_t index) const { return slots_[index]->seed; }
+    uint32_t get_thread_count() const { return pool_.get_thread_count(); }
+
+    static uint32_t derive_seed(uint32_t base_seed, int32_t index);
+
+    // Built-in scene loaders by name ("empty", "sand_pile", "fuzz", ...).
+    // Returns an empty function for unknown names.
+    static SceneLoader find_scene(const std::string& name);
+    static std::vector<std::string> get_scene_names();
+
+    // Write the world's color buffer as a binary PPM, box-downscaled by `scale`
+    static bool write_ppm_thumbnail(const World& world, const std::string& path,
+                                    int32_t scale = 1, uint32_t background_color = 0xFF1A1A2E);
+
+private:
+    // One independent world (non-movable: World and Simulation hold references)
+    struct Slot {
+        MaterialSystem material_system;
+        World world;
+        Simulation simulation;
+        uint32_t seed;
+
+        Slot(int32_t width, int32_t height)
+            : material_system()
+            , world(width, height, material_system)
+            , simulation(world)
+            , seed(0) {}
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+    ThreadPool pool_;
+    SceneLoader scene_loader_;
+    OutputHook output_hook_;
+};
+
+// Headless command-line entry point: PixelEngine --farm <count> [options]
+int run_world_farm_cli(int argc, char* argv[]);
+
+} // namespace PixelEngine
@@ -0,0 +1,171 @@
+#include "AgentTable.h"
+
+namespace PixelEngine {
+
+AgentTable::AgentTable()
+    : x_(CAPACITY)
+    , y_(CAPACITY)
+    , health_(CAPACITY)
+    , personality_(CAPACITY)
+    , facing_right_(CAPACITY)
+    , clock_(CAPACITY)
+    , state_(CAPACITY)
+    , alive_(CAPACITY)
+    , next_(CAPACITY, INVALID)
+    , prev_(CAPACITY, INVALID) {
+    free_.reserve(CAPACITY);
+}
+
+void AgentTable::resize(int32_t width, int32_t height) {
+    buckets_wide_ = (width + (1 << BUCKET_SHIFT) - 1) >> BUCKET_SHIFT;
+    buckets_high_ = (height + (1 << BUCKET_SHIFT) - 1) >> BUCKET_SHIFT;
+    buckets_.assign(static_cast<size_t>(buckets_wide_) * buckets_high_, INVALID);
+    clear();
+}
+
+AgentHandle AgentTable::spawn(int32_t x, int32_t y) {
+    AgentHandle h;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tls_log_) {
+            // Provisional: the number depends on which task got here first,
+            // so commit() swaps it for a final slot
+            if (reserve_used_ == SPAWN_RESERVE) return INVALID;
+            h = static_cast<AgentHandle>(FINAL_CAPACITY + reserve_used_++);
+            tls_log_->spawned.push_back(h);
+        } else {
+            h = take_slot();
+            if (h == INVALID) return INVALID;
+        }
+        ++count_;
+    }
+
+    // Defaults for a Person nobody configured (Egg hatches, brush);
+    // personality and facing come from the position so they stay
+    // deterministic no matter which thread spawned the agent
+    uint32_t seed = static_cast<uint32_t>(x) * 31337u ^ static_cast<uint32_t>(y) * 7919u;
+    x_[h] = static_cast<int16_t>(x);
+    y_[h] = static_cast<int16_t>(y);
+    health_[h] = 100;
+    personality_[h] = static_cast<uint8_t>(80 + seed % 48);
+    facing_right_[h] = static_cast<uint8_t>((seed >> 8) & 1);
+    clock_[h] = 0;
+    state_[h] = AgentState::Idle;
+    alive_[h] = 1;
+    link(h);
+    return h;
+}
+
+void AgentTable::despawn(AgentHandle h) {
+    if (h >= CAPACITY || !alive_[h]) return;
+
+    unlink(h);
+    alive_[h] = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    --count_;
+    if (h >= FINAL_CAPACITY) return;  // Provisional slots return with the reserve
+    if (tls_log_) {
+        tls_log_->released.push_back(h);
+    } else {
+        free_.push_back(h);
+    }
+}
+
+void AgentTable::move(AgentHandle h, int32_t x, int32_t y) {
+    int32_t from = bucket_of(x_[h], y_[h]);
+    int32_t to = bucket_of(x, y);
+    if (from != to) unlink(h);
+    x_[h] = static_cast<int16_t>(x);
+    y_[h] = static_cast<int16_t>(y);
+    if (from != to) link(h);
+}
+
+AgentHandle AgentTable::find_at(int32_t x, int32_t y) const {
+    if (x < 0 || y < 0 || (x >> BUCKET_SHIFT) >= buckets_wide_ || (y >> BUCKET_SHIFT) >= buckets_high_) {
+        return INVALID;
+    }
+    for (AgentHandle h = buckets_[bucket_of(x, y)]; h != INVALID; h = next_[h]) {
+        if (x_[h] == x && y_[h] == y) return h;
+    }
+    return INVALID;
+}
+
+bool AgentTable::any_within(int32_t x, int32_t y, int32_t radius) const {
+    bool found = false;
+    for_each_within(x - radius, y - radius, x + radius, y + radius, [&](AgentHandle) { found = true; });
+    return found;
+}
+
+size_t AgentTable::get_state_count(AgentState state) const {
+    size_t total = 0;
+    for_each([&](AgentHandle h) {
+        if (state_[h] == state) ++total;
+    });
+    return total;
+}
+
+void AgentTable::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::fill(alive_.begin(), alive_.begin() + high_water_, 0);
+    std::fill(alive_.begin() + FINAL_CAPACITY, alive_.end(), 0);
+    std::fill(buckets_.begin(), buckets_.end(), INVALID);
+    free_.clear();
+    high_water_ = 0;
+    reserve_used_ = 0;
+    count_ = 0;
+}
+
+AgentHandle AgentTable::take_slot() {
+    if (!free_.empty()) {
+        AgentHandle h = free_.back();
+        free_.pop_back();
+        return h;
+    }
+    if (high_water_ < FINAL_CAPACITY) return static_cast<AgentHandle>(high_water_++);
+    return INVALID;
+}
+
+AgentHandle AgentTable::settle(AgentHandle provisional) {
+    AgentHandle h;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        h = take_slot();
+    }
+    if (h == INVALID) {
+        despawn(provisional);
+        return INVALID;
+    }
+
+    x_[h] = x_[provisional];
+    y_[h] = y_[provisional];
+    health_[h] = health_[provisional];
+    personality_[h] = personality_[provisional];
+    facing_right_[h] = facing_right_[provisional];
+    clock_[h] = clock_[provisional];
+    state_[h] = state_[provisional];
+    unlink(provisional);
+    alive_[provisional] = 0;
+    alive_[h] = 1;
+    link(h);
+    return h;
+}
+
+void AgentTable::link(AgentHandle h) {
+    AgentHandle& head = buckets_[bucket_of(x_[h], y_[h])];
+    prev_[h] = INVALID;
+    next_[h] = head;
+    if (head != INVALID) prev_[head] = h;
+    head = h;
+}
+
+void AgentTable::unlink(AgentHandle h) {
+    if (prev_[h] != INVALID) {
+        next_[prev_[h]] = next_[h];
+    } else {
+        buckets_[bucket_of(x_[h], y_[h])] = next_[h];
+    }
+    if (next_[h] != INVALID) prev_[next_[h]] = prev_[h];
+}
+
+} // namespace PixelEngine
@@ -0,0 +1,119 @@
+#include "BuildJobs.h"
+#include "World.h"
+#include <algorithm>
+
+namespace PixelEngine {
+
+bool BuildJobQueue::begin_job() {
+    if (recording_ || jobs_.size() >= MAX_JOBS) {
+        return false;
+    }
+    jobs_.emplace_back();
+    recording_ = true;
+    return true;
+}
+
+void BuildJobQueue::record_block(int32_t x, int32_t y, MaterialID material) {
+    if (!recording_) return;
+    jobs_.back().blocks.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y), material});
+}
+
+bool BuildJobQueue::end_job() {
+    if (!recording_) return false;
+    recording_ = false;
+
+    Job& job = jobs_.back();
+    if (job.blocks.empty()) {
+        jobs_.pop_back();
+        return false;
+    }
+
+    job.min_x = job.max_x = job.blocks[0].x;
+    job.min_y = job.max_y = job.blocks[0].y;
+    for (const BuildBlock& block : job.blocks) {
+        job.min_x = std::min<int32_t>(job.min_x, block.x);
+        job.max_x = std::max<int32_t>(job.max_x, block.x);
+        job.min_y = std::min<int32_t>(job.min_y, block.y);
+        job.max_y = std::max<int32_t>(job.max_y, block.y);
+    }
+
+    // Another person already claimed (part of) this spot
+    for (size_t i = 0; i + 1 < jobs_.size(); ++i) {
+        const Job& other = jobs_[i];
+        if (job.min_x <= other.max_x && job.max_x >= other.min_x &&
+            job.min_y <= other.max_y && job.max_y >= other.min_y) {
+            jobs_.pop_back();
+            return false;
+        }
+    }
+
+    // Grow from the ground up. Stable, so when a blueprint places the same
+    // cell twice the first block still wins, as with immediate placement.
+    std::stable_sort(job.blocks.begin(), job.blocks.end(),
+                     [](const BuildBlock& a, const BuildBlock& b) { return a.y > b.y; });
+    return true;
+}
+
+bool BuildJobQueue::overlaps_site(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y) const {
+    size_t count = get_job_count();
+    for (size_t i = 0; i < count; ++i) {
+        const Job& job = jobs_[i];
+        if (min_x <= job.max_x && max_x >= job.min_x &&
+            min_y <= job.max_y && max_y >= job.min_y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t BuildJobQueue::step(World& world) {
+    if (recording_ || jobs_.empty()) return 0;
+
+    uint32_t budget = BLOCKS_PER_FRAME;
+    uint32_t placed = 0;
+    size_t job_count = jobs_.size();
+    if (next_job_ >= job_count) next_job_ = 0;
+
+    for (size_t n = 0; n < job_count && budget > 0; ++n) {
+        Job& job = jobs_[(next_job_ + n) % job_count];
+
+        uint32_t quota = std::min(BLOCKS_PER_JOB_PER_FRAME, budget);
+        while (quota > 0 && job.next_block < job.blocks.size()) {
+            const BuildBlock& block = job.blocks[job.next_block++];
+            --quota;
+            --budget;
+
+            // Only build into open air; the site may have changed since it was planned
+            MaterialID current = world.get_material(block.x, block.y);
+            if (current == MaterialID::Empty || current == MaterialID::Steam ||
+                current == MaterialID::Smoke) {
+                world.set_material(block.x, block.y, block.material);
+                ++placed;
+            }
+        }
+    }
+    next_job_ = (next_job_ + 1) % job_count;
+
+    // Retire finished sites
+    jobs_.erase(std::remove_if(jobs_.begin(), jobs_.end(),
+                               [](const Job& job) { return job.next_block >= job.blocks.size(); }),
+                jobs_.end());
+    return placed;
+}
+
+void BuildJobQueue::clear() {
+    jobs_.clear();
+    recording_ = false;
+    next_job_ = 0;
+}
+
+uint32_t BuildJobQueue::get_pending_blocks() const {
+    uint32_t pending = 0;
+    size_t count = get_job_count();
+    for (size_t i = 0; i < count; ++i) {
+        pending += static_cast<uint32_t>(jobs_[i].blocks.size() - jobs_[i].next_block);
+    }
+    return pending;
+}
+
+} // namespace PixelEngine
@@ -0,0 +1,227 @@
+#include "ConductorNetwork.h"
+#include "World.h"
+#include <algorithm>
+
+namespace PixelEngine {
+
+namespace {
+
+// Label of cells waiting for relabel()'s flood fill
+constexpr uint32_t UNLABELED = 0xFFFFFFFFu;
+
+// One conductor cell in PULSE_SPARK_MASK + 1 throws sparks when its network pulses
+constexpr uint32_t PULSE_SPARK_MASK = 3;
+constexpr uint8_t PULSE_SPARK_LIFETIME = 5;
+
+constexpr int32_t NEIGHBOR_DX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+constexpr int32_t NEIGHBOR_DY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+} // namespace
+
+void ConductorNetwork::resize(int32_t width, int32_t height) {
+    width_ = width;
+    height_ = height;
+    labels_.assign(static_cast<size_t>(width) * height, 0);
+    clear();
+}
+
+void ConductorNetwork::clear() {
+    std::fill(labels_.begin(), labels_.end(), 0);
+    networks_.assign(1, Network{});
+    free_ids_.clear();
+    pulse_count_ = 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes_.clear();
+    charges_.clear();
+}
+
+void ConductorNetwork::note_change(int32_t x, int32_t y) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    changes_.push_back(y * width_ + x);
+}
+
+void ConductorNetwork::energize(int32_t x, int32_t y) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    charges_.push_back(y * width_ + x);
+}
+
+uint32_t ConductorNetwork::new_network() {
+    if (!free_ids_.empty()) {
+        uint32_t id = free_ids_.back();
+        free_ids_.pop_back();
+        return id;
+    }
+    networks_.emplace_back();
+    return static_cast<uint32_t>(networks_.size() - 1);
+}
+
+void ConductorNetwork::free_network(uint32_t id) {
+    Network& network = networks_[id];
+    network.cells.clear();
+    network.size = 0;
+    network.dirty = false;
+    free_ids_.push_back(id);
+}
+
+void ConductorNetwork::add_cell(const World& world, int32_t index) {
+    if (labels_[index] != 0) return;
+    int32_t x = index % width_;
+    int32_t y = index / width_;
+
+    // Distinct networks around the new cell
+    ids_.clear();
+    for (int32_t n = 0; n < 8; ++n) {
+        int32_t nx = x + NEIGHBOR_DX[n];
+        int32_t ny = y + NEIGHBOR_DY[n];
+        if (!world.in_bounds(nx, ny)) continue;
+        uint32_t id = labels_[static_cast<size_t>(ny) * width_ + nx];
+        if (id != 0 && std::find(ids_.begin(), ids_.end(), id) == ids_.end()) {
+            ids_.push_back(id);
+        }
+    }
+
+    uint32_t target;
+    if (ids_.empty()) {
+        target = new_network();
+    } else {
+        // Merge into the largest (lowest id on ties): relabel the smaller ones
+        target = ids_[0];
+        for (uint32_t id : ids_) {
+            if (networks_[id].size > networks_[target].size ||
+                (networks_[id].size == networks_[target].size && id < target)) {
+                target = id;
+            }
+        }
+        for (uint32_t id : ids_) {
+            if (id == target) continue;
+            for (int32_t cell : networks_[id].cells) {
+                if (labels_[cell] != id) continue;
+                labels_[cell] = target;
+                networks_[target].cells.push_back(cell);
+            }
+            networks_[target].size += networks_[id].size;
+            networks_[target].dirty |= networks_[id].dirty;
+            free_network(id);
+        }
+    }
+
+    labels_[index] = target;
+    networks_[target].cells.push_back(index);
+    ++networks_[target].size;
+}
+
+void ConductorNetwork::remove_cell(int32_t index) {
+    uint32_t id = labels_[index];
+    if (id == 0) return;
+    labels_[index] = 0;
+
+    // The rest may have split; relabel() sorts it out once per step
+    if (--networks_[id].size == 0) {
+        free_network(id);
+    } else {
+        networks_[id].dirty = true;
+    }
+}
+
+void ConductorNetwork::relabel(const World& world, uint32_t id) {
+    std::vector<int32_t> cells = std::move(networks_[id].cells);
+    for (int32_t cell : cells) {
+        if (labels_[cell] == id) labels_[cell] = UNLABELED;
+    }
+    free_network(id);
+
+    // Each flood fill over the unlabeled cells is one surviving piece
+    for (int32_t seed : cells) {
+        if (labels_[seed] != UNLABELED) continue;
+        uint32_t piece = new_network();
+        labels_[seed] = piece;
+        stack_.clear();
+        stack_.push_back(seed);
+        while (!stack_.empty()) {
+            int32_t cell = stack_.back();
+            stack_.pop_back();
+            networks_[piece].cells.push_back(cell);
+            ++networks_[piece].size;
+
+            int32_t x = cell % width_;
+            int32_t y = cell / width_;
+            for (int32_t n = 0; n < 8; ++n) {
+                int32_t nx = x + NEIGHBOR_DX[n];
+                int32_t ny = y + NEIGHBOR_DY[n];
+                if (!world.in_bounds(nx, ny)) continue;
+                int32_t neighbor = ny * width_ + nx;
+                if (labels_[neighbor] == UNLABELED) {
+                    labels_[neighbor] = piece;
+                    stack_.push_back(neighbor);
+                }
+            }
+        }
+    }
+}
+
+void ConductorNetwork::pulse(World& world, uint32_t id) {
+    ++pulse_count_;
+    for (int32_t cell : networks_[id].cells) {
+        if (labels_[cell] != id) continue;
+        if ((world.random_int() & PULSE_SPARK_MASK) != 0) continue;
+
+        int32_t x = cell % width_;
+        int32_t y = cell / width_;
+        for (int32_t n = 0; n < 8; ++n) {
+            int32_t nx = x + NEIGHBOR_DX[n];
+            int32_t ny = y + NEIGHBOR_DY[n];
+            if (world.in_bounds(nx, ny) && world.get_material(nx, ny) == MaterialID::Empty) {
+                world.set_material(nx, ny, MaterialID::Spark);
+                world.get_cell(nx, ny).set_lifetime(PULSE_SPARK_LIFETIME);
+            }
+        }
+    }
+}
+
+void ConductorNetwork::step(World& world) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.swap(changes_);
+    }
+
+    // Queue order depends on threads; cell order doesn't. Each cell is
+    // judged by what it holds now, so repeated notes collapse.
+    if (!pending_.empty()) {
+        std::sort(pending_.begin(), pending_.end());
+        pending_.erase(std::unique(pending_.begin(), pending_.end()), pending_.end());
+        for (int32_t index : pending_) {
+            bool conducts = is_conductor(world.get_material(index % width_, index / width_));
+            if (conducts && labels_[index] == 0) {
+                add_cell(world, index);
+            } else if (!conducts && labels_[index] != 0) {
+                remove_cell(index);
+            }
+        }
+        pending_.clear();
+
+        for (uint32_t id = 1; id < networks_.size(); ++id) {
+            if (networks_[id].dirty) relabel(world, id);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.swap(charges_);
+    }
+    if (pending_.empty()) return;
+
+    // Each charged network pulses once, in id order
+    ids_.clear();
+    for (int32_t index : pending_) {
+        if (labels_[index] != 0) ids_.push_back(labels_[index]);
+    }
+    pending_.clear();
+    std::sort(ids_.begin(), ids_.end());
+    ids_.erase(std::unique(ids_.begin(), ids_.end()), ids_.end());
+    for (uint32_t id : ids_) {
+        pulse(world, id);
+    }
+}
+
+} // namespace PixelEngine
@@ -111,9 +111,23 @@ int DiscoverySystem::find_combination_index(MaterialID a, MaterialID b) const {
 bool DiscoverySystem::on_combination_occurred(MaterialID a, MaterialID b,
                                                MaterialID result_a, MaterialID result_b,
                                                uint32_t frame_number) {
+    (void)result_a;
+    (void)result_b;
+
     int idx = find_combination_index(a, b);
     if (idx < 0) return false;
 
+    if (!apply_combination(idx, frame_number)) {
+        return false;
+    }
+
+    // Update hint levels for remaining undiscovered combinations
+    update_hint_levels();
+
+    return true;
+}
+
+bool DiscoverySystem::apply_combination(int idx, uint32_t frame_number) {
     CombinationProgress& progress = combination_progress_[idx];
 
     if (progress.discovered) {
@@ -123,6 +137,11 @@ bool DiscoverySystem::on_combination_occurred(MaterialID a, MaterialID b,
     // Mark as discovered
     progress.discovered = true;
 
+    MaterialID a = progress.mat_a;
+    MaterialID b = progress.mat_b;
+    MaterialID result_a = progress.result_a;
+    MaterialID result_b = progress.result_b;
+
     // Unlock result materials and create discovery entries
     bool any_new = false;
 
@@ -157,19 +176,12 @@ bool DiscoverySystem::on_combination_occurred(MaterialID a, MaterialID b,
         discovery_log_.push_back(entry);
     }
 
-    // Update hint levels for remaining undiscovered combinations
-    update_hint_levels();
-
     return true;
 }
 
-void DiscoverySystem::unlock_material(MaterialID id) {
-    unlocked_materials_.set(static_cast<size_t>(id));
-}
-
-void DiscoverySystem::unlock_with_popup(MaterialID id, uint32_t frame_number) {
+bool DiscoverySystem::apply_material_spawned(MaterialID id, uint32_t frame_number) {
     if (is_material_unlocked(id)) {
-        return;  // Already unlocked
+        return false;  // Already unlocked
     }
 
     // Unlock the material
@@ -179,6 +191,42 @@ void DiscoverySystem::unlock_with_popup(MaterialID id, uint32_t frame_number) {
     DiscoveryEntry entry(id, MaterialID::Empty, MaterialID::Empty, frame_number);
     discovery_log_.push_back(entry);
     new_discoveries_.push_back(entry);
+    return true;
+}
+
+void DiscoverySystem::drain_events(DiscoveryEventQueue& queue, uint32_t frame_number) {
+    bool changed = false;
+
+    queue.drain([&](const DiscoveryEvent& event) {
+        if (event.type == DiscoveryEventType::Combination) {
+            int idx = event.recipe_index;
+            if (idx >= static_cast<int>(combination_progress_.size())) return;
+
+            changed |= apply_combination(idx, frame_number);
+
+            // A discovered recipe never produces another discovery
+            queue.mute_combination(event.recipe_index);
+        } else {
+            changed |= apply_material_spawned(event.material, frame_number);
+
+            // Unlocked materials no longer need the safety net
+            queue.mute_material(event.material);
+        }
+    });
+
+    if (changed) {
+        update_hint_levels();
+    }
+}
+
+void DiscoverySystem::unlock_material(MaterialID id) {
+    unlocked_materials_.set(static_cast<size_t>(id));
+}
+
+void DiscoverySystem::unlock_with_popup(MaterialID id, uint32_t frame_number) {
+    if (!apply_material_spawned(id, frame_number)) {
+        return;  // Already unlocked
+    }
 
     // Update hint levels since we have a new material
     update_hint_levels();
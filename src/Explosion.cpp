@@ -0,0 +1,289 @@
+#include "Explosion.h"
+#include "World.h"
+#include <array>
+#include <vector>
+
+namespace PixelEngine {
+namespace Explosions {
+
+namespace {
+
+constexpr uint8_t KEEP = 0xFF;  // Table entry: leave the cell untouched
+constexpr int32_t MAX_RINGS = 3;
+
+// ============================================================================
+// BLAST DEFINITIONS
+// ============================================================================
+
+struct LifetimeRule {
+    MaterialID material;
+    uint8_t lifetime;
+};
+
+constexpr MaterialID NONE = MaterialID::COUNT;  // Pads the short material lists below
+
+// One ring of a blast: cells with inner ring < dist_sq <= max_dist_sq.
+// With chance == 1 every cell takes the hit result; otherwise 1 in `chance`
+// cells does and the rest take the miss result (NONE = leave the cell alone).
+struct RingSpec {
+    int32_t max_dist_sq;
+    uint8_t chance;
+    MaterialID hit;
+    MaterialID miss;
+    bool hit_empty_only;                // Only Empty cells take the hit result
+    bool miss_empty_only;               // Only Empty cells take the miss result
+    MaterialID spared[2];               // Extra materials this ring never touches
+};
+
+struct BlastSpec {
+    int32_t radius;
+    MaterialID immune[3];               // Materials no ring touches
+    int32_t ring_count;
+    RingSpec rings[MAX_RINGS];
+    LifetimeRule lifetimes[3];          // Lifetime given to produced materials
+    uint8_t lifetime_jitter_mask;       // Random extra lifetime (rand & mask)
+};
+
+// Ring bounds and mappings reproduce the old per-material loops in
+// Material.cpp; only the order of the random draws differs.
+const BlastSpec BLAST_SPECS[] = {
+    // TNT: inner half (by area) vaporised, outer ring set on fire except stone
+    {8, {MaterialID::Obsidian, MaterialID::Diamond, MaterialID::Void}, 2,
+     {{8 * 8 / 2, 1, MaterialID::Empty, NONE, false, false, {NONE, NONE}},
+      {8 * 8, 1, MaterialID::Fire, NONE, false, false, {MaterialID::Stone, NONE}}},
+     {{MaterialID::Fire, 15}, {NONE, 0}, {NONE, 0}}, 0},
+    // C4: bigger, vaporised core covers 3/4 of the disk
+    {15, {MaterialID::Obsidian, MaterialID::Diamond, MaterialID::Void}, 2,
+     {{15 * 15 * 3 / 4, 1, MaterialID::Empty, NONE, false, false, {NONE, NONE}},
+      {15 * 15, 1, MaterialID::Fire, NONE, false, false, {MaterialID::Stone, NONE}}},
+     {{MaterialID::Fire, 20}, {NONE, 0}, {NONE, 0}}, 0},
+    // Firework: 1 in 4 empty cells becomes confetti
+    {6, {NONE, NONE, NONE}, 1,
+     {{6 * 6, 4, MaterialID::Confetti, NONE, true, false, {NONE, NONE}}},
+     {{MaterialID::Confetti, 50}, {NONE, 0}, {NONE, 0}}, 31},
+    // Bomb: fire core, then half smoke, half nothing
+    {8, {MaterialID::Bedrock, MaterialID::Obsidian, NONE}, 2,
+     {{4 * 4, 1, MaterialID::Fire, NONE, false, false, {NONE, NONE}},
+      {8 * 8, 2, MaterialID::Smoke, MaterialID::Empty, false, false, {NONE, NONE}}},
+     {{MaterialID::Fire, 20}, {MaterialID::Smoke, 30}, {NONE, 0}}, 0},
+    // Nuke: plasma core, fire ring, then 1 in 3 smoke
+    {40, {MaterialID::Bedrock, NONE, NONE}, 3,
+     {{13 * 13, 1, MaterialID::Plasma, NONE, false, false, {NONE, NONE}},
+      {20 * 20, 1, MaterialID::Fire, NONE, false, false, {NONE, NONE}},
+      {40 * 40, 3, MaterialID::Smoke, MaterialID::Empty, false, false, {NONE, NONE}}},
+     {{MaterialID::Plasma, 40}, {MaterialID::Fire, 30}, {MaterialID::Smoke, 50}}, 0},
+    // Ice bomb: 1 in 3 empty cells frost; the freeze mapping is added in build_tables
+    {12, {NONE, NONE, NONE}, 1,
+     {{12 * 12, 3, MaterialID::Frost, NONE, true, false, {NONE, NONE}}},
+     {{MaterialID::Frost, 40}, {NONE, 0}, {NONE, 0}}, 0},
+    // Fire bomb: napalm core; outer ring burns half of everything and all empty cells
+    {10, {MaterialID::Bedrock, MaterialID::Water, NONE}, 2,
+     {{5 * 5, 1, MaterialID::Napalm, NONE, false, false, {NONE, NONE}},
+      {10 * 10, 2, MaterialID::Fire, MaterialID::Fire, false, true, {NONE, NONE}}},
+     {{MaterialID::Napalm, 50}, {MaterialID::Fire, 25}, {NONE, 0}}, 0},
+};
+static_assert(sizeof(BLAST_SPECS) / sizeof(BLAST_SPECS[0]) == static_cast<size_t>(BlastType::COUNT),
+              "one BlastSpec per BlastType");
+
+// ============================================================================
+// PRECOMPUTED TABLES
+// ============================================================================
+
+// Span mask of a disk: for every row dy in [-r, r], the largest |dx| inside
+// each ring (-1 if the ring does not reach that row)
+struct DiskSpans {
+    int32_t radius = 0;
+    std::vector<std::array<int32_t, MAX_RINGS>> half_width;  // Indexed by dy + radius
+};
+
+struct RingTables {
+    uint8_t chance = 1;
+    std::array<uint8_t, 256> hit;
+    std::array<uint8_t, 256> miss;
+};
+
+struct BlastTables {
+    DiskSpans spans;
+    std::array<RingTables, MAX_RINGS> rings;
+    int32_t ring_count = 0;
+    std::array<uint8_t, 256> lifetime;   // 0 = leave lifetime bits alone
+    uint8_t lifetime_jitter_mask = 0;
+};
+
+DiskSpans build_spans(int32_t radius, const BlastSpec& spec) {
+    DiskSpans spans;
+    spans.radius = radius;
+    spans.half_width.resize(2 * radius + 1);
+    for (int32_t dy = -radius; dy <= radius; ++dy) {
+        for (int32_t ring = 0; ring < MAX_RINGS; ++ring) {
+            int32_t half = -1;
+            if (ring < spec.ring_count) {
+                while ((half + 1) * (half + 1) + dy * dy <= spec.rings[ring].max_dist_sq) {
+                    ++half;
+                }
+            }
+            spans.half_width[dy + radius][ring] = half;
+        }
+    }
+    return spans;
+}
+
+template <size_t N>
+bool in_list(const MaterialID (&list)[N], int32_t id) {
+    for (MaterialID material : list) {
+        if (static_cast<int32_t>(material) == id) return true;
+    }
+    return false;
+}
+
+BlastTables build_tables(BlastType type) {
+    const BlastSpec& spec = BLAST_SPECS[static_cast<int>(type)];
+    BlastTables tables;
+    tables.spans = build_spans(spec.radius, spec);
+    tables.ring_count = spec.ring_count;
+    tables.lifetime.fill(0);
+    tables.lifetime_jitter_mask = spec.lifetime_jitter_mask;
+    for (const LifetimeRule& rule : spec.lifetimes) {
+        if (rule.material != NONE) {
+            tables.lifetime[static_cast<int>(rule.material)] = rule.lifetime;
+        }
+    }
+
+    const int32_t empty = static_cast<int32_t>(MaterialID::Empty);
+    for (int32_t r = 0; r < spec.ring_count; ++r) {
+        const RingSpec& ring = spec.rings[r];
+        RingTables& out = tables.rings[r];
+        out.chance = ring.chance;
+        out.hit.fill(KEEP);
+        out.miss.fill(KEEP);
+
+        for (int32_t id = 0; id < static_cast<int32_t>(MaterialID::COUNT); ++id) {
+            if (in_list(spec.immune, id) || in_list(ring.spared, id)) continue;
+
+            if (ring.hit != NONE && (!ring.hit_empty_only || id == empty)) {
+                out.hit[id] = static_cast<uint8_t>(ring.hit);
+            }
+            if (ring.miss != NONE && (!ring.miss_empty_only || id == empty)) {
+                out.miss[id] = static_cast<uint8_t>(ring.miss);
+            }
+        }
+    }
+
+    // Ice bomb freezes by material instead of destroying
+    if (type == BlastType::IceBomb) {
+        RingTables& ring = tables.rings[0];
+        const std::pair<MaterialID, MaterialID> freeze[] = {
+            {MaterialID::Water, MaterialID::Ice},
+            {MaterialID::Lava, MaterialID::Obsidian},
+            {MaterialID::Steam, MaterialID::Snow},
+            {MaterialID::Steam_Hot, MaterialID::Snow},
+            {MaterialID::Fire, MaterialID::Empty},
+            {MaterialID::Ember, MaterialID::Empty},
+        };
+        for (const auto& [from, to] : freeze) {
+            ring.hit[static_cast<int>(from)] = static_cast<uint8_t>(to);
+            ring.miss[static_cast<int>(from)] = static_cast<uint8_t>(to);
+        }
+    }
+    return tables;
+}
+
+const BlastTables& get_tables(BlastType type) {
+    // Built once, thread-safe (simulation chunks may detonate concurrently)
+    static const std::array<BlastTables, static_cast<size_t>(BlastType::COUNT)> all = []() {
+        std::array<BlastTables, static_cast<size_t>(BlastType::COUNT)> tables;
+        for (size_t i = 0; i < tables.size(); ++i) {
+            tables[i] = build_tables(static_cast<BlastType>(i));
+        }
+        return tables;
+    }();
+    return all[static_cast<size_t>(type)];
+}
+
+// Map one contiguous run of cells through a ring's tables
+void apply_ring_run(World& world, Cell* cells, int32_t count, int32_t first_x, int32_t y,
+                    const RingTables& ring, const BlastTables& tables, std::array<uint64_t, 4>& produced) {
+    const int32_t chunk_index = world.get_chunk_index(first_x, y);  // A run never leaves its chunk
+    for (int32_t i = 0; i < count; ++i) {
+        Cell& cell = cells[i];
+        uint8_t from = static_cast<uint8_t>(cell.material_id);
+        uint8_t to = ring.hit[from];
+        if (ring.chance > 1 && !world.random_one_in(ring.chance)) {
+            to = ring.miss[from];
+        }
+        if (to == KEEP) continue;
+
+        if (PortalRegistry::is_portal(static_cast<MaterialID>(from)) ||
+            static_cast<MaterialID>(from) == MaterialID::Person) {
+            // Rare: let World unregister the destroyed portal / agent
+            world.set_material(first_x + i, y, static_cast<MaterialID>(to));
+        } else {
+            cell.material_id = static_cast<MaterialID>(to);
+            world.census().replace(chunk_index, static_cast<MaterialID>(from), static_cast<MaterialID>(to));
+            if (ConductorNetwork::is_conductor(static_cast<MaterialID>(from)) !=
+                ConductorNetwork::is_conductor(static_cast<MaterialID>(to))) {
+                world.conductors().note_change(first_x + i, y);
+            }
+        }
+        if (tables.lifetime[to] != 0) {
+            uint8_t jitter = tables.lifetime_jitter_mask
+                ? static_cast<uint8_t>(world.random_int() & tables.lifetime_jitter_mask) : 0;
+            cell.set_lifetime(static_cast<uint8_t>(tables.lifetime[to] + jitter));
+        }
+        produced[to >> 6] |= 1ull << (to & 63);
+    }
+}
+
+} // namespace
+
+int32_t get_blast_radius(BlastType type) {
+    return BLAST_SPECS[static_cast<int>(type)].radius;
+}
+
+void detonate(World& world, int32_t x, int32_t y, BlastType type) {
+    const BlastTables& tables = get_tables(type);
+    const int32_t radius = tables.spans.radius;
+    std::array<uint64_t, 4> produced = {0, 0, 0, 0};
+
+    for (int32_t dy = -radius; dy <= radius; ++dy) {
+        const auto& half = tables.spans.half_width[dy + radius];
+        int32_t inner = -1;
+
+        // Each ring covers [-half, half] minus the inner ring: two runs per row
+        for (int32_t r = 0; r < tables.ring_count; ++r) {
+            int32_t outer = half[r];
+            if (outer > inner) {
+                auto run = [&](Cell* cells, int32_t count, int32_t first_x) {
+                    apply_ring_run(world, cells, count, first_x, y + dy, tables.rings[r], tables, produced);
+                };
+                if (inner < 0) {
+                    world.for_each_row_span(y + dy, x - outer, x + outer, run);
+                } else {
+                    world.for_each_row_span(y + dy, x - outer, x - inner - 1, run);
+                    world.for_each_row_span(y + dy, x + inner + 1, x + outer, run);
+                }
+                inner = outer;
+            }
+        }
+    }
+
+    world.activate_region(x - radius, y - radius, x + radius, y + radius);
+
+    // One discovery notification per produced material
+    if (world.discovery_events_enabled()) {
+        for (int32_t word = 0; word < 4; ++word) {
+            uint64_t bits = produced[word];
+            while (bits) {
+                int32_t bit = __builtin_ctzll(bits);
+                bits &= bits - 1;
+                MaterialID material = static_cast<MaterialID>(word * 64 + bit);
+                if (material != MaterialID::Empty) {
+                    world.discovery_events().push_material_spawned(material);
+                }
+            }
+        }
+    }
+}
+
+} // namespace Explosions
+} // namespace PixelEngine
@@ -0,0 +1,207 @@
+#include "GravityField.h"
+#include "World.h"
+#include <algorithm>
+
+namespace PixelEngine {
+
+namespace {
+
+int32_t source_reach(GravityField::SourceKind kind) {
+    return kind == GravityField::SourceKind::Attractor ? Materials::BLACK_HOLE_GRAVITY_WELL
+                                                       : Materials::WHITE_HOLE_PUSH_RADIUS;
+}
+
+} // namespace
+
+void GravityField::resize(int32_t width, int32_t height) {
+    width_ = width;
+    height_ = height;
+    tiles_wide_ = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tiles_high_ = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+    size_t tile_count = static_cast<size_t>(tiles_wide_) * tiles_high_;
+    for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+        accumulators_[kind] = std::make_unique<Accumulator[]>(tile_count);
+        sources_[kind].clear();
+        tile_source_[kind].assign(tile_count, -1);
+    }
+    affected_tiles_.clear();
+}
+
+void GravityField::add_source(int32_t x, int32_t y, SourceKind kind) {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) return;
+
+    size_t k = static_cast<size_t>(kind);
+    Accumulator& acc = accumulators_[k][(y / TILE_SIZE) * tiles_wide_ + x / TILE_SIZE];
+    if (acc.mass.fetch_add(1, std::memory_order_relaxed) == 0) {
+        occupied_tiles_[k].fetch_add(1, std::memory_order_relaxed);
+    }
+    acc.sum_x.fetch_add(static_cast<uint32_t>(x), std::memory_order_relaxed);
+    acc.sum_y.fetch_add(static_cast<uint32_t>(y), std::memory_order_relaxed);
+}
+
+void GravityField::collect_sources(SourceKind kind) {
+    size_t k = static_cast<size_t>(kind);
+    sources_[k].clear();
+
+    // Stop scanning once every occupied tile is found (no holes: no scan)
+    uint32_t remaining = occupied_tiles_[k].exchange(0, std::memory_order_relaxed);
+    int32_t tile_count = tiles_wide_ * tiles_high_;
+    for (int32_t tile = 0; tile < tile_count && remaining > 0; ++tile) {
+        Accumulator& acc = accumulators_[k][tile];
+        uint32_t mass = acc.mass.load(std::memory_order_relaxed);
+        if (mass == 0) continue;
+
+        // Rounded centroid: a lone hole cell stays exactly where it is
+        uint32_t sum_x = acc.sum_x.load(std::memory_order_relaxed);
+        uint32_t sum_y = acc.sum_y.load(std::memory_order_relaxed);
+        sources_[k].push_back({static_cast<int32_t>((sum_x + mass / 2) / mass),
+                               static_cast<int32_t>((sum_y + mass / 2) / mass), mass});
+
+        acc.mass.store(0, std::memory_order_relaxed);
+        acc.sum_x.store(0, std::memory_order_relaxed);
+        acc.sum_y.store(0, std::memory_order_relaxed);
+        --remaining;
+    }
+}
+
+void GravityField::assign_tiles(SourceKind kind) {
+    size_t k = static_cast<size_t>(kind);
+    int32_t reach = source_reach(kind);
+
+    for (size_t i = 0; i < sources_[k].size(); ++i) {
+        const Source& source = sources_[k][i];
+        int32_t tile_x0 = std::max(source.x - reach, 0) / TILE_SIZE;
+        int32_t tile_y0 = std::max(source.y - reach, 0) / TILE_SIZE;
+        int32_t tile_x1 = std::min(source.x + reach, width_ - 1) / TILE_SIZE;
+        int32_t tile_y1 = std::min(source.y + reach, height_ - 1) / TILE_SIZE;
+
+        for (int32_t tile_y = tile_y0; tile_y <= tile_y1; ++tile_y) {
+            for (int32_t tile_x = tile_x0; tile_x <= tile_x1; ++tile_x) {
+                int32_t tile = tile_y * tiles_wide_ + tile_x;
+                int32_t& owner = tile_source_[k][tile];
+                if (owner < 0) {
+                    owner = static_cast<int32_t>(i);
+                    affected_tiles_.push_back(tile);
+                    continue;
+                }
+
+                // Keep whichever source is stronger (mass / r²) at the tile centre
+                int64_t center_x = tile_x * TILE_SIZE + TILE_SIZE / 2;
+                int64_t center_y = tile_y * TILE_SIZE + TILE_SIZE / 2;
+                const Source& current = sources_[k][owner];
+                int64_t dist_new = (center_x - source.x) * (center_x - source.x) +
+                                   (center_y - source.y) * (center_y - source.y) + 1;
+                int64_t dist_cur = (center_x - current.x) * (center_x - current.x) +
+                                   (center_y - current.y) * (center_y - current.y) + 1;
+                if (static_cast<int64_t>(source.mass) * dist_cur > static_cast<int64_t>(current.mass) * dist_new) {
+                    owner = static_cast<int32_t>(i);
+                }
+            }
+        }
+    }
+}
+
+void GravityField::apply_tile(World& world, SourceKind kind, int32_t tile) {
+    size_t k = static_cast<size_t>(kind);
+    int32_t owner = tile_source_[k][tile];
+    if (owner < 0) return;
+
+    const Source source = sources_[k][owner];
+    int32_t reach = source_reach(kind);
+    int32_t reach_sq = reach * reach;
+    constexpr int32_t photon_sphere_sq = Materials::BLACK_HOLE_PHOTON_SPHERE * Materials::BLACK_HOLE_PHOTON_SPHERE;
+
+    int32_t x0 = (tile % tiles_wide_) * TILE_SIZE;
+    int32_t y0 = (tile / tiles_wide_) * TILE_SIZE;
+    int32_t y1 = std::min(y0 + TILE_SIZE, height_);
+
+    for (int32_t y = y0; y < y1; ++y) {
+        int32_t dy = y - source.y;
+        // A tile never straddles a chunk, so this is a single run
+        world.for_each_row_span(y, x0, x0 + TILE_SIZE - 1, [&](Cell* cells, int32_t count, int32_t first_x) {
+            for (int32_t i = 0; i < count; ++i) {
+                const Cell& cell = cells[i];
+                if (cell.material_id == MaterialID::Empty || cell.was_updated()) continue;
+
+                int32_t x = first_x + i;
+                int32_t dx = x - source.x;
+                int32_t dist_sq = dx * dx + dy * dy;
+                if (dist_sq > reach_sq) continue;
+
+                if (kind == SourceKind::Attractor) {
+                    // The hole cells handle their own event horizon and photon sphere
+                    if (dist_sq <= photon_sphere_sq) continue;
+                    Materials::apply_black_hole_pull(world, x, y, dx, dy, source.mass);
+                } else {
+                    if (dist_sq == 0) continue;
+                    Materials::apply_white_hole_push(world, x, y, dx, dy, source.mass);
+                }
+            }
+        });
+    }
+}
+
+void GravityField::step(World& world) {
+    // Forget last frame's assignment
+    for (int32_t tile : affected_tiles_) {
+        for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+            tile_source_[kind][tile] = -1;
+        }
+    }
+    affected_tiles_.clear();
+
+    for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+        collect_sources(static_cast<SourceKind>(kind));
+        assign_tiles(static_cast<SourceKind>(kind));
+    }
+    if (affected_tiles_.empty()) return;
+
+    std::sort(affected_tiles_.begin(), affected_tiles_.end());
+    affected_tiles_.erase(std::unique(affected_tiles_.begin(), affected_tiles_.end()), affected_tiles_.end());
+
+    // The cell pass is over, so the updated bit is free to mean "moved by the
+    // field this step": clear it first so every cell is moved at most once.
+    for (int32_t tile : affected_tiles_) {
+        int32_t x0 = (tile % tiles_wide_) * TILE_SIZE;
+        int32_t y0 = (tile / tiles_wide_) * TILE_SIZE;
+        int32_t y1 = std::min(y0 + TILE_SIZE, height_);
+        for (int32_t y = y0; y < y1; ++y) {
+            world.for_each_row_span(y, x0, x0 + TILE_SIZE - 1, [](Cell* cells, int32_t count, int32_t) {
+                for (int32_t i = 0; i < count; ++i) cells[i].clear_updated();
+            });
+        }
+    }
+
+    for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+        if (sources_[kind].empty()) continue;
+        for (int32_t tile : affected_tiles_) {
+            apply_tile(world, static_cast<SourceKind>(kind), tile);
+        }
+    }
+}
+
+void GravityField::clear() {
+    size_t tile_count = static_cast<size_t>(tiles_wide_) * tiles_high_;
+    for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+        for (size_t tile = 0; tile < tile_count; ++tile) {
+            accumulators_[kind][tile].mass.store(0, std::memory_order_relaxed);
+            accumulators_[kind][tile].sum_x.store(0, std::memory_order_relaxed);
+            accumulators_[kind][tile].sum_y.store(0, std::memory_order_relaxed);
+        }
+        occupied_tiles_[kind].store(0, std::memory_order_relaxed);
+        sources_[kind].clear();
+        std::fill(tile_source_[kind].begin(), tile_source_[kind].end(), -1);
+    }
+    affected_tiles_.clear();
+}
+
+size_t GravityField::get_source_count() const {
+    size_t count = 0;
+    for (size_t kind = 0; kind < KIND_COUNT; ++kind) {
+        count += sources_[kind].size();
+    }
+    return count;
+}
+
+} // namespace PixelEngine
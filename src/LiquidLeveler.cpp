@@ -0,0 +1,235 @@
+#include "LiquidLeveler.h"
+#include "World.h"
+#include <algorithm>
+#include <array>
+
+namespace PixelEngine {
+
+namespace {
+
+constexpr std::array<bool, 256> IS_LEVELED = [] {
+    std::array<bool, 256> leveled{};
+    for (MaterialID material : Materials::LEVELED_LIQUIDS) leveled[static_cast<uint8_t>(material)] = true;
+    return leveled;
+}();
+
+// A resting cell still picks up one frame of gravity (velocity 2) whenever a
+// bubble below lets it drop a row; faster cells are falling
+constexpr int8_t RESTING_VELOCITY = 2;
+
+} // namespace
+
+void LiquidLeveler::resize(int32_t width, int32_t height) {
+    width_ = width;
+    height_ = height;
+    labels_.assign(static_cast<size_t>(width) * height, 0);
+    next_label_ = 1;
+    current_label_ = 0;
+}
+
+bool LiquidLeveler::is_body_cell(const World& world, int32_t x, int32_t y) const {
+    if (!world.in_bounds(x, y)) return false;
+    const Cell& cell = world.get_cell(x, y);
+    return cell.material_id == current_material_ && cell.velocity_y <= RESTING_VELOCITY;
+}
+
+bool LiquidLeveler::is_supported(const World& world, int32_t x, int32_t y) const {
+    if (y + 1 >= height_) return true;  // The floor
+    MaterialID below = world.get_material(x, y + 1);
+    if (below == current_material_) return is_body_cell(world, x, y + 1);
+    MaterialState state = MATERIAL_DEFS[static_cast<size_t>(below)].state;
+    return state == MaterialState::Solid || state == MaterialState::Powder;
+}
+
+uint32_t LiquidLeveler::step(World& world) {
+    if (++frame_ % INTERVAL != 0) return 0;
+
+    // Labels are never cleared, only outnumbered; start over before they wrap
+    if (next_label_ > 0xFFFF0000u) {
+        std::fill(labels_.begin(), labels_.end(), 0);
+        next_label_ = 1;
+    }
+    const uint32_t first_label = next_label_;
+
+    body_count_ = 0;
+    uint32_t moved = 0;
+    int32_t stopped_at = -1;
+
+    // Start where the last solve ran out of moves, then wrap around, so a
+    // busy body near the top can't starve the rest of the world
+    const int32_t chunks_wide = world.get_chunks_wide();
+    for (bool wrapped : {false, true}) {
+        world.for_each_active_chunk(false, false, [&](int32_t chunk_x, int32_t chunk_y, Chunk&) {
+            int32_t chunk_index = chunk_y * chunks_wide + chunk_x;
+            if (stopped_at >= 0 || (chunk_index < resume_chunk_) != wrapped) return;
+
+            moved += scan_chunk(world, chunk_x, chunk_y, first_label, MAX_MOVES_PER_STEP - moved);
+            if (moved >= MAX_MOVES_PER_STEP) stopped_at = chunk_index;
+        });
+    }
+    resume_chunk_ = stopped_at >= 0 ? stopped_at : 0;
+    return moved;
+}
+
+uint32_t LiquidLeveler::scan_chunk(World& world, int32_t chunk_x, int32_t chunk_y, uint32_t first_label,
+                                   uint32_t budget) {
+    const MaterialCensus& census = world.census();
+    int32_t chunk_index = chunk_y * world.get_chunks_wide() + chunk_x;
+    bool any = false;
+    for (MaterialID material : Materials::LEVELED_LIQUIDS) {
+        any = any || census.chunk_contains(chunk_index, material);
+    }
+    if (!any) return 0;
+
+    uint32_t moved = 0;
+    int32_t base_x = chunk_x * CHUNK_SIZE;
+    int32_t base_y = chunk_y * CHUNK_SIZE;
+    int32_t max_x = std::min(base_x + CHUNK_SIZE, width_);
+    int32_t max_y = std::min(base_y + CHUNK_SIZE, height_);
+    for (int32_t y = base_y; y < max_y; ++y) {
+        for (int32_t x = base_x; x < max_x; ++x) {
+            if (labels_[static_cast<size_t>(y) * width_ + x] >= first_label) continue;
+            const Cell& cell = world.get_cell(x, y);
+            if (!IS_LEVELED[static_cast<uint8_t>(cell.material_id)] || cell.velocity_y > RESTING_VELOCITY) continue;
+
+            current_material_ = cell.material_id;
+            label_body(world, x, y);
+            ++body_count_;
+            moved += level_body(world, budget - moved);
+            if (moved >= budget) return moved;
+        }
+    }
+    return moved;
+}
+
+void LiquidLeveler::label_body(World& world, int32_t seed_x, int32_t seed_y) {
+    current_label_ = next_label_++;
+    spans_.clear();
+    stack_.clear();
+    stack_.push_back({static_cast<int16_t>(seed_x), static_cast<int16_t>(seed_y)});
+
+    auto open = [&](int32_t x, int32_t y) {
+        return is_body_cell(world, x, y) && labels_[static_cast<size_t>(y) * width_ + x] != current_label_;
+    };
+
+    while (!stack_.empty()) {
+        Slot seed = stack_.back();
+        stack_.pop_back();
+        if (!open(seed.x, seed.y)) continue;
+
+        // Grow the seed into its full row span
+        int32_t x0 = seed.x;
+        int32_t x1 = seed.x;
+        while (open(x0 - 1, seed.y)) --x0;
+        while (open(x1 + 1, seed.y)) ++x1;
+
+        uint32_t* row = &labels_[static_cast<size_t>(seed.y) * width_];
+        std::fill(row + x0, row + x1 + 1, current_label_);
+        spans_.push_back({seed.y, static_cast<int16_t>(x0), static_cast<int16_t>(x1)});
+
+        // One seed per run of body cells on the rows above and below
+        for (int32_t y : {seed.y - 1, seed.y + 1}) {
+            for (int32_t x = x0; x <= x1; ++x) {
+                if (!open(x, y)) continue;
+                stack_.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y)});
+                while (x + 1 <= x1 && open(x + 1, y)) ++x;
+            }
+        }
+    }
+}
+
+uint32_t LiquidLeveler::level_body(World& world, uint32_t budget) {
+    tops_.clear();
+    holes_.clear();
+
+    // Heap orders: the highest surface cell and the lowest free spot come first
+    auto top_after = [](const Slot& a, const Slot& b) {
+        return a.y > b.y || (a.y == b.y && a.x > b.x);
+    };
+    auto hole_after = [](const Slot& a, const Slot& b) {
+        return a.y < b.y || (a.y == b.y && a.x > b.x);
+    };
+
+    // Surface cells (open above) and the free spots around the body: the
+    // open cell above each surface cell, and supported open cells beside
+    // each span
+    int32_t highest_top = height_;
+    int32_t lowest_hole = -1;
+    for (const Span& span : spans_) {
+        for (int32_t x = span.x0; x <= span.x1; ++x) {
+            if (span.y > 0 && world.get_material(x, span.y - 1) == MaterialID::Empty) {
+                tops_.push_back({static_cast<int16_t>(x), span.y});
+                holes_.push_back({static_cast<int16_t>(x), static_cast<int16_t>(span.y - 1)});
+                highest_top = std::min<int32_t>(highest_top, span.y);
+                lowest_hole = std::max<int32_t>(lowest_hole, span.y - 1);
+            }
+        }
+        for (int32_t x : {span.x0 - 1, span.x1 + 1}) {
+            if (world.in_bounds(x, span.y) && world.get_material(x, span.y) == MaterialID::Empty &&
+                is_supported(world, x, span.y)) {
+                holes_.push_back({static_cast<int16_t>(x), span.y});
+                lowest_hole = std::max<int32_t>(lowest_hole, span.y);
+            }
+        }
+    }
+
+    // Already level (the usual case): no free spot two rows below a surface
+    if (tops_.empty() || lowest_hole <= highest_top + 1) return 0;
+
+    std::make_heap(tops_.begin(), tops_.end(), top_after);
+    std::make_heap(holes_.begin(), holes_.end(), hole_after);
+
+    uint32_t moved = 0;
+    while (moved < budget && !tops_.empty() && !holes_.empty()) {
+        Slot top = tops_.front();
+        Slot hole = holes_.front();
+        if (hole.y <= top.y + 1) break;
+
+        std::pop_heap(tops_.begin(), tops_.end(), top_after);
+        tops_.pop_back();
+        size_t top_index = static_cast<size_t>(top.y) * width_ + top.x;
+        if (labels_[top_index] != current_label_ || !is_body_cell(world, top.x, top.y) ||
+            world.get_material(top.x, top.y - 1) != MaterialID::Empty) {
+            continue;  // Stale: this surface cell already moved
+        }
+
+        // Find a spot that is still free and still supported
+        bool found = false;
+        while (!holes_.empty()) {
+            hole = holes_.front();
+            if (hole.y <= top.y + 1) break;
+            std::pop_heap(holes_.begin(), holes_.end(), hole_after);
+            holes_.pop_back();
+            if (world.get_material(hole.x, hole.y) == MaterialID::Empty && is_supported(world, hole.x, hole.y)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) break;
+
+        // Pour the surface cell into the spot (swap with Empty keeps its state)
+        world.swap_cells(top.x, top.y, hole.x, hole.y);
+        world.activate_region(top.x, top.y, top.x, top.y);
+        world.activate_region(hole.x, hole.y, hole.x, hole.y);
+        labels_[top_index] = 0;
+        labels_[static_cast<size_t>(hole.y) * width_ + hole.x] = current_label_;
+        ++moved;
+
+        // The cell under the old surface is the new surface; the filled
+        // spot is a surface cell with a new free spot above it
+        if (top.y + 1 < height_ && labels_[top_index + width_] == current_label_ &&
+            is_body_cell(world, top.x, top.y + 1)) {
+            tops_.push_back({top.x, static_cast<int16_t>(top.y + 1)});
+            std::push_heap(tops_.begin(), tops_.end(), top_after);
+        }
+        if (hole.y > 0 && world.get_material(hole.x, hole.y - 1) == MaterialID::Empty) {
+            tops_.push_back(hole);
+            std::push_heap(tops_.begin(), tops_.end(), top_after);
+            holes_.push_back({hole.x, static_cast<int16_t>(hole.y - 1)});
+            std::push_heap(holes_.begin(), holes_.end(), hole_after);
+        }
+    }
+    return moved;
+}
+
+} // namespace PixelEngine
@@ -1,7 +1,10 @@
 #include "Material.h"
 #include "World.h"
+#include "Explosion.h"
 #include <random>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 
 namespace PixelEngine {
 
@@ -29,1320 +32,10 @@ Color MaterialDef::get_color(std::mt19937& rng) const {
 
 MaterialSystem::MaterialSystem()
     : rng_(std::random_device{}()) {
-    initialize_materials();
-}
-
-void MaterialSystem::initialize_materials() {
-    // Empty (air)
-    materials_[static_cast<size_t>(MaterialID::Empty)] = MaterialDef(
-        MaterialID::Empty,
-        MaterialState::Empty,
-        0.0f,
-        Color(0, 0, 0, 0),  // Transparent
-        0
-    );
-
-    // Stone (immovable solid)
-    materials_[static_cast<size_t>(MaterialID::Stone)] = MaterialDef(
-        MaterialID::Stone,
-        MaterialState::Solid,
-        1000.0f,
-        Color(100, 100, 100),  // Gray
-        15  // Slight color variation
-    );
-
-    // Sand (powder - falls and piles)
-    materials_[static_cast<size_t>(MaterialID::Sand)] = MaterialDef(
-        MaterialID::Sand,
-        MaterialState::Powder,
-        1.5f,
-        Color(194, 178, 128),  // Sandy yellow
-        20  // Color variation
-    );
-
-    // Water (liquid - flows)
-    materials_[static_cast<size_t>(MaterialID::Water)] = MaterialDef(
-        MaterialID::Water,
-        MaterialState::Liquid,
-        1.0f,
-        Color(64, 164, 223),  // Blue
-        10  // Slight variation
-    );
-
-    // Steam (gas - rises)
-    materials_[static_cast<size_t>(MaterialID::Steam)] = MaterialDef(
-        MaterialID::Steam,
-        MaterialState::Gas,
-        0.1f,
-        Color(220, 220, 220, 180),  // Light gray, semi-transparent
-        15
-    );
-
-    // Oil (liquid - less dense than water, flammable)
-    materials_[static_cast<size_t>(MaterialID::Oil)] = MaterialDef(
-        MaterialID::Oil,
-        MaterialState::Liquid,
-        0.8f,  // Less dense than water (floats)
-        Color(40, 35, 20),  // Dark brown/black
-        8
-    );
-
-    // Fire (gas/energy - rises, spreads, has lifetime)
-    materials_[static_cast<size_t>(MaterialID::Fire)] = MaterialDef(
-        MaterialID::Fire,
-        MaterialState::Gas,
-        0.05f,  // Very light
-        Color(255, 120, 0),  // Bright orange
-        40  // High variation (orange to yellow)
-    );
-
-    // Wood (solid - burnable, floats on water)
-    materials_[static_cast<size_t>(MaterialID::Wood)] = MaterialDef(
-        MaterialID::Wood,
-        MaterialState::Solid,
-        0.6f,  // Less dense than water (floats)
-        Color(101, 67, 33),  // Brown
-        15
-    );
-
-    // Acid (liquid - corrodes solids)
-    materials_[static_cast<size_t>(MaterialID::Acid)] = MaterialDef(
-        MaterialID::Acid,
-        MaterialState::Liquid,
-        1.2f,  // Denser than water
-        Color(100, 255, 100),  // Bright green
-        20
-    );
-
-    // Lava (liquid/fire hybrid - burns, solidifies)
-    materials_[static_cast<size_t>(MaterialID::Lava)] = MaterialDef(
-        MaterialID::Lava,
-        MaterialState::Liquid,
-        2.5f,  // Very dense
-        Color(255, 80, 0),  // Bright red-orange
-        30  // High variation (red to yellow)
-    );
-
-    // Ash (powder - rises slowly, settles)
-    materials_[static_cast<size_t>(MaterialID::Ash)] = MaterialDef(
-        MaterialID::Ash,
-        MaterialState::Powder,
-        0.3f,  // Light powder
-        Color(60, 60, 60),  // Dark gray
-        10
-    );
-
-    // Grass (solid - burnable)
-    materials_[static_cast<size_t>(MaterialID::Grass)] = MaterialDef(
-        MaterialID::Grass,
-        MaterialState::Solid,
-        0.8f,
-        Color(34, 139, 34),  // Green
-        25
-    );
-
-    // Smoke (gas - rises, dissipates)
-    materials_[static_cast<size_t>(MaterialID::Smoke)] = MaterialDef(
-        MaterialID::Smoke,
-        MaterialState::Gas,
-        0.08f,  // Very light
-        Color(80, 80, 80, 150),  // Gray, semi-transparent
-        20
-    );
-
-    // Person (autonomous agent - solid-like for update ordering)
-    materials_[static_cast<size_t>(MaterialID::Person)] = MaterialDef(
-        MaterialID::Person,
-        MaterialState::Solid,  // Treated as solid for priority order (updates last)
-        1.0f,  // Human density
-        Color(255, 50, 255),  // Bright magenta (highly visible)
-        20  // Some color variation
-    );
-
-    // ============================================================================
-    // POWDERS (10-19)
-    // ============================================================================
-
-    // Dirt (earthy brown powder)
-    materials_[static_cast<size_t>(MaterialID::Dirt)] = MaterialDef(
-        MaterialID::Dirt,
-        MaterialState::Powder,
-        1.4f,
-        Color(101, 67, 33),  // Brown
-        20
-    );
-
-    // Gravel (gray rocky powder)
-    materials_[static_cast<size_t>(MaterialID::Gravel)] = MaterialDef(
-        MaterialID::Gravel,
-        MaterialState::Powder,
-        2.0f,
-        Color(128, 128, 128),  // Gray
-        25
-    );
-
-    // Snow (white powder, light)
-    materials_[static_cast<size_t>(MaterialID::Snow)] = MaterialDef(
-        MaterialID::Snow,
-        MaterialState::Powder,
-        0.3f,
-        Color(240, 248, 255),  // Almost white
-        10
-    );
-
-    // Gunpowder (dark gray, explosive)
-    materials_[static_cast<size_t>(MaterialID::Gunpowder)] = MaterialDef(
-        MaterialID::Gunpowder,
-        MaterialState::Powder,
-        1.2f,
-        Color(50, 50, 50),  // Dark gray
-        10
-    );
-
-    // Salt (white crystals)
-    materials_[static_cast<size_t>(MaterialID::Salt)] = MaterialDef(
-        MaterialID::Salt,
-        MaterialState::Powder,
-        1.3f,
-        Color(255, 255, 255),  // White
-        8
-    );
-
-    // Coal (black powder, burns)
-    materials_[static_cast<size_t>(MaterialID::Coal)] = MaterialDef(
-        MaterialID::Coal,
-        MaterialState::Powder,
-        1.5f,
-        Color(30, 30, 30),  // Almost black
-        10
-    );
-
-    // Rust (orange-brown powder)
-    materials_[static_cast<size_t>(MaterialID::Rust)] = MaterialDef(
-        MaterialID::Rust,
-        MaterialState::Powder,
-        1.8f,
-        Color(183, 65, 14),  // Rust orange
-        20
-    );
-
-    // Sawdust (light tan, flammable)
-    materials_[static_cast<size_t>(MaterialID::Sawdust)] = MaterialDef(
-        MaterialID::Sawdust,
-        MaterialState::Powder,
-        0.4f,
-        Color(210, 180, 140),  // Tan
-        15
-    );
-
-    // Glass_Powder (sparkly white/clear)
-    materials_[static_cast<size_t>(MaterialID::Glass_Powder)] = MaterialDef(
-        MaterialID::Glass_Powder,
-        MaterialState::Powder,
-        1.6f,
-        Color(200, 220, 255),  // Light blue tint
-        20
-    );
-
-    // ============================================================================
-    // LIQUIDS (20-29)
-    // ============================================================================
-
-    // Honey (golden viscous)
-    materials_[static_cast<size_t>(MaterialID::Honey)] = MaterialDef(
-        MaterialID::Honey,
-        MaterialState::Liquid,
-        1.4f,
-        Color(255, 185, 15),  // Golden
-        15
-    );
-
-    // Mud (brown liquid)
-    materials_[static_cast<size_t>(MaterialID::Mud)] = MaterialDef(
-        MaterialID::Mud,
-        MaterialState::Liquid,
-        1.5f,
-        Color(80, 60, 40),  // Dark brown
-        15
-    );
-
-    // Blood (dark red)
-    materials_[static_cast<size_t>(MaterialID::Blood)] = MaterialDef(
-        MaterialID::Blood,
-        MaterialState::Liquid,
-        1.05f,
-        Color(138, 7, 7),  // Dark red
-        20
-    );
-
-    // Poison (purple toxic)
-    materials_[static_cast<size_t>(MaterialID::Poison)] = MaterialDef(
-        MaterialID::Poison,
-        MaterialState::Liquid,
-        1.1f,
-        Color(148, 0, 211),  // Purple
-        25
-    );
-
-    // Slime (green goop)
-    materials_[static_cast<size_t>(MaterialID::Slime)] = MaterialDef(
-        MaterialID::Slime,
-        MaterialState::Liquid,
-        1.3f,
-        Color(50, 205, 50),  // Lime green
-        20
-    );
-
-    // Milk (white liquid)
-    materials_[static_cast<size_t>(MaterialID::Milk)] = MaterialDef(
-        MaterialID::Milk,
-        MaterialState::Liquid,
-        1.03f,
-        Color(255, 250, 250),  // White
-        5
-    );
-
-    // Alcohol (clear/light blue)
-    materials_[static_cast<size_t>(MaterialID::Alcohol)] = MaterialDef(
-        MaterialID::Alcohol,
-        MaterialState::Liquid,
-        0.79f,  // Lighter than water
-        Color(200, 220, 255),  // Light blue
-        15
-    );
-
-    // Mercury (silver metallic liquid)
-    materials_[static_cast<size_t>(MaterialID::Mercury)] = MaterialDef(
-        MaterialID::Mercury,
-        MaterialState::Liquid,
-        13.5f,  // Very heavy!
-        Color(192, 192, 192),  // Silver
-        15
-    );
-
-    // Petrol (light yellow, flammable)
-    materials_[static_cast<size_t>(MaterialID::Petrol)] = MaterialDef(
-        MaterialID::Petrol,
-        MaterialState::Liquid,
-        0.75f,  // Lighter than water
-        Color(255, 255, 100),  // Light yellow
-        20
-    );
-
-    // Glue (white sticky)
-    materials_[static_cast<size_t>(MaterialID::Glue)] = MaterialDef(
-        MaterialID::Glue,
-        MaterialState::Liquid,
-        1.2f,
-        Color(255, 255, 240),  // Off-white
-        10
-    );
-
-    // ============================================================================
-    // GASES (30-39)
-    // ============================================================================
-
-    // Toxic_Gas (green gas)
-    materials_[static_cast<size_t>(MaterialID::Toxic_Gas)] = MaterialDef(
-        MaterialID::Toxic_Gas,
-        MaterialState::Gas,
-        0.07f,
-        Color(50, 150, 50, 150),  // Green, semi-transparent
-        20
-    );
-
-    // Hydrogen (very light, invisible-ish)
-    materials_[static_cast<size_t>(MaterialID::Hydrogen)] = MaterialDef(
-        MaterialID::Hydrogen,
-        MaterialState::Gas,
-        0.02f,  // Very light
-        Color(200, 200, 255, 100),  // Very faint blue
-        15
-    );
-
-    // Helium (light, slightly visible)
-    materials_[static_cast<size_t>(MaterialID::Helium)] = MaterialDef(
-        MaterialID::Helium,
-        MaterialState::Gas,
-        0.03f,
-        Color(255, 200, 200, 120),  // Very faint pink
-        15
-    );
-
-    // Methane (invisible-ish, flammable)
-    materials_[static_cast<size_t>(MaterialID::Methane)] = MaterialDef(
-        MaterialID::Methane,
-        MaterialState::Gas,
-        0.04f,
-        Color(180, 180, 180, 80),  // Very faint
-        10
-    );
-
-    // Spark (bright electrical)
-    materials_[static_cast<size_t>(MaterialID::Spark)] = MaterialDef(
-        MaterialID::Spark,
-        MaterialState::Gas,
-        0.01f,
-        Color(255, 255, 0),  // Bright yellow
-        40
-    );
-
-    // Plasma (hot pink/purple)
-    materials_[static_cast<size_t>(MaterialID::Plasma)] = MaterialDef(
-        MaterialID::Plasma,
-        MaterialState::Gas,
-        0.01f,
-        Color(255, 0, 255),  // Hot magenta
-        50
-    );
-
-    // Dust (brown floating)
-    materials_[static_cast<size_t>(MaterialID::Dust)] = MaterialDef(
-        MaterialID::Dust,
-        MaterialState::Gas,
-        0.15f,
-        Color(139, 119, 101, 180),  // Dusty brown
-        20
-    );
-
-    // Spore (green biological)
-    materials_[static_cast<size_t>(MaterialID::Spore)] = MaterialDef(
-        MaterialID::Spore,
-        MaterialState::Gas,
-        0.12f,
-        Color(100, 180, 100, 160),  // Green
-        25
-    );
-
-    // Confetti (colorful!)
-    materials_[static_cast<size_t>(MaterialID::Confetti)] = MaterialDef(
-        MaterialID::Confetti,
-        MaterialState::Gas,
-        0.2f,
-        Color(255, 100, 150),  // Pink (but will vary)
-        100  // High variance for colorful effect
-    );
-
-    // ============================================================================
-    // SOLIDS (40-49)
-    // ============================================================================
-
-    // Metal (dark gray, heavy)
-    materials_[static_cast<size_t>(MaterialID::Metal)] = MaterialDef(
-        MaterialID::Metal,
-        MaterialState::Solid,
-        7.8f,
-        Color(120, 120, 130),  // Steel gray
-        15
-    );
-
-    // Gold (shiny yellow)
-    materials_[static_cast<size_t>(MaterialID::Gold)] = MaterialDef(
-        MaterialID::Gold,
-        MaterialState::Solid,
-        19.3f,  // Very heavy
-        Color(255, 215, 0),  // Gold
-        20
-    );
-
-    // Ice (light blue, melts)
-    materials_[static_cast<size_t>(MaterialID::Ice)] = MaterialDef(
-        MaterialID::Ice,
-        MaterialState::Solid,
-        0.92f,  // Less dense than water
-        Color(173, 216, 230),  // Light blue
-        15
-    );
-
-    // Glass (transparent blue-white)
-    materials_[static_cast<size_t>(MaterialID::Glass)] = MaterialDef(
-        MaterialID::Glass,
-        MaterialState::Solid,
-        2.5f,
-        Color(200, 230, 255),  // Very light blue
-        10
-    );
-
-    // Brick (reddish brown)
-    materials_[static_cast<size_t>(MaterialID::Brick)] = MaterialDef(
-        MaterialID::Brick,
-        MaterialState::Solid,
-        1.9f,
-        Color(178, 34, 34),  // Brick red
-        20
-    );
-
-    // Obsidian (black volcanic glass)
-    materials_[static_cast<size_t>(MaterialID::Obsidian)] = MaterialDef(
-        MaterialID::Obsidian,
-        MaterialState::Solid,
-        2.4f,
-        Color(20, 20, 30),  // Very dark
-        10
-    );
-
-    // Diamond (sparkly clear)
-    materials_[static_cast<size_t>(MaterialID::Diamond)] = MaterialDef(
-        MaterialID::Diamond,
-        MaterialState::Solid,
-        3.5f,
-        Color(185, 242, 255),  // Light cyan sparkle
-        25
-    );
-
-    // Copper (orange-brown metal)
-    materials_[static_cast<size_t>(MaterialID::Copper)] = MaterialDef(
-        MaterialID::Copper,
-        MaterialState::Solid,
-        8.9f,
-        Color(184, 115, 51),  // Copper brown
-        20
-    );
-
-    // Rubber (dark bouncy)
-    materials_[static_cast<size_t>(MaterialID::Rubber)] = MaterialDef(
-        MaterialID::Rubber,
-        MaterialState::Solid,
-        1.1f,
-        Color(30, 30, 30),  // Dark
-        15
-    );
-
-    // ============================================================================
-    // ORGANIC (50-59)
-    // ============================================================================
-
-    // Leaf (bright green)
-    materials_[static_cast<size_t>(MaterialID::Leaf)] = MaterialDef(
-        MaterialID::Leaf,
-        MaterialState::Powder,  // Falls like a powder
-        0.2f,
-        Color(50, 180, 50),  // Green
-        30
-    );
-
-    // Moss (dark green, grows)
-    materials_[static_cast<size_t>(MaterialID::Moss)] = MaterialDef(
-        MaterialID::Moss,
-        MaterialState::Solid,
-        0.5f,
-        Color(34, 100, 34),  // Dark green
-        25
-    );
-
-    // Vine (green, grows down)
-    materials_[static_cast<size_t>(MaterialID::Vine)] = MaterialDef(
-        MaterialID::Vine,
-        MaterialState::Solid,
-        0.4f,
-        Color(0, 128, 0),  // Green
-        20
-    );
-
-    // Fungus (purple/tan)
-    materials_[static_cast<size_t>(MaterialID::Fungus)] = MaterialDef(
-        MaterialID::Fungus,
-        MaterialState::Solid,
-        0.6f,
-        Color(150, 100, 150),  // Purple-tan
-        30
-    );
-
-    // Seed (brown, grows into plants)
-    materials_[static_cast<size_t>(MaterialID::Seed)] = MaterialDef(
-        MaterialID::Seed,
-        MaterialState::Powder,
-        0.8f,
-        Color(139, 90, 43),  // Brown
-        20
-    );
-
-    // Flower (colorful)
-    materials_[static_cast<size_t>(MaterialID::Flower)] = MaterialDef(
-        MaterialID::Flower,
-        MaterialState::Solid,
-        0.3f,
-        Color(255, 100, 150),  // Pink
-        50  // High variance for variety
-    );
-
-    // Algae (green water plant)
-    materials_[static_cast<size_t>(MaterialID::Algae)] = MaterialDef(
-        MaterialID::Algae,
-        MaterialState::Liquid,  // Floats in water
-        0.95f,
-        Color(0, 100, 0),  // Dark green
-        25
-    );
-
-    // Coral (orange/pink, underwater)
-    materials_[static_cast<size_t>(MaterialID::Coral)] = MaterialDef(
-        MaterialID::Coral,
-        MaterialState::Solid,
-        1.5f,
-        Color(255, 127, 80),  // Coral color
-        30
-    );
-
-    // Wax (off-white, melts)
-    materials_[static_cast<size_t>(MaterialID::Wax)] = MaterialDef(
-        MaterialID::Wax,
-        MaterialState::Solid,
-        0.9f,
-        Color(255, 250, 200),  // Off-white/cream
-        15
-    );
-
-    // Flesh (pink organic)
-    materials_[static_cast<size_t>(MaterialID::Flesh)] = MaterialDef(
-        MaterialID::Flesh,
-        MaterialState::Solid,
-        1.05f,
-        Color(255, 182, 193),  // Pink
-        20
-    );
-
-    // ============================================================================
-    // SPECIAL (60-69)
-    // ============================================================================
-
-    // Clone (copies adjacent materials)
-    materials_[static_cast<size_t>(MaterialID::Clone)] = MaterialDef(
-        MaterialID::Clone,
-        MaterialState::Solid,
-        1.0f,
-        Color(200, 200, 200),  // Gray
-        10
-    );
-
-    // Void (destroys everything)
-    materials_[static_cast<size_t>(MaterialID::Void)] = MaterialDef(
-        MaterialID::Void,
-        MaterialState::Solid,
-        1000.0f,
-        Color(0, 0, 0),  // Pure black
-        0
-    );
-
-    // Fuse (burns along a line)
-    materials_[static_cast<size_t>(MaterialID::Fuse)] = MaterialDef(
-        MaterialID::Fuse,
-        MaterialState::Solid,
-        0.5f,
-        Color(160, 82, 45),  // Brown rope
-        15
-    );
-
-    // TNT (explosive!)
-    materials_[static_cast<size_t>(MaterialID::TNT)] = MaterialDef(
-        MaterialID::TNT,
-        MaterialState::Solid,
-        1.0f,
-        Color(255, 0, 0),  // Red
-        15
-    );
-
-    // C4 (more explosive!)
-    materials_[static_cast<size_t>(MaterialID::C4)] = MaterialDef(
-        MaterialID::C4,
-        MaterialState::Solid,
-        1.3f,
-        Color(240, 230, 140),  // Khaki/tan
-        10
-    );
-
-    // Firework (shoots up and explodes)
-    materials_[static_cast<size_t>(MaterialID::Firework)] = MaterialDef(
-        MaterialID::Firework,
-        MaterialState::Solid,
-        0.8f,
-        Color(255, 50, 50),  // Red
-        30
-    );
-
-    // Lightning (electrical discharge)
-    materials_[static_cast<size_t>(MaterialID::Lightning)] = MaterialDef(
-        MaterialID::Lightning,
-        MaterialState::Gas,
-        0.01f,
-        Color(255, 255, 150),  // Bright yellow
-        50
-    );
-
-    // Portal_In (teleporter entrance)
-    materials_[static_cast<size_t>(MaterialID::Portal_In)] = MaterialDef(
-        MaterialID::Portal_In,
-        MaterialState::Solid,
-        1.0f,
-        Color(0, 100, 255),  // Blue
-        30
-    );
-
-    // Portal_Out (teleporter exit)
-    materials_[static_cast<size_t>(MaterialID::Portal_Out)] = MaterialDef(
-        MaterialID::Portal_Out,
-        MaterialState::Solid,
-        1.0f,
-        Color(255, 100, 0),  // Orange
-        30
-    );
-
-    // ============================================================================
-    // FANTASY (70-79)
-    // ============================================================================
-
-    // Magic (sparkly purple energy)
-    materials_[static_cast<size_t>(MaterialID::Magic)] = MaterialDef(
-        MaterialID::Magic,
-        MaterialState::Gas,
-        0.05f,
-        Color(180, 100, 255),  // Purple
-        50
-    );
-
-    // Crystal (sparkly gem)
-    materials_[static_cast<size_t>(MaterialID::Crystal)] = MaterialDef(
-        MaterialID::Crystal,
-        MaterialState::Solid,
-        2.8f,
-        Color(200, 100, 255),  // Purple crystal
-        40
-    );
-
-    // Ectoplasm (ghostly green goo)
-    materials_[static_cast<size_t>(MaterialID::Ectoplasm)] = MaterialDef(
-        MaterialID::Ectoplasm,
-        MaterialState::Liquid,
-        0.5f,
-        Color(100, 255, 150, 180),  // Ghostly green
-        30
-    );
-
-    // Antimatter (inverted colors, destroys on contact)
-    materials_[static_cast<size_t>(MaterialID::Antimatter)] = MaterialDef(
-        MaterialID::Antimatter,
-        MaterialState::Liquid,
-        -1.0f,  // Negative density (rises!)
-        Color(50, 0, 80),  // Dark purple
-        20
-    );
-
-    // Fairy_Dust (sparkly pink)
-    materials_[static_cast<size_t>(MaterialID::Fairy_Dust)] = MaterialDef(
-        MaterialID::Fairy_Dust,
-        MaterialState::Powder,
-        0.1f,
-        Color(255, 182, 255),  // Pink
-        50
-    );
-
-    // Dragon_Fire (super hot flames)
-    materials_[static_cast<size_t>(MaterialID::Dragon_Fire)] = MaterialDef(
-        MaterialID::Dragon_Fire,
-        MaterialState::Gas,
-        0.02f,
-        Color(255, 50, 0),  // Deep orange-red
-        40
-    );
-
-    // Frost (freezing cold particles)
-    materials_[static_cast<size_t>(MaterialID::Frost)] = MaterialDef(
-        MaterialID::Frost,
-        MaterialState::Gas,
-        0.08f,
-        Color(200, 230, 255),  // Icy blue
-        25
-    );
-
-    // Ember (glowing hot particles)
-    materials_[static_cast<size_t>(MaterialID::Ember)] = MaterialDef(
-        MaterialID::Ember,
-        MaterialState::Powder,
-        0.4f,
-        Color(255, 100, 0),  // Orange glow
-        35
-    );
-
-    // Stardust (sparkly cosmic)
-    materials_[static_cast<size_t>(MaterialID::Stardust)] = MaterialDef(
-        MaterialID::Stardust,
-        MaterialState::Powder,
-        0.05f,
-        Color(255, 255, 200),  // Pale gold
-        60
-    );
-
-    // Void_Dust (dark matter particles)
-    materials_[static_cast<size_t>(MaterialID::Void_Dust)] = MaterialDef(
-        MaterialID::Void_Dust,
-        MaterialState::Powder,
-        0.15f,
-        Color(30, 0, 50),  // Very dark purple
-        20
-    );
-
-    // Life (falling spawner particle - creates Person on safe ground)
-    materials_[static_cast<size_t>(MaterialID::Life)] = MaterialDef(
-        MaterialID::Life,
-        MaterialState::Powder,  // Falls like a particle
-        0.8f,
-        Color(255, 200, 255),  // Bright pink/magenta glow
-        30  // High variation for sparkle effect
-    );
-
-    // ========================================================================
-    // NEW POWDERS (81-85)
-    // ========================================================================
-
-    // Thermite Powder - burns extremely hot when ignited
-    materials_[static_cast<size_t>(MaterialID::Thermite_Powder)] = MaterialDef(
-        MaterialID::Thermite_Powder,
-        MaterialState::Powder,
-        4.5f,  // Heavy iron oxide powder
-        Color(139, 69, 19),  // Rusty brown
-        15
-    );
-
-    // Sugar - sweet powder, dissolves in water, highly flammable
-    materials_[static_cast<size_t>(MaterialID::Sugar)] = MaterialDef(
-        MaterialID::Sugar,
-        MaterialState::Powder,
-        1.55f,
-        Color(255, 250, 240),  // Off-white
-        5
-    );
-
-    // Iron Filings - metal shavings, rusts with water
-    materials_[static_cast<size_t>(MaterialID::Iron_Filings)] = MaterialDef(
-        MaterialID::Iron_Filings,
-        MaterialState::Powder,
-        7.8f,  // Dense iron
-        Color(70, 70, 75),  // Dark metallic gray
-        10
-    );
-
-    // Chalk - white powder for marking
-    materials_[static_cast<size_t>(MaterialID::Chalk)] = MaterialDef(
-        MaterialID::Chalk,
-        MaterialState::Powder,
-        2.7f,
-        Color(245, 245, 245),  // White
-        8
-    );
-
-    // Calcium - calcium powder, reactive with water (fizzes)
-    materials_[static_cast<size_t>(MaterialID::Calcium)] = MaterialDef(
-        MaterialID::Calcium,
-        MaterialState::Powder,
-        1.55f,
-        Color(230, 230, 210),  // Pale cream
-        10
-    );
-
-    // ========================================================================
-    // NEW LIQUIDS (86-90)
-    // ========================================================================
-
-    // Tar - very slow black sticky liquid, flammable
-    materials_[static_cast<size_t>(MaterialID::Tar)] = MaterialDef(
-        MaterialID::Tar,
-        MaterialState::Liquid,
-        1.2f,
-        Color(20, 15, 10),  // Almost black
-        5
-    );
-
-    // Juice - orange liquid, evaporates slowly
-    materials_[static_cast<size_t>(MaterialID::Juice)] = MaterialDef(
-        MaterialID::Juice,
-        MaterialState::Liquid,
-        1.05f,
-        Color(255, 165, 0),  // Orange
-        20
-    );
-
-    // Sap - tree sap, amber colored, can solidify
-    materials_[static_cast<size_t>(MaterialID::Sap)] = MaterialDef(
-        MaterialID::Sap,
-        MaterialState::Liquid,
-        1.3f,
-        Color(218, 165, 32),  // Amber/goldenrod
-        15
-    );
-
-    // Bleach - corrosive cleaning liquid, destroys organics
-    materials_[static_cast<size_t>(MaterialID::Bleach)] = MaterialDef(
-        MaterialID::Bleach,
-        MaterialState::Liquid,
-        1.1f,
-        Color(240, 255, 240),  // Very pale green-white
-        8
-    );
-
-    // Ink - dark liquid for staining
-    materials_[static_cast<size_t>(MaterialID::Ink)] = MaterialDef(
-        MaterialID::Ink,
-        MaterialState::Liquid,
-        1.0f,
-        Color(10, 10, 30),  // Very dark blue-black
-        5
-    );
-
-    // ========================================================================
-    // NEW GASES (91-93)
-    // ========================================================================
-
-    // Chlorine - toxic green gas, heavier than air (sinks!)
-    materials_[static_cast<size_t>(MaterialID::Chlorine)] = MaterialDef(
-        MaterialID::Chlorine,
-        MaterialState::Gas,
-        2.5f,  // Heavier than air - this gas sinks!
-        Color(144, 238, 144, 180),  // Light green, semi-transparent
-        20
-    );
-
-    // Liquid Nitrogen - freezing effect, rises as gas
-    materials_[static_cast<size_t>(MaterialID::Liquid_Nitrogen)] = MaterialDef(
-        MaterialID::Liquid_Nitrogen,
-        MaterialState::Gas,
-        0.08f,  // Very light
-        Color(200, 220, 255, 160),  // Pale blue, semi-transparent
-        15
-    );
-
-    // Oxygen - makes fires burn brighter, rises
-    materials_[static_cast<size_t>(MaterialID::Oxygen)] = MaterialDef(
-        MaterialID::Oxygen,
-        MaterialState::Gas,
-        0.09f,
-        Color(180, 200, 255, 120),  // Very pale blue, mostly transparent
-        10
-    );
-
-    // ========================================================================
-    // NEW SOLIDS (94-97)
-    // ========================================================================
-
-    // Concrete - strong building material
-    materials_[static_cast<size_t>(MaterialID::Concrete)] = MaterialDef(
-        MaterialID::Concrete,
-        MaterialState::Solid,
-        2.4f,
-        Color(128, 128, 128),  // Gray
-        12
-    );
-
-    // Titanium - strong silvery metal
-    materials_[static_cast<size_t>(MaterialID::Titanium)] = MaterialDef(
-        MaterialID::Titanium,
-        MaterialState::Solid,
-        4.5f,
-        Color(180, 185, 190),  // Silvery
-        8
-    );
-
-    // Clay - moldable material (solid until heated)
-    materials_[static_cast<size_t>(MaterialID::Clay)] = MaterialDef(
-        MaterialID::Clay,
-        MaterialState::Solid,
-        1.8f,
-        Color(165, 113, 78),  // Terracotta brown
-        15
-    );
-
-    // Charcoal - burnt wood, slow burning fuel
-    materials_[static_cast<size_t>(MaterialID::Charcoal)] = MaterialDef(
-        MaterialID::Charcoal,
-        MaterialState::Solid,
-        0.5f,  // Light like wood
-        Color(40, 35, 30),  // Very dark gray
-        10
-    );
-
-    // ========================================================================
-    // NEW ORGANIC (98-100)
-    // ========================================================================
-
-    // Bamboo - fast-growing plant material
-    materials_[static_cast<size_t>(MaterialID::Bamboo)] = MaterialDef(
-        MaterialID::Bamboo,
-        MaterialState::Solid,
-        0.7f,
-        Color(144, 190, 109),  // Light green
-        20
-    );
-
-    // Honeycomb - solid wax structure
-    materials_[static_cast<size_t>(MaterialID::Honeycomb)] = MaterialDef(
-        MaterialID::Honeycomb,
-        MaterialState::Solid,
-        0.9f,
-        Color(255, 200, 60),  // Golden yellow
-        15
-    );
-
-    // Bone - skeletal remains
-    materials_[static_cast<size_t>(MaterialID::Bone)] = MaterialDef(
-        MaterialID::Bone,
-        MaterialState::Solid,
-        1.9f,
-        Color(230, 220, 200),  // Off-white/ivory
-        12
-    );
-
-    // ========================================================================
-    // NEW SPECIAL (101-102)
-    // ========================================================================
-
-    // Napalm - sticky spreading fire
-    materials_[static_cast<size_t>(MaterialID::Napalm)] = MaterialDef(
-        MaterialID::Napalm,
-        MaterialState::Liquid,
-        0.9f,
-        Color(255, 100, 0),  // Bright orange
-        30
-    );
-
-    // Thermite - extremely hot burning compound (ignited form)
-    materials_[static_cast<size_t>(MaterialID::Thermite)] = MaterialDef(
-        MaterialID::Thermite,
-        MaterialState::Liquid,  // Molten when burning
-        7.0f,  // Heavy molten iron
-        Color(255, 255, 200),  // Blindingly bright white-yellow
-        40
-    );
-
-    // ========================================================================
-    // EXPANSION: BASIC (103-112)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Bedrock)] = MaterialDef(
-        MaterialID::Bedrock, MaterialState::Solid, 1000.0f,
-        Color(30, 30, 35), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Ceramic)] = MaterialDef(
-        MaterialID::Ceramic, MaterialState::Solid, 2.5f,
-        Color(210, 180, 140), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Granite)] = MaterialDef(
-        MaterialID::Granite, MaterialState::Solid, 2.7f,
-        Color(130, 120, 110), 25
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Marble)] = MaterialDef(
-        MaterialID::Marble, MaterialState::Solid, 2.7f,
-        Color(240, 240, 245), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Sandstone)] = MaterialDef(
-        MaterialID::Sandstone, MaterialState::Solid, 2.3f,
-        Color(210, 180, 140), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Limestone)] = MaterialDef(
-        MaterialID::Limestone, MaterialState::Solid, 2.5f,
-        Color(220, 215, 200), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Slate)] = MaterialDef(
-        MaterialID::Slate, MaterialState::Solid, 2.8f,
-        Color(80, 85, 90), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Basalt)] = MaterialDef(
-        MaterialID::Basalt, MaterialState::Solid, 3.0f,
-        Color(50, 50, 55), 8
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Quartz_Block)] = MaterialDef(
-        MaterialID::Quartz_Block, MaterialState::Solid, 2.6f,
-        Color(250, 245, 250), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Soil)] = MaterialDef(
-        MaterialID::Soil, MaterialState::Solid, 1.5f,
-        Color(90, 60, 40), 20
-    );
-
-    // ========================================================================
-    // EXPANSION: POWDERS (113-117)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Flour)] = MaterialDef(
-        MaterialID::Flour, MaterialState::Powder, 0.6f,
-        Color(250, 245, 230), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Sulfur)] = MaterialDef(
-        MaterialID::Sulfur, MaterialState::Powder, 2.0f,
-        Color(230, 220, 50), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Cement)] = MaterialDef(
-        MaterialID::Cement, MaterialState::Powder, 1.5f,
-        Color(160, 160, 155), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Fertilizer)] = MaterialDef(
-        MaterialID::Fertilizer, MaterialState::Powder, 1.2f,
-        Color(80, 50, 30), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Volcanic_Ash)] = MaterialDef(
-        MaterialID::Volcanic_Ash, MaterialState::Powder, 1.4f,
-        Color(70, 65, 60), 12
-    );
-
-    // ========================================================================
-    // EXPANSION: LIQUIDS (118-122)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Brine)] = MaterialDef(
-        MaterialID::Brine, MaterialState::Liquid, 1.03f,
-        Color(100, 150, 180), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Coffee)] = MaterialDef(
-        MaterialID::Coffee, MaterialState::Liquid, 1.0f,
-        Color(70, 45, 25), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Soap)] = MaterialDef(
-        MaterialID::Soap, MaterialState::Liquid, 0.95f,
-        Color(200, 220, 255), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Paint)] = MaterialDef(
-        MaterialID::Paint, MaterialState::Liquid, 1.3f,
-        Color(200, 50, 50), 40  // High variance for multi-color
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Sewage)] = MaterialDef(
-        MaterialID::Sewage, MaterialState::Liquid, 1.05f,
-        Color(80, 70, 50), 15
-    );
-
-    // ========================================================================
-    // EXPANSION: GASES (123-129)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Ammonia)] = MaterialDef(
-        MaterialID::Ammonia, MaterialState::Gas, 0.6f,
-        Color(200, 255, 200, 140), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Carbon_Dioxide)] = MaterialDef(
-        MaterialID::Carbon_Dioxide, MaterialState::Gas, 1.5f,  // Heavier than air
-        Color(180, 180, 180, 100), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Nitrous)] = MaterialDef(
-        MaterialID::Nitrous, MaterialState::Gas, 0.5f,
-        Color(200, 200, 255, 120), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Steam_Hot)] = MaterialDef(
-        MaterialID::Steam_Hot, MaterialState::Gas, 0.05f,
-        Color(255, 255, 255, 160), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Miasma)] = MaterialDef(
-        MaterialID::Miasma, MaterialState::Gas, 0.8f,
-        Color(100, 80, 60, 150), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Pheromone)] = MaterialDef(
-        MaterialID::Pheromone, MaterialState::Gas, 0.3f,
-        Color(255, 200, 220, 100), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Nerve_Gas)] = MaterialDef(
-        MaterialID::Nerve_Gas, MaterialState::Gas, 1.2f,
-        Color(180, 255, 180, 130), 15
-    );
-
-    // ========================================================================
-    // EXPANSION: SOLIDS (130-136)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Silver)] = MaterialDef(
-        MaterialID::Silver, MaterialState::Solid, 10.5f,
-        Color(192, 192, 200), 8
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Platinum)] = MaterialDef(
-        MaterialID::Platinum, MaterialState::Solid, 21.5f,
-        Color(220, 220, 230), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Lead)] = MaterialDef(
-        MaterialID::Lead, MaterialState::Solid, 11.3f,
-        Color(90, 90, 100), 8
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Tin)] = MaterialDef(
-        MaterialID::Tin, MaterialState::Solid, 7.3f,
-        Color(180, 180, 175), 8
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Zinc)] = MaterialDef(
-        MaterialID::Zinc, MaterialState::Solid, 7.1f,
-        Color(160, 170, 180), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Bronze)] = MaterialDef(
-        MaterialID::Bronze, MaterialState::Solid, 8.7f,
-        Color(180, 130, 70), 12
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Steel)] = MaterialDef(
-        MaterialID::Steel, MaterialState::Solid, 7.8f,
-        Color(140, 145, 150), 8
-    );
-
-    // ========================================================================
-    // EXPANSION: ORGANIC (137-143)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Pollen)] = MaterialDef(
-        MaterialID::Pollen, MaterialState::Powder, 0.3f,
-        Color(255, 220, 80), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Root)] = MaterialDef(
-        MaterialID::Root, MaterialState::Solid, 0.9f,
-        Color(120, 80, 50), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Bark)] = MaterialDef(
-        MaterialID::Bark, MaterialState::Solid, 0.7f,
-        Color(100, 70, 45), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Fruit)] = MaterialDef(
-        MaterialID::Fruit, MaterialState::Solid, 0.9f,
-        Color(255, 80, 80), 30
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Egg)] = MaterialDef(
-        MaterialID::Egg, MaterialState::Solid, 1.0f,
-        Color(250, 245, 230), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Web)] = MaterialDef(
-        MaterialID::Web, MaterialState::Solid, 0.1f,
-        Color(240, 240, 245, 200), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Mucus)] = MaterialDef(
-        MaterialID::Mucus, MaterialState::Liquid, 1.1f,
-        Color(180, 220, 150, 200), 15
-    );
-
-    // ========================================================================
-    // EXPANSION: SPECIAL (144-151)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Bomb)] = MaterialDef(
-        MaterialID::Bomb, MaterialState::Solid, 3.0f,
-        Color(50, 50, 50), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Nuke)] = MaterialDef(
-        MaterialID::Nuke, MaterialState::Solid, 15.0f,
-        Color(40, 60, 40), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Laser)] = MaterialDef(
-        MaterialID::Laser, MaterialState::Gas, 0.0f,
-        Color(255, 0, 0), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Black_Hole)] = MaterialDef(
-        MaterialID::Black_Hole, MaterialState::Solid, 1000.0f,
-        Color(10, 0, 20), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::White_Hole)] = MaterialDef(
-        MaterialID::White_Hole, MaterialState::Solid, 0.0f,
-        Color(255, 255, 255), 5
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Acid_Gas)] = MaterialDef(
-        MaterialID::Acid_Gas, MaterialState::Gas, 1.1f,
-        Color(150, 255, 100, 150), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Ice_Bomb)] = MaterialDef(
-        MaterialID::Ice_Bomb, MaterialState::Solid, 2.0f,
-        Color(150, 200, 255), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Fire_Bomb)] = MaterialDef(
-        MaterialID::Fire_Bomb, MaterialState::Solid, 2.0f,
-        Color(255, 100, 50), 15
-    );
-
-    // ========================================================================
-    // EXPANSION: FANTASY (152-161)
-    // ========================================================================
-
-    materials_[static_cast<size_t>(MaterialID::Mana)] = MaterialDef(
-        MaterialID::Mana, MaterialState::Liquid, 0.5f,
-        Color(100, 150, 255), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Mirage)] = MaterialDef(
-        MaterialID::Mirage, MaterialState::Gas, 0.01f,
-        Color(255, 220, 180, 80), 30
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Holy_Water)] = MaterialDef(
-        MaterialID::Holy_Water, MaterialState::Liquid, 1.0f,
-        Color(220, 240, 255), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Cursed)] = MaterialDef(
-        MaterialID::Cursed, MaterialState::Solid, 2.0f,
-        Color(50, 20, 60), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Blessed)] = MaterialDef(
-        MaterialID::Blessed, MaterialState::Solid, 1.0f,
-        Color(255, 250, 200), 10
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Soul)] = MaterialDef(
-        MaterialID::Soul, MaterialState::Gas, 0.1f,
-        Color(200, 220, 255, 120), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Spirit)] = MaterialDef(
-        MaterialID::Spirit, MaterialState::Gas, 0.05f,
-        Color(180, 200, 255, 100), 25
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Aether)] = MaterialDef(
-        MaterialID::Aether, MaterialState::Gas, 0.01f,
-        Color(255, 255, 200, 80), 15
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Nether)] = MaterialDef(
-        MaterialID::Nether, MaterialState::Gas, 2.0f,  // Sinks
-        Color(80, 20, 100, 150), 20
-    );
-
-    materials_[static_cast<size_t>(MaterialID::Phoenix_Ash)] = MaterialDef(
-        MaterialID::Phoenix_Ash, MaterialState::Powder, 0.5f,
-        Color(255, 150, 50), 25
-    );
 }
 
 Color MaterialSystem::get_material_color(MaterialID id) {
-    const auto& mat = materials_[static_cast<size_t>(id)];
-    return mat.get_color(rng_);
+    return get_material(id).get_color(rng_);
 }
 
 // ============================================================================
@@ -1930,44 +623,18 @@ static const MaterialCombination COMBINATIONS[] = {
     {MaterialID::Vine, MaterialID::Seed, MaterialID::Bamboo, MaterialID::Empty, 48},
 };
 
-static const int NUM_COMBINATIONS = sizeof(COMBINATIONS) / sizeof(COMBINATIONS[0]);
-
-// ============================================================================
-// DISCOVERY SYSTEM INTEGRATION
-// ============================================================================
-// Callback for Story Mode discovery tracking
-// When a combination occurs, this notifies the discovery system
-
-using CombinationCallback = void(*)(MaterialID mat_a, MaterialID mat_b,
-                                     MaterialID result_a, MaterialID result_b,
-                                     uint32_t frame_number);
-
-static CombinationCallback g_combination_callback = nullptr;
-static bool g_story_mode_active = false;
-static uint32_t g_current_frame = 0;
-
-// Check if material is unlocked (for story mode)
-using MaterialUnlockChecker = bool(*)(MaterialID);
-static MaterialUnlockChecker g_material_unlocked_checker = nullptr;
-
-} // namespace Materials
-
-// Public API for setting discovery callbacks from main.cpp
-void set_discovery_callback(Materials::CombinationCallback callback) {
-    Materials::g_combination_callback = callback;
-}
+static const int NUM_COMBINATIONS = sizeof(COMBINATIONS) / sizeof(COMBINATIONS[0]);
 
-void set_story_mode(bool active) {
-    Materials::g_story_mode_active = active;
-}
+// ============================================================================
+// DISCOVERY SYSTEM INTEGRATION
+// ============================================================================
+// Combinations are reported to the discovery system through the World's
+// discovery event queue (see EventQueue.h), never synchronously.
 
-void set_material_unlock_checker(Materials::MaterialUnlockChecker checker) {
-    Materials::g_material_unlocked_checker = checker;
-}
+static_assert(NUM_COMBINATIONS <= static_cast<int>(DiscoveryEventQueue::MAX_RECIPES),
+              "Discovery event dedupe bits must cover every recipe");
 
-void set_current_frame(uint32_t frame) {
-    Materials::g_current_frame = frame;
-}
+} // namespace Materials
 
 // Expose combination data for DiscoverySystem initialization
 const void* get_combinations_data() {
@@ -1992,44 +659,75 @@ CombinationInfo get_combination_by_index(int index) {
 namespace Materials {
 
 // ============================================================================
-// OPTIMIZED COMBINATION LOOKUP SYSTEM
+// COMPILED REACTION TABLE
 // ============================================================================
-// Uses O(1) hash lookup instead of O(n) iteration through all recipes.
-// This is critical for performance when handling 100k+ particles.
 
-// Max material ID for lookup table sizing
-static constexpr int MAX_MATERIAL_ID = 256;
+void ReactionTable::build(const std::bitset<256>* allowed) {
+    // Both orientations of every usable recipe, grouped by (self, other) in
+    // recipe order; Empty never reacts (the probe skips it)
+    struct Entry {
+        uint8_t self;
+        uint8_t other;
+        uint16_t recipe;
+        MaterialID self_result;
+        MaterialID other_result;
+        uint32_t chance;
+    };
+    std::vector<Entry> entries;
+    for (int i = 0; i < NUM_COMBINATIONS; i++) {
+        const MaterialCombination& combo = COMBINATIONS[i];
+        uint8_t a = static_cast<uint8_t>(combo.mat_a);
+        uint8_t b = static_cast<uint8_t>(combo.mat_b);
+        if (combo.mat_a == MaterialID::Empty || combo.mat_b == MaterialID::Empty) continue;
+        if (allowed && !(allowed->test(a) && allowed->test(b))) continue;
+
+        uint16_t recipe = static_cast<uint16_t>(i);
+        uint32_t chance = static_cast<uint32_t>(std::max(combo.chance, 1));
+        entries.push_back({a, b, recipe, combo.result_a, combo.result_b, chance});
+        if (a != b) {
+            entries.push_back({b, a, recipe, combo.result_b, combo.result_a, chance});
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& l, const Entry& r) {
+        return l.self != r.self ? l.self < r.self : l.other < r.other;
+    });
 
-// Lookup table: combo_lookup[mat_a][mat_b] = recipe index + 1 (0 = no recipe)
-// Using int16_t to save memory (65KB table instead of 256KB)
-static int16_t combo_lookup[MAX_MATERIAL_ID][MAX_MATERIAL_ID] = {};
+    rows_.fill(ReactionRow{});
+    pair_starts_.clear();
+    outcomes_.clear();
 
-// Bitset of materials that participate in any combination
-static bool has_combinations[MAX_MATERIAL_ID] = {};
+    // draw is a full 32-bit word: 1 in `chance` of them is 2^32 / chance
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const Entry& entry = entries[i];
+        bool new_row = i == 0 || entry.self != entries[i - 1].self;
+        bool new_pair = new_row || entry.other != entries[i - 1].other;
 
-// Initialize lookup tables once at startup
-static bool init_combination_lookup() {
-    // Build lookup table for O(1) recipe lookup
-    for (int i = 0; i < NUM_COMBINATIONS; i++) {
-        const MaterialCombination& combo = COMBINATIONS[i];
-        int a = static_cast<int>(combo.mat_a);
-        int b = static_cast<int>(combo.mat_b);
+        if (new_pair) {
+            ReactionRow& row = rows_[entry.self];
+            if (new_row) row.first_pair = static_cast<uint32_t>(pair_starts_.size());
+            row.partners[entry.other >> 6] |= uint64_t{1} << (entry.other & 63);
+            pair_starts_.push_back(static_cast<uint32_t>(outcomes_.size()));
+            cumulative = 0;
+        }
 
-        // Store recipe index + 1 (0 means no recipe)
-        // Note: if multiple recipes exist for same pair, last one wins
-        combo_lookup[a][b] = i + 1;
-        combo_lookup[b][a] = i + 1;  // Also store reverse for quick lookup
+        // Outcomes past certainty would never fire
+        if (cumulative >= (uint64_t{1} << 32)) continue;
+        cumulative += (uint64_t{1} << 32) / entry.chance;
+        uint32_t limit = static_cast<uint32_t>(std::min<uint64_t>(cumulative, uint64_t{1} << 32) - 1);
+        outcomes_.push_back({limit, entry.recipe, entry.self_result, entry.other_result});
+    }
+    pair_starts_.push_back(static_cast<uint32_t>(outcomes_.size()));
 
-        // Mark materials as having combinations
-        has_combinations[a] = true;
-        has_combinations[b] = true;
+    for (ReactionRow& row : rows_) {
+        uint8_t rank = 0;
+        for (int w = 0; w < 4; w++) {
+            row.word_rank[w] = rank;
+            rank = static_cast<uint8_t>(rank + std::popcount(row.partners[w]));
+        }
     }
-    return true;
 }
 
-// Static initialization - runs once at program start
-static bool combo_lookup_initialized = init_combination_lookup();
-
 // Helper to apply combination results and initialize special materials
 static inline void apply_combination_result(World& world, int32_t x, int32_t y, MaterialID result) {
     world.set_material(x, y, result);
@@ -2041,22 +739,64 @@ static inline void apply_combination_result(World& world, int32_t x, int32_t y,
     }
 }
 
+// Heat exposure for the melting / firing rules: while the temperature field
+// runs, 1 if the cell's sample reaches `threshold`; otherwise the number of
+// `hot` neighbours (each one used to roll its own chance)
+template <size_t N>
+static int heat_exposure(const World& world, int32_t x, int32_t y, int16_t threshold, const MaterialID (&hot)[N]) {
+    const TemperatureField& field = world.temperature_field();
+    if (field.is_enabled()) return field.sample(x, y) >= threshold ? 1 : 0;
+
+    int contacts = 0;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int nx = x + dx, ny = y + dy;
+            if (!world.in_bounds(nx, ny)) continue;
+            MaterialID m = world.get_material(nx, ny);
+            for (MaterialID h : hot) {
+                contacts += m == h;
+            }
+        }
+    }
+    return contacts;
+}
+
+// For random_tick(): true with the odds that make a rule act once per
+// `frames` frames on average (each cell is ticked once per
+// RANDOM_TICK_INTERVAL frames)
+static inline bool tick_chance(World& world, uint32_t frames) {
+    return world.random_below(frames) < RANDOM_TICK_INTERVAL;
+}
+
+// cos / sin of every whole degree (the angles the rules used to feed to
+// cosf / sinf per event), for throwing a cell in a random direction
+struct UnitDirection {
+    float dx;
+    float dy;
+};
+
+static const std::array<UnitDirection, 360> UNIT_DIRECTIONS = [] {
+    std::array<UnitDirection, 360> table{};
+    for (int degree = 0; degree < 360; degree++) {
+        float angle = degree * 3.14159f / 180.0f;
+        table[degree] = {cosf(angle), sinf(angle)};
+    }
+    return table;
+}();
+
+static inline const UnitDirection& random_direction(World& world) {
+    return UNIT_DIRECTIONS[world.random_below(360)];
+}
+
 // Check if a material at position (x, y) can combine with any neighbors
 // Returns true if a combination occurred
-// OPTIMIZED: Uses O(1) lookup instead of O(n) iteration
 static bool try_material_combination(World& world, int32_t x, int32_t y) {
     MaterialID my_mat = world.get_material(x, y);
-    if (my_mat == MaterialID::Empty) return false;
 
-    int my_mat_idx = static_cast<int>(my_mat);
-
-    // Fast early exit: if this material has no recipes, skip entirely
-    if (!has_combinations[my_mat_idx]) return false;
-
-    // In story mode, check if this material is unlocked
-    if (g_story_mode_active && g_material_unlocked_checker) {
-        if (!g_material_unlocked_checker(my_mat)) return false;
-    }
+    // Fast early exit: no (unlocked) recipes for this material, or Empty
+    const ReactionTable& reactions = world.reactions();
+    if (!reactions.has_reactions(my_mat)) return false;
+    const ReactionRow& row = reactions.row(my_mat);
 
     // Check all 8 neighbors
     for (int dy = -1; dy <= 1; dy++) {
@@ -2067,43 +807,20 @@ static bool try_material_combination(World& world, int32_t x, int32_t y) {
             if (!world.in_bounds(nx, ny)) continue;
 
             MaterialID neighbor_mat = world.get_material(nx, ny);
-            if (neighbor_mat == MaterialID::Empty) continue;
-
-            // In story mode, check if neighbor material is unlocked
-            if (g_story_mode_active && g_material_unlocked_checker) {
-                if (!g_material_unlocked_checker(neighbor_mat)) continue;
-            }
-
-            int neighbor_idx = static_cast<int>(neighbor_mat);
-
-            // O(1) lookup for recipe
-            int recipe_idx = combo_lookup[my_mat_idx][neighbor_idx];
-            if (recipe_idx == 0) continue;  // No recipe for this pair
-
-            const MaterialCombination& combo = COMBINATIONS[recipe_idx - 1];
+            if (!row.reacts_with(neighbor_mat)) continue;
 
-            // Random chance check
-            if ((world.random_int() % combo.chance) != 0) continue;
+            // One draw picks among the pair's recipes (or none)
+            const ReactionOutcome* outcome = reactions.roll(row, neighbor_mat, world.random_int());
+            if (!outcome) continue;
 
-            // Determine if we matched forward (my_mat == mat_a) or reverse
-            bool forward = (my_mat == combo.mat_a);
-
-            // Notify discovery system BEFORE applying results
-            // This ensures the combination is recorded before material_spawn_callback fires
-            if (g_combination_callback) {
-                g_combination_callback(combo.mat_a, combo.mat_b,
-                                       combo.result_a, combo.result_b,
-                                       g_current_frame);
-            }
-
-            if (forward) {
-                apply_combination_result(world, x, y, combo.result_a);
-                apply_combination_result(world, nx, ny, combo.result_b);
-            } else {
-                apply_combination_result(world, x, y, combo.result_b);
-                apply_combination_result(world, nx, ny, combo.result_a);
+            // Queue the discovery BEFORE applying results so the drain sees
+            // the combination ahead of the spawn events it causes
+            if (world.discovery_events_enabled()) {
+                world.discovery_events().push_combination(outcome->recipe);
             }
 
+            apply_combination_result(world, x, y, outcome->self_result);
+            apply_combination_result(world, nx, ny, outcome->other_result);
             return true;
         }
     }
@@ -2954,7 +1671,7 @@ static bool is_passable(MaterialID m) {
 static int32_t find_ground_level(World& world, int32_t x, int32_t start_y) {
     // Start from a reasonable height and scan down
     int32_t scan_start = std::max(1, start_y);
-    for (int32_t y = scan_start; y < WORLD_HEIGHT - 1; y++) {
+    for (int32_t y = scan_start; y < world.get_height() - 1; y++) {
         if (world.in_bounds(x, y) && world.in_bounds(x, y + 1)) {
             MaterialID here = world.get_material(x, y);
             MaterialID below = world.get_material(x, y + 1);
@@ -2984,14 +1701,11 @@ static bool is_area_clear(World& world, int32_t x, int32_t y, int32_t width, int
     return true;
 }
 
-// Helper: Place a block of building material
+// Helper: Add a block of building material to the blueprint being recorded.
+// The block is placed later by the world's BuildJobQueue, if still open air.
 static void place_building_block(World& world, int32_t x, int32_t y, MaterialID material) {
     if (world.in_bounds(x, y)) {
-        MaterialID current = world.get_material(x, y);
-        if (current == MaterialID::Empty || current == MaterialID::Steam ||
-            current == MaterialID::Smoke) {
-            world.set_material(x, y, material);
-        }
+        world.build_jobs().record_block(x, y, material);
     }
 }
 
@@ -4686,12 +3400,20 @@ static bool try_build_structure(World& world, int32_t x, int32_t y, BuildingType
     int type_idx = static_cast<int>(type);
     const BuildingDimensions& dims = BUILDING_SIZES[type_idx];
 
-    // Check if area is clear for building
-    if (!is_area_clear(world, x, y, dims.width, dims.height)) {
+    // Check if area is clear for building (and not already claimed by a site
+    // still under construction)
+    if (!is_area_clear(world, x, y, dims.width, dims.height) ||
+        world.build_jobs().overlaps_site(x, y - dims.height + 1, x + dims.width - 1, y)) {
+        return false;
+    }
+
+    // Record the structure as a construction job; blocks appear over the
+    // next frames instead of all at once
+    BuildJobQueue& jobs = world.build_jobs();
+    if (!jobs.begin_job()) {
         return false;
     }
 
-    // Build the structure
     switch (type) {
         case BuildingType::Cottage:
             build_cottage(world, x, y, seed);
@@ -4817,9 +3539,9 @@ static bool try_build_structure(World& world, int32_t x, int32_t y, BuildingType
             build_sky_platform(world, x, y, seed);
             break;
         default:
-            return false;
+            break;
     }
-    return true;
+    return jobs.end_job();
 }
 
 // Choose a building type based on personality and random seed
@@ -4882,25 +3604,25 @@ static BuildingType choose_building_type(uint32_t seed, uint8_t personality) {
 
 // Main person update function - with village building behavior
 void update_person(World& world, int32_t x, int32_t y) {
-    Cell& cell = world.get_cell(x, y);
+    AgentTable& agents = world.agents();
+    AgentHandle agent = world.get_agent(x, y);
 
-    // Death check
-    if (cell.get_health() == 0) {
+    // Death check (a Person the agent table had no room for dies too)
+    if (agent == AgentTable::INVALID || agents.get_health(agent) == 0) {
         world.set_material(x, y, MaterialID::Smoke);
         world.get_cell(x, y).set_lifetime(15);
         return;
     }
 
     // Frame counter (0-63) for timing behaviors
-    uint8_t frame = cell.get_lifetime();
-    cell.set_lifetime((frame + 1) & 63);
+    uint8_t frame = agents.get_clock(agent);
+    agents.set_clock(agent, frame + 1);
 
-    // Get stable personality from health
-    uint8_t personality = cell.get_health();
-    (void)personality;  // Used for building seeds
+    // Stable personality, used for building seeds
+    uint8_t personality = agents.get_personality(agent);
 
     // Get facing direction
-    bool facing_right = cell.get_person_facing_right();
+    bool facing_right = agents.is_facing_right(agent);
 
     // ========================================
     // SIMPLIFIED GRAVITY & CLIMBING - Build when stuck!
@@ -4930,6 +3652,7 @@ void update_person(World& world, int32_t x, int32_t y) {
 
             if (wall_above) {
                 // Climb up
+                agents.set_state(agent, AgentState::Climbing);
                 world.try_move_cell(x, y, x, y - 1);
                 return;
             }
@@ -4942,6 +3665,7 @@ void update_person(World& world, int32_t x, int32_t y) {
         }
 
         // STUCK! Can't climb - build a structure here and drop down
+        agents.set_state(agent, AgentState::Falling);
         uint32_t stuck_seed = static_cast<uint32_t>(x * 31337 + y * 7919 + personality + frame);
         if ((frame & 7) == 0) {
             BuildingType building;
@@ -4963,6 +3687,7 @@ void update_person(World& world, int32_t x, int32_t y) {
 
     // Normal gravity if not touching walls
     if (!grounded && !touching_wall) {
+        agents.set_state(agent, AgentState::Falling);
         if (world.try_move_cell(x, y, x, y + 1)) {
             return;
         }
@@ -4988,11 +3713,12 @@ void update_person(World& world, int32_t x, int32_t y) {
 
             int build_y = find_ground_level(world, build_x, y - 30);
 
-            if (build_y > 0 && build_y < WORLD_HEIGHT - 30) {
+            if (build_y > 0 && build_y < world.get_height() - 30) {
                 BuildingType building = choose_building_type(build_seed >> 3, personality);
 
                 if (try_build_structure(world, build_x, build_y, building, build_seed)) {
-                    cell.set_person_facing_right(!facing_right);
+                    agents.set_state(agent, AgentState::Building);
+                    agents.set_facing_right(agent, !facing_right);
                     return;
                 }
             }
@@ -5043,6 +3769,7 @@ void update_person(World& world, int32_t x, int32_t y) {
                 for (int build_y = y - 1; build_y > bridge_height; build_y--) {
                     if (world.in_bounds(x, build_y) && world.get_material(x, build_y) == MaterialID::Empty) {
                         world.set_material(x, build_y, MaterialID::Wood);
+                        agents.set_state(agent, AgentState::Building);
                         // Move up onto the pillar
                         world.try_move_cell(x, y, x, build_y);
                         return;
@@ -5071,7 +3798,7 @@ void update_person(World& world, int32_t x, int32_t y) {
 
     // Bounds check
     if (!world.in_bounds(next_x, y)) {
-        cell.set_person_facing_right(!facing_right);
+        agents.set_facing_right(agent, !facing_right);
         return;
     }
 
@@ -5096,6 +3823,7 @@ void update_person(World& world, int32_t x, int32_t y) {
 
         if (has_ground_ahead) {
             // Safe to walk forward
+            agents.set_state(agent, AgentState::Walking);
             world.try_move_cell(x, y, next_x, y);
             return;
         }
@@ -5117,18 +3845,21 @@ void update_person(World& world, int32_t x, int32_t y) {
         else if (choice < 9) building = BuildingType::WatchTower;
         else building = BuildingType::BellTower;
 
-        try_build_structure(world, x, y, building, edge_seed);
+        if (try_build_structure(world, x, y, building, edge_seed)) {
+            agents.set_state(agent, AgentState::Building);
+        }
 
         // Always turn around at edge - don't try to bridge
-        cell.set_person_facing_right(!facing_right);
+        agents.set_facing_right(agent, !facing_right);
         return;
     }
 
     // ===== CASE 2: Blocked by another person - wait or go around =====
     if (ahead == MaterialID::Person) {
         // 50% chance to turn around, 50% chance to wait
+        agents.set_state(agent, AgentState::Idle);
         if ((frame & 4) != 0) {
-            cell.set_person_facing_right(!facing_right);
+            agents.set_facing_right(agent, !facing_right);
         }
         return;
     }
@@ -5147,6 +3878,7 @@ void update_person(World& world, int32_t x, int32_t y) {
             world.in_bounds(next_x, target_y + 1) &&
             is_person_ground(world.get_material(next_x, target_y + 1))) {
             if (world.try_move_cell(x, y, next_x, target_y)) {
+                agents.set_state(agent, AgentState::Climbing);
                 return;  // Stepped up!
             }
         }
@@ -5164,21 +3896,30 @@ void update_person(World& world, int32_t x, int32_t y) {
     else if (choice < 7) building = BuildingType::Apartment;
     else building = BuildingType::ClimbingWall;
 
-    try_build_structure(world, x, y, building, wall_seed);
+    if (try_build_structure(world, x, y, building, wall_seed)) {
+        agents.set_state(agent, AgentState::Building);
+    }
 
     // Turn around
-    cell.set_person_facing_right(!facing_right);
+    agents.set_facing_right(agent, !facing_right);
 }
 
 // ============================================================================
 // NEW MATERIAL UPDATE IMPLEMENTATIONS
 // ============================================================================
 
+// The generic_* helpers take their tuning as template arguments, so every
+// material that uses one gets its own kernel with the constants folded in
+// (velocity clamps, fall-loop bounds, lifetime and skip branches) instead
+// of reading them at runtime on every cell. `make bench` times them.
+
 // Helper: Generic powder behavior (like sand)
-static void generic_powder_update(World& world, int32_t x, int32_t y, int gravity = 2, int max_vel = 15) {
+template <int Gravity = 2, int MaxVelocity = 15>
+static void generic_powder_update(World& world, int32_t x, int32_t y) {
+    static_assert(Gravity > 0 && MaxVelocity > 0 && MaxVelocity <= 127, "powders fall");
     Cell& cell = world.get_cell(x, y);
-    cell.add_velocity(gravity);
-    cell.clamp_velocity(0, max_vel);
+    cell.add_velocity(Gravity);
+    cell.clamp_velocity(0, MaxVelocity);
 
     int target_y = y + cell.velocity_y;
     int best_y = y;
@@ -5209,11 +3950,149 @@ static void generic_powder_update(World& world, int32_t x, int32_t y, int gravit
     }
 }
 
+// Plain powders for Simulation's rest kernel. Each rule below is "optional
+// try_material_combination, neighbour triggers, then update_sand /
+// generic_powder_update"; keep this list in sync when one of them changes.
+// (Snow is left out: snow + snow = ice makes every grain reactive.)
+struct PlainPowderRule {
+    MaterialID material;
+    bool uses_combinations;      // Rule calls try_material_combination
+    MaterialID triggers[6];      // Neighbours that trigger the rule (Empty = end)
+};
+
+static const PlainPowderRule PLAIN_POWDERS[] = {
+    {MaterialID::Sand, true, {}},
+    {MaterialID::Dirt, true, {}},
+    {MaterialID::Gravel, false, {}},
+    {MaterialID::Rust, false, {}},
+    {MaterialID::Salt, true, {MaterialID::Water}},
+    {MaterialID::Sawdust, true, {MaterialID::Fire, MaterialID::Lava, MaterialID::Spark}},
+    {MaterialID::Glass_Powder, false, {MaterialID::Lava}},
+    {MaterialID::Iron_Filings, false, {MaterialID::Water, MaterialID::Blood, MaterialID::Acid}},
+    {MaterialID::Chalk, false, {MaterialID::Water, MaterialID::Acid}},
+    {MaterialID::Sulfur, false, {MaterialID::Fire, MaterialID::Lava}},
+    {MaterialID::Cement, false, {MaterialID::Water}},
+    {MaterialID::Gunpowder, false, {MaterialID::Fire, MaterialID::Spark, MaterialID::Lava,
+                                    MaterialID::Lightning}},
+    {MaterialID::Sugar, false, {MaterialID::Water, MaterialID::Juice, MaterialID::Fire,
+                                MaterialID::Spark, MaterialID::Lava, MaterialID::Ember}},
+    {MaterialID::Calcium, false, {MaterialID::Water}},
+    {MaterialID::Flour, false, {MaterialID::Fire, MaterialID::Lava, MaterialID::Spark,
+                                MaterialID::Ember}},
+    {MaterialID::Thermite_Powder, false, {MaterialID::Fire, MaterialID::Spark, MaterialID::Lava,
+                                          MaterialID::Dragon_Fire, MaterialID::Thermite,
+                                          MaterialID::Plasma}},
+};
+static_assert(sizeof(PLAIN_POWDERS) / sizeof(PLAIN_POWDERS[0]) <= 16,
+              "powder_bit is 16 bits wide");
+
+// Plain liquids for the rest kernel: "optional try_material_combination,
+// then fall / slide / spread" with no timers and no neighbour triggers.
+// LEVELED_LIQUIDS (Material.h) lists the same materials.
+// Sideways moves only ever enter Empty cells (World::can_move_to), at most
+// `reach` cells away; water tries 4 cells in its flow direction and flips
+// direction at random when stuck, so both sides count.
+struct PlainLiquidRule {
+    MaterialID material;
+    bool uses_combinations;  // Rule calls try_material_combination
+    uint8_t reach;           // Farthest sideways move
+};
+
+static const PlainLiquidRule PLAIN_LIQUIDS[] = {
+    {MaterialID::Water, true, 4},
+    {MaterialID::Oil, false, 1},
+    {MaterialID::Honey, true, 1},
+    {MaterialID::Blood, true, 1},
+    {MaterialID::Slime, false, 1},
+    {MaterialID::Ink, true, 1},
+    {MaterialID::Paint, false, 1},
+    {MaterialID::Mucus, false, 1},
+};
+static_assert(sizeof(PLAIN_LIQUIDS) / sizeof(PLAIN_LIQUIDS[0]) <= 16,
+              "liquid_bit is 16 bits wide");
+static_assert(static_cast<int>(MaterialID::COUNT) <= 254, "density ranks must fit 1-254");
+
+void build_rest_kernel_tables(const MaterialSystem& material_system, RestKernelTables& tables) {
+    tables.powder_bit.fill(0);
+    tables.reacts_with.fill(0);
+    tables.liquid_bit.fill(0);
+    tables.liquid_reacts_with.fill(0);
+    tables.liquid_reach.fill(0);
+    tables.move_rank.fill(0);
+    tables.sink_key.fill(255);  // Unknown ids behave like walls
+
+    // Rank distinct densities so that rank order == density order
+    const int count = static_cast<int>(MaterialID::COUNT);
+    std::vector<float> densities;
+    for (int id = 0; id < count; ++id) {
+        densities.push_back(material_system.get_material(static_cast<MaterialID>(id)).density);
+    }
+    std::sort(densities.begin(), densities.end());
+    densities.erase(std::unique(densities.begin(), densities.end()), densities.end());
+
+    for (int id = 0; id < count; ++id) {
+        const MaterialDef& def = material_system.get_material(static_cast<MaterialID>(id));
+        uint8_t rank = static_cast<uint8_t>(
+            1 + (std::lower_bound(densities.begin(), densities.end(), def.density) - densities.begin()));
+        tables.move_rank[id] = rank;
+
+        // Mirrors World::can_move_to for downward moves
+        if (id == static_cast<int>(MaterialID::Empty)) {
+            tables.sink_key[id] = 0;
+        } else if (def.state == MaterialState::Solid) {
+            tables.sink_key[id] = 255;
+        } else {
+            tables.sink_key[id] = rank;
+        }
+    }
+
+    // Every recipe: a Story Mode filter only ever removes reactions
+    ReactionTable reactions;
+    reactions.build();
+
+    int bit_index = 0;
+    for (const PlainPowderRule& rule : PLAIN_POWDERS) {
+        uint16_t bit = static_cast<uint16_t>(1u << bit_index++);
+        int self = static_cast<int>(rule.material);
+        tables.powder_bit[self] = bit;
+
+        for (MaterialID trigger : rule.triggers) {
+            if (trigger == MaterialID::Empty) break;
+            tables.reacts_with[static_cast<int>(trigger)] |= bit;
+        }
+        if (rule.uses_combinations) {
+            for (int other = 0; other < count; ++other) {
+                if (reactions.row(rule.material).reacts_with(static_cast<MaterialID>(other))) {
+                    tables.reacts_with[other] |= bit;
+                }
+            }
+        }
+    }
+
+    bit_index = 0;
+    for (const PlainLiquidRule& rule : PLAIN_LIQUIDS) {
+        uint16_t bit = static_cast<uint16_t>(1u << bit_index++);
+        int self = static_cast<int>(rule.material);
+        tables.liquid_bit[self] = bit;
+        tables.liquid_reach[self] = rule.reach;
+
+        if (rule.uses_combinations) {
+            for (int other = 0; other < count; ++other) {
+                if (reactions.row(rule.material).reacts_with(static_cast<MaterialID>(other))) {
+                    tables.liquid_reacts_with[other] |= bit;
+                }
+            }
+        }
+    }
+}
+
 // Helper: Generic gas behavior (rises)
-static void generic_gas_update(World& world, int32_t x, int32_t y, int rise_speed = -2, int max_vel = -15, bool has_lifetime = false) {
+template <int RiseSpeed = -2, int MaxVelocity = -15, bool HasLifetime = false>
+static void generic_gas_update(World& world, int32_t x, int32_t y) {
+    static_assert(RiseSpeed < 0 && MaxVelocity < 0 && MaxVelocity >= -128, "gases rise");
     Cell& cell = world.get_cell(x, y);
 
-    if (has_lifetime) {
+    if constexpr (HasLifetime) {
         cell.decrement_lifetime();
         if (cell.get_lifetime() == 0) {
             world.set_material(x, y, MaterialID::Empty);
@@ -5221,8 +4100,8 @@ static void generic_gas_update(World& world, int32_t x, int32_t y, int rise_spee
         }
     }
 
-    cell.add_velocity(rise_speed);
-    cell.clamp_velocity(max_vel, 2);
+    cell.add_velocity(RiseSpeed);
+    cell.clamp_velocity(MaxVelocity, 2);
 
     int target_y = y + cell.velocity_y;
     int best_y = y;
@@ -5268,9 +4147,13 @@ static void generic_gas_update(World& world, int32_t x, int32_t y, int rise_spee
     }
 }
 
-// Helper: Generic slow liquid behavior
-static void generic_slow_liquid_update(World& world, int32_t x, int32_t y, int skip_chance = 1) {
-    if ((world.random_int() & skip_chance) != 0) return;
+// Helper: Generic slow liquid behavior. SkipMask is ANDed with a random
+// word: the liquid moves on 1 in SkipMask + 1 frames when it is 2^n - 1.
+template <uint32_t SkipMask = 1>
+static void generic_slow_liquid_update(World& world, int32_t x, int32_t y) {
+    if constexpr (SkipMask != 0) {
+        if ((world.random_int() & SkipMask) != 0) return;
+    }
 
     if (world.try_move_cell(x, y, x, y + 1)) return;
 
@@ -5295,30 +4178,23 @@ static void generic_slow_liquid_update(World& world, int32_t x, int32_t y, int s
 void update_dirt(World& world, int32_t x, int32_t y) {
     // Check for material combinations (e.g., dirt + water = mud)
     if (try_material_combination(world, x, y)) return;
-    generic_powder_update(world, x, y, 2, 12);
+    generic_powder_update<2, 12>(world, x, y);
 }
 
 void update_gravel(World& world, int32_t x, int32_t y) {
-    generic_powder_update(world, x, y, 3, 18);  // Heavier, falls faster
+    generic_powder_update<3, 18>(world, x, y);  // Heavier, falls faster
 }
 
 void update_snow(World& world, int32_t x, int32_t y) {
     // Check for combinations (snow + snow = ice)
     if (try_material_combination(world, x, y)) return;
     // Snow melts near fire/lava
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            int nx = x + dx, ny = y + dy;
-            if (world.in_bounds(nx, ny)) {
-                MaterialID m = world.get_material(nx, ny);
-                if (m == MaterialID::Fire || m == MaterialID::Lava || m == MaterialID::Dragon_Fire) {
-                    world.set_material(x, y, MaterialID::Water);
-                    return;
-                }
-            }
-        }
+    static const MaterialID heat[] = {MaterialID::Fire, MaterialID::Lava, MaterialID::Dragon_Fire};
+    if (heat_exposure(world, x, y, TemperatureField::MELT_POINT, heat) > 0) {
+        world.set_material(x, y, MaterialID::Water);
+        return;
     }
-    generic_powder_update(world, x, y, 1, 8);  // Light and slow
+    generic_powder_update<1, 8>(world, x, y);  // Light and slow
 }
 
 void update_gunpowder(World& world, int32_t x, int32_t y) {
@@ -5351,7 +4227,7 @@ void update_gunpowder(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 2, 12);
+    generic_powder_update<2, 12>(world, x, y);
 }
 
 void update_salt(World& world, int32_t x, int32_t y) {
@@ -5371,7 +4247,7 @@ void update_salt(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 2, 14);
+    generic_powder_update<2, 14>(world, x, y);
 }
 
 void update_coal(World& world, int32_t x, int32_t y) {
@@ -5421,11 +4297,11 @@ void update_coal(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 2, 14);
+    generic_powder_update<2, 14>(world, x, y);
 }
 
 void update_rust(World& world, int32_t x, int32_t y) {
-    generic_powder_update(world, x, y, 2, 16);
+    generic_powder_update<2, 16>(world, x, y);
 }
 
 void update_sawdust(World& world, int32_t x, int32_t y) {
@@ -5445,7 +4321,7 @@ void update_sawdust(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 1, 10);  // Light powder
+    generic_powder_update<1, 10>(world, x, y);  // Light powder
 }
 
 void update_glass_powder(World& world, int32_t x, int32_t y) {
@@ -5463,7 +4339,7 @@ void update_glass_powder(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 2, 15);
+    generic_powder_update<2, 15>(world, x, y);
 }
 
 // ============================================================================
@@ -5473,7 +4349,7 @@ void update_glass_powder(World& world, int32_t x, int32_t y) {
 void update_honey(World& world, int32_t x, int32_t y) {
     // Check for combinations (honey + water = slime)
     if (try_material_combination(world, x, y)) return;
-    generic_slow_liquid_update(world, x, y, 3);  // Very slow
+    generic_slow_liquid_update<3>(world, x, y);  // Very slow
 }
 
 void update_mud(World& world, int32_t x, int32_t y) {
@@ -5493,14 +4369,14 @@ void update_mud(World& world, int32_t x, int32_t y) {
         world.set_material(x, y, MaterialID::Dirt);
         return;
     }
-    generic_slow_liquid_update(world, x, y, 1);
+    generic_slow_liquid_update<1>(world, x, y);
 }
 
 void update_blood(World& world, int32_t x, int32_t y) {
     // Check for combinations (blood + water = diluted)
     if (try_material_combination(world, x, y)) return;
     // Blood behaves like water but slower
-    generic_slow_liquid_update(world, x, y, 0);
+    generic_slow_liquid_update<0>(world, x, y);
 }
 
 void update_poison(World& world, int32_t x, int32_t y) {
@@ -5523,7 +4399,7 @@ void update_poison(World& world, int32_t x, int32_t y) {
 }
 
 void update_slime(World& world, int32_t x, int32_t y) {
-    generic_slow_liquid_update(world, x, y, 1);  // Thick and slow
+    generic_slow_liquid_update<1>(world, x, y);  // Thick and slow
 }
 
 void update_milk(World& world, int32_t x, int32_t y) {
@@ -5640,7 +4516,7 @@ void update_glue(World& world, int32_t x, int32_t y) {
         // Solidified - no longer moves
         return;
     }
-    generic_slow_liquid_update(world, x, y, 7);  // Extremely slow
+    generic_slow_liquid_update<7>(world, x, y);  // Extremely slow
 }
 
 // ============================================================================
@@ -5652,7 +4528,7 @@ void update_toxic_gas(World& world, int32_t x, int32_t y) {
     if (cell.get_lifetime() == 0) {
         cell.set_lifetime(60);
     }
-    generic_gas_update(world, x, y, -1, -12, true);
+    generic_gas_update<-1, -12, true>(world, x, y);
 }
 
 void update_hydrogen(World& world, int32_t x, int32_t y) {
@@ -5682,11 +4558,11 @@ void update_hydrogen(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_gas_update(world, x, y, -3, -20, false);  // Rises very fast
+    generic_gas_update<-3, -20, false>(world, x, y);  // Rises very fast
 }
 
 void update_helium(World& world, int32_t x, int32_t y) {
-    generic_gas_update(world, x, y, -3, -25, false);  // Rises even faster than hydrogen
+    generic_gas_update<-3, -25, false>(world, x, y);  // Rises even faster than hydrogen
 }
 
 void update_methane(World& world, int32_t x, int32_t y) {
@@ -5704,7 +4580,7 @@ void update_methane(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_gas_update(world, x, y, -2, -15, false);
+    generic_gas_update<-2, -15, false>(world, x, y);
 }
 
 void update_spark(World& world, int32_t x, int32_t y) {
@@ -5759,7 +4635,7 @@ void update_plasma(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -2, -15, false);
+    generic_gas_update<-2, -15, false>(world, x, y);
 }
 
 void update_dust(World& world, int32_t x, int32_t y) {
@@ -5767,7 +4643,7 @@ void update_dust(World& world, int32_t x, int32_t y) {
     if (cell.get_lifetime() == 0) {
         cell.set_lifetime(50);
     }
-    generic_gas_update(world, x, y, -1, -8, true);
+    generic_gas_update<-1, -8, true>(world, x, y);
 }
 
 void update_spore(World& world, int32_t x, int32_t y) {
@@ -5788,7 +4664,7 @@ void update_spore(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -10, true);
+    generic_gas_update<-1, -10, true>(world, x, y);
 }
 
 void update_confetti(World& world, int32_t x, int32_t y) {
@@ -5824,39 +4700,8 @@ void update_confetti(World& world, int32_t x, int32_t y) {
 // ============================================================================
 
 void update_metal(World& world, int32_t x, int32_t y) {
-    // Metal conducts electricity (spark/lightning)
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            int nx = x + dx, ny = y + dy;
-            if (world.in_bounds(nx, ny)) {
-                MaterialID m = world.get_material(nx, ny);
-                if (m == MaterialID::Lightning) {
-                    // Conduct to other metals
-                    for (int cy = -1; cy <= 1; cy++) {
-                        for (int cx = -1; cx <= 1; cx++) {
-                            int mx = x + cx, my = y + cy;
-                            if (world.in_bounds(mx, my) &&
-                                world.get_material(mx, my) == MaterialID::Metal &&
-                                (world.random_int() & 3) == 0) {
-                                // Create spark nearby
-                                for (int sy = -1; sy <= 1; sy++) {
-                                    for (int sx = -1; sx <= 1; sx++) {
-                                        int spx = mx + sx, spy = my + sy;
-                                        if (world.in_bounds(spx, spy) &&
-                                            world.get_material(spx, spy) == MaterialID::Empty) {
-                                            world.set_material(spx, spy, MaterialID::Spark);
-                                            world.get_cell(spx, spy).set_lifetime(5);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    // Static solid
+    // Static solid; conduction is handled per network by ConductorNetwork
+    (void)world; (void)x; (void)y;
 }
 
 void update_gold(World& world, int32_t x, int32_t y) {
@@ -5865,18 +4710,10 @@ void update_gold(World& world, int32_t x, int32_t y) {
 
 void update_ice(World& world, int32_t x, int32_t y) {
     // Ice melts near heat
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            int nx = x + dx, ny = y + dy;
-            if (world.in_bounds(nx, ny)) {
-                MaterialID m = world.get_material(nx, ny);
-                if (m == MaterialID::Fire || m == MaterialID::Lava ||
-                    m == MaterialID::Dragon_Fire || m == MaterialID::Plasma) {
-                    world.set_material(x, y, MaterialID::Water);
-                    return;
-                }
-            }
-        }
+    static const MaterialID heat[] = {MaterialID::Fire, MaterialID::Lava, MaterialID::Dragon_Fire,
+                                      MaterialID::Plasma};
+    if (heat_exposure(world, x, y, TemperatureField::MELT_POINT, heat) > 0) {
+        world.set_material(x, y, MaterialID::Water);
     }
 }
 
@@ -5974,19 +4811,7 @@ void update_moss(World& world, int32_t x, int32_t y) {
     // Check for combinations
     if (try_material_combination(world, x, y)) return;
 
-    // Moss spreads slowly on stone/brick/wood
-    if ((world.random_int() & 127) == 0) {
-        uint32_t dir = world.random_int() & 3;
-        int dx = (dir == 0) ? -1 : (dir == 1) ? 1 : 0;
-        int dy = (dir == 2) ? -1 : (dir == 3) ? 1 : 0;
-        int nx = x + dx, ny = y + dy;
-        if (world.in_bounds(nx, ny)) {
-            MaterialID m = world.get_material(nx, ny);
-            if (m == MaterialID::Stone || m == MaterialID::Brick || m == MaterialID::Wood) {
-                world.set_material(nx, ny, MaterialID::Moss);
-            }
-        }
-    }
+    // Spreading is a random tick (tick_moss)
     // Burns
     for (int dy = -1; dy <= 1; dy++) {
         for (int dx = -1; dx <= 1; dx++) {
@@ -6006,12 +4831,7 @@ void update_vine(World& world, int32_t x, int32_t y) {
     // Check for combinations
     if (try_material_combination(world, x, y)) return;
 
-    // Vines grow downward slowly
-    if ((world.random_int() & 63) == 0) {
-        if (world.in_bounds(x, y + 1) && world.get_material(x, y + 1) == MaterialID::Empty) {
-            world.set_material(x, y + 1, MaterialID::Vine);
-        }
-    }
+    // Growing is a random tick (tick_vine)
     // Burns
     for (int dy = -1; dy <= 1; dy++) {
         for (int dx = -1; dx <= 1; dx++) {
@@ -6031,28 +4851,7 @@ void update_fungus(World& world, int32_t x, int32_t y) {
     // Check for combinations
     if (try_material_combination(world, x, y)) return;
 
-    // Fungus spreads slowly and releases spores
-    if ((world.random_int() & 255) == 0) {
-        // Spread
-        uint32_t dir = world.random_int() & 3;
-        int dx = (dir == 0) ? -1 : (dir == 1) ? 1 : 0;
-        int dy = (dir == 2) ? -1 : (dir == 3) ? 1 : 0;
-        int nx = x + dx, ny = y + dy;
-        if (world.in_bounds(nx, ny)) {
-            MaterialID m = world.get_material(nx, ny);
-            if (m == MaterialID::Wood || m == MaterialID::Dirt ||
-                m == MaterialID::Grass || m == MaterialID::Flesh) {
-                world.set_material(nx, ny, MaterialID::Fungus);
-            }
-        }
-    }
-    // Release spores
-    if ((world.random_int() & 511) == 0) {
-        if (world.in_bounds(x, y - 1) && world.get_material(x, y - 1) == MaterialID::Empty) {
-            world.set_material(x, y - 1, MaterialID::Spore);
-            world.get_cell(x, y - 1).set_lifetime(40);
-        }
-    }
+    // Spreading and spores are random ticks (tick_fungus)
 }
 
 void update_seed(World& world, int32_t x, int32_t y) {
@@ -6125,47 +4924,17 @@ void update_coral(World& world, int32_t x, int32_t y) {
     // Check for combinations
     if (try_material_combination(world, x, y)) return;
 
-    // Coral grows slowly underwater
-    bool underwater = false;
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            int nx = x + dx, ny = y + dy;
-            if (world.in_bounds(nx, ny) && world.get_material(nx, ny) == MaterialID::Water) {
-                underwater = true;
-                break;
-            }
-        }
-        if (underwater) break;
-    }
-
-    if (underwater && (world.random_int() & 511) == 0) {
-        uint32_t dir = world.random_int() & 3;
-        int dx = (dir == 0) ? -1 : (dir == 1) ? 1 : 0;
-        int dy = (dir == 2) ? -1 : 0;  // Coral grows up and sideways
-        int nx = x + dx, ny = y + dy;
-        if (world.in_bounds(nx, ny) && world.get_material(nx, ny) == MaterialID::Water) {
-            world.set_material(nx, ny, MaterialID::Coral);
-        }
-    }
+    // Growing is a random tick (tick_coral)
 }
 
 void update_wax(World& world, int32_t x, int32_t y) {
     // Check for combinations
     if (try_material_combination(world, x, y)) return;
 
-    // Wax melts near fire
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            int nx = x + dx, ny = y + dy;
-            if (world.in_bounds(nx, ny)) {
-                MaterialID m = world.get_material(nx, ny);
-                if (m == MaterialID::Fire || m == MaterialID::Lava) {
-                    // Melt into a slow liquid
-                    world.set_material(x, y, MaterialID::Oil);  // Melted wax acts like oil
-                    return;
-                }
-            }
-        }
+    // Wax melts near fire into a slow liquid (melted wax acts like oil)
+    static const MaterialID heat[] = {MaterialID::Fire, MaterialID::Lava};
+    if (heat_exposure(world, x, y, TemperatureField::MELT_POINT, heat) > 0) {
+        world.set_material(x, y, MaterialID::Oil);
     }
 }
 
@@ -6287,31 +5056,7 @@ void update_tnt(World& world, int32_t x, int32_t y) {
                 MaterialID m = world.get_material(nx, ny);
                 if (m == MaterialID::Fire || m == MaterialID::Spark ||
                     m == MaterialID::Lava || m == MaterialID::Lightning) {
-                    // EXPLOSION!
-                    int radius = 8;
-                    for (int ey = -radius; ey <= radius; ey++) {
-                        for (int ex = -radius; ex <= radius; ex++) {
-                            if (ex * ex + ey * ey <= radius * radius) {
-                                int fx = x + ex, fy = y + ey;
-                                if (world.in_bounds(fx, fy)) {
-                                    MaterialID fm = world.get_material(fx, fy);
-                                    if (fm != MaterialID::Obsidian && fm != MaterialID::Diamond &&
-                                        fm != MaterialID::Void) {
-                                        if ((ex * ex + ey * ey) > radius * radius / 2) {
-                                            // Outer ring becomes fire
-                                            if (fm != MaterialID::Stone) {
-                                                world.set_material(fx, fy, MaterialID::Fire);
-                                                world.get_cell(fx, fy).set_lifetime(15);
-                                            }
-                                        } else {
-                                            // Inner area destroyed
-                                            world.set_material(fx, fy, MaterialID::Empty);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
+                    Explosions::detonate(world, x, y, BlastType::TNT);
                     return;
                 }
             }
@@ -6328,29 +5073,7 @@ void update_c4(World& world, int32_t x, int32_t y) {
                 MaterialID m = world.get_material(nx, ny);
                 if (m == MaterialID::Fire || m == MaterialID::Spark ||
                     m == MaterialID::Lava || m == MaterialID::Lightning) {
-                    // BIGGER EXPLOSION!
-                    int radius = 15;
-                    for (int ey = -radius; ey <= radius; ey++) {
-                        for (int ex = -radius; ex <= radius; ex++) {
-                            if (ex * ex + ey * ey <= radius * radius) {
-                                int fx = x + ex, fy = y + ey;
-                                if (world.in_bounds(fx, fy)) {
-                                    MaterialID fm = world.get_material(fx, fy);
-                                    if (fm != MaterialID::Obsidian && fm != MaterialID::Diamond &&
-                                        fm != MaterialID::Void) {
-                                        if ((ex * ex + ey * ey) > radius * radius * 3 / 4) {
-                                            if (fm != MaterialID::Stone) {
-                                                world.set_material(fx, fy, MaterialID::Fire);
-                                                world.get_cell(fx, fy).set_lifetime(20);
-                                            }
-                                        } else {
-                                            world.set_material(fx, fy, MaterialID::Empty);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
+                    Explosions::detonate(world, x, y, BlastType::C4);
                     return;
                 }
             }
@@ -6379,20 +5102,7 @@ void update_firework(World& world, int32_t x, int32_t y) {
 
         if (cell.get_lifetime() == 0) {
             // EXPLODE into confetti!
-            int radius = 6;
-            for (int ey = -radius; ey <= radius; ey++) {
-                for (int ex = -radius; ex <= radius; ex++) {
-                    if (ex * ex + ey * ey <= radius * radius) {
-                        int fx = x + ex, fy = y + ey;
-                        if (world.in_bounds(fx, fy) &&
-                            world.get_material(fx, fy) == MaterialID::Empty &&
-                            (world.random_int() & 3) == 0) {
-                            world.set_material(fx, fy, MaterialID::Confetti);
-                            world.get_cell(fx, fy).set_lifetime(50 + (world.random_int() & 31));
-                        }
-                    }
-                }
-            }
+            Explosions::detonate(world, x, y, BlastType::Firework);
             world.set_material(x, y, MaterialID::Fire);
             world.get_cell(x, y).set_lifetime(15);
         }
@@ -6432,8 +5142,13 @@ void update_lightning(World& world, int32_t x, int32_t y) {
             int nx = x + dx, ny = y + dy;
             if (world.in_bounds(nx, ny)) {
                 MaterialID m = world.get_material(nx, ny);
+                if (ConductorNetwork::is_conductor(m)) {
+                    // Charge the whole circuit; it sparks after the cell pass
+                    world.conductors().energize(nx, ny);
+                    continue;
+                }
                 if (m != MaterialID::Empty && m != MaterialID::Lightning &&
-                    m != MaterialID::Metal && m != MaterialID::Stone &&
+                    m != MaterialID::Stone &&
                     m != MaterialID::Obsidian && m != MaterialID::Diamond &&
                     (world.random_int() & 3) == 0) {
                     world.set_material(nx, ny, MaterialID::Fire);
@@ -6456,41 +5171,12 @@ void update_lightning(World& world, int32_t x, int32_t y) {
 }
 
 void update_portal_in(World& world, int32_t x, int32_t y) {
-    // Portal_In teleports materials touching it to Portal_Out
-    // PERFORMANCE FIX: Use static cache with periodic refresh
-    static int portal_out_x = -1, portal_out_y = -1;
-    static uint32_t last_scan_frame = 0;
-    static uint32_t scan_frame_counter = 0;
-
-    scan_frame_counter++;
-
-    // Check if cached portal is still valid
-    bool cache_valid = (portal_out_x >= 0 && portal_out_y >= 0 &&
-                        world.in_bounds(portal_out_x, portal_out_y) &&
-                        world.get_material(portal_out_x, portal_out_y) == MaterialID::Portal_Out);
-
-    // Re-scan if cache invalid and enough time has passed (every 30 frames = 0.5 sec)
-    if (!cache_valid && (scan_frame_counter - last_scan_frame > 30)) {
-        portal_out_x = -1;
-        portal_out_y = -1;
-        last_scan_frame = scan_frame_counter;
-
-        // Scan every cell but exit immediately when found
-        for (int sy = 0; sy < WORLD_HEIGHT; sy++) {
-            for (int sx = 0; sx < WORLD_WIDTH; sx++) {
-                if (world.get_material(sx, sy) == MaterialID::Portal_Out) {
-                    portal_out_x = sx;
-                    portal_out_y = sy;
-                    cache_valid = true;
-                    goto found_portal;  // Exit nested loops
-                }
-            }
-        }
-        found_portal:;
-    }
+    // Portal_In teleports materials touching it to a Portal_Out on the same channel
+    PortalRegistry& portals = world.portal_registry();
+    uint8_t channel = world.get_cell(x, y).get_lifetime();
 
-    // No valid portal out - nothing to do
-    if (portal_out_x < 0 || !cache_valid) return;
+    // No portal out on this channel - nothing to do
+    if (!portals.has_exit(channel)) return;
 
     // Only teleport every few frames to reduce load when many portals exist
     if ((world.random_int() & 1) != 0) return;  // 50% chance
@@ -6506,6 +5192,10 @@ void update_portal_in(World& world, int32_t x, int32_t y) {
             if (m == MaterialID::Empty || m == MaterialID::Portal_In ||
                 m == MaterialID::Portal_Out || m == MaterialID::Stone) continue;
 
+            // Spread arrivals over every exit cell of the channel
+            int32_t portal_out_x, portal_out_y;
+            portals.pick_exit(channel, world.random_int(), portal_out_x, portal_out_y);
+
             // Find empty spot near portal out
             for (int oy = -2; oy <= 2; oy++) {
                 for (int ox = -2; ox <= 2; ox++) {
@@ -6513,13 +5203,11 @@ void update_portal_in(World& world, int32_t x, int32_t y) {
                     if (!world.in_bounds(px, py)) continue;
                     if (world.get_material(px, py) != MaterialID::Empty) continue;
 
-                    // Teleport!
-                    Cell& src_cell = world.get_cell(nx, ny);
-                    world.set_material(px, py, m);
-                    Cell& dst_cell = world.get_cell(px, py);
-                    dst_cell.flags = src_cell.flags;
-                    dst_cell.velocity_y = src_cell.velocity_y;
-                    world.set_material(nx, ny, MaterialID::Empty);
+                    // Teleport! Swapping with the empty cell carries the whole
+                    // cell (and a Person's agent) across
+                    world.swap_cells(nx, ny, px, py);
+                    world.activate_region(nx, ny, nx, ny);
+                    world.activate_region(px, py, px, py);
                     return;
                 }
             }
@@ -6567,7 +5255,7 @@ void update_magic(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -12, true);
+    generic_gas_update<-1, -12, true>(world, x, y);
 }
 
 void update_crystal(World& world, int32_t x, int32_t y) {
@@ -6606,7 +5294,7 @@ void update_ectoplasm(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -8, true);
+    generic_gas_update<-1, -8, true>(world, x, y);
 }
 
 void update_antimatter(World& world, int32_t x, int32_t y) {
@@ -6631,7 +5319,7 @@ void update_antimatter(World& world, int32_t x, int32_t y) {
     }
 
     // Antimatter rises (negative density)
-    generic_gas_update(world, x, y, -2, -15, false);
+    generic_gas_update<-2, -15, false>(world, x, y);
 }
 
 void update_fairy_dust(World& world, int32_t x, int32_t y) {
@@ -6644,9 +5332,9 @@ void update_fairy_dust(World& world, int32_t x, int32_t y) {
             if (world.in_bounds(nx, ny) &&
                 world.get_material(nx, ny) == MaterialID::Person) {
                 // Heal the person
-                Cell& person = world.get_cell(nx, ny);
-                if (person.get_health() < 100) {
-                    person.set_health(std::min(100, person.get_health() + 20));
+                AgentHandle person = world.get_agent(nx, ny);
+                if (person != AgentTable::INVALID && world.agents().get_health(person) < 100) {
+                    world.agents().set_health(person, std::min(100, world.agents().get_health(person) + 20));
                 }
                 world.set_material(x, y, MaterialID::Empty);
                 return;
@@ -6704,7 +5392,7 @@ void update_dragon_fire(World& world, int32_t x, int32_t y) {
         return;
     }
 
-    generic_gas_update(world, x, y, -2, -15, false);
+    generic_gas_update<-2, -15, false>(world, x, y);
 }
 
 void update_frost(World& world, int32_t x, int32_t y) {
@@ -6737,7 +5425,7 @@ void update_frost(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -10, true);
+    generic_gas_update<-1, -10, true>(world, x, y);
 }
 
 void update_ember(World& world, int32_t x, int32_t y) {
@@ -6768,7 +5456,7 @@ void update_ember(World& world, int32_t x, int32_t y) {
         return;
     }
 
-    generic_powder_update(world, x, y, 1, 8);  // Falls slowly
+    generic_powder_update<1, 8>(world, x, y);  // Falls slowly
 }
 
 void update_stardust(World& world, int32_t x, int32_t y) {
@@ -6803,7 +5491,7 @@ void update_void_dust(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 1, 6);
+    generic_powder_update<1, 6>(world, x, y);
 }
 
 // Helper: Check if a location is safe for spawning a person
@@ -6833,17 +5521,8 @@ static bool is_safe_spawn_location(World& world, int32_t x, int32_t y) {
 
     // Check for nearby people - don't spawn if too crowded!
     // This prevents overlapping and gives people space
-    for (int dy = -4; dy <= 4; dy++) {
-        for (int dx = -4; dx <= 4; dx++) {
-            if (dx == 0 && dy == 0) continue;
-            int nx = x + dx, ny = y + dy;
-            if (world.in_bounds(nx, ny)) {
-                MaterialID m = world.get_material(nx, ny);
-                if (m == MaterialID::Person) {
-                    return false;  // Too close to another person!
-                }
-            }
-        }
+    if (world.agents().any_within(x, y, 4)) {
+        return false;  // Too close to another person!
     }
 
     // Check for nearby dangers (fire, lava, acid)
@@ -6898,12 +5577,16 @@ void update_life(World& world, int32_t x, int32_t y) {
         if (is_safe_spawn_location(world, x, y)) {
             // Transform into a Person!
             world.set_material(x, y, MaterialID::Person);
-            Cell& person = world.get_cell(x, y);
-            // Random health between 80-127 gives unique personality per person
-            // (health is used as personality seed, so each spawn is different)
-            person.set_health(80 + (world.random_int() & 47));
-            person.set_person_facing_right((world.random_int() & 1) != 0);
-            person.set_lifetime(0);  // Reset frame counter
+            AgentHandle person = world.get_agent(x, y);
+            // Random health between 80-127, which also seeds a unique
+            // personality per person
+            uint8_t health = static_cast<uint8_t>(80 + (world.random_int() & 47));
+            bool facing_right = (world.random_int() & 1) != 0;
+            if (person != AgentTable::INVALID) {
+                world.agents().set_health(person, health);
+                world.agents().set_personality(person, health);
+                world.agents().set_facing_right(person, facing_right);
+            }
 
             // Create a small sparkle effect around spawn point
             for (int i = 0; i < 3; i++) {
@@ -7025,7 +5708,7 @@ void update_thermite_powder(World& world, int32_t x, int32_t y) {
     }
 
     // Otherwise fall like normal powder
-    generic_powder_update(world, x, y, 3, 16);  // Heavy powder
+    generic_powder_update<3, 16>(world, x, y);  // Heavy powder
 }
 
 // Sugar - dissolves in water, highly flammable
@@ -7057,7 +5740,7 @@ void update_sugar(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 2, 12);
+    generic_powder_update<2, 12>(world, x, y);
 }
 
 // Iron Filings - rusts when wet, attracted to magnets (visual effect)
@@ -7079,7 +5762,7 @@ void update_iron_filings(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 4, 20);  // Heavy iron falls fast
+    generic_powder_update<4, 20>(world, x, y);  // Heavy iron falls fast
 }
 
 // Chalk - simple powder, dissolves slowly in water
@@ -7100,7 +5783,7 @@ void update_chalk(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 2, 12);
+    generic_powder_update<2, 12>(world, x, y);
 }
 
 // Calcium - reacts violently with water (fizzes, produces hydrogen)
@@ -7126,7 +5809,7 @@ void update_calcium(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 2, 12);
+    generic_powder_update<2, 12>(world, x, y);
 }
 
 // ============================================================================
@@ -7163,7 +5846,7 @@ void update_tar(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_slow_liquid_update(world, x, y, 7);  // Extremely slow like glue
+    generic_slow_liquid_update<7>(world, x, y);  // Extremely slow like glue
 }
 
 // Juice - evaporates slowly, attracts organic life
@@ -7176,7 +5859,7 @@ void update_juice(World& world, int32_t x, int32_t y) {
 
     // Standard liquid flow
     if (try_material_combination(world, x, y)) return;
-    generic_slow_liquid_update(world, x, y, 1);
+    generic_slow_liquid_update<1>(world, x, y);
 }
 
 // Sap - amber liquid, can solidify over time
@@ -7202,7 +5885,7 @@ void update_sap(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_slow_liquid_update(world, x, y, 3);  // Thick and slow
+    generic_slow_liquid_update<3>(world, x, y);  // Thick and slow
 }
 
 // Bleach - destroys organic materials, toxic
@@ -7240,14 +5923,14 @@ void update_bleach(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_slow_liquid_update(world, x, y, 1);
+    generic_slow_liquid_update<1>(world, x, y);
 }
 
 // Ink - stains surfaces, flows like water
 void update_ink(World& world, int32_t x, int32_t y) {
     // Just flows, nothing special
     if (try_material_combination(world, x, y)) return;
-    generic_slow_liquid_update(world, x, y, 0);  // Flows smoothly
+    generic_slow_liquid_update<0>(world, x, y);  // Flows smoothly
 }
 
 // ============================================================================
@@ -7354,7 +6037,7 @@ void update_liquid_nitrogen(World& world, int32_t x, int32_t y) {
     }
 
     // Rises quickly (very cold gas)
-    generic_gas_update(world, x, y, -3, -20, false);
+    generic_gas_update<-3, -20, false>(world, x, y);
 }
 
 // Oxygen - makes fires burn brighter and hotter
@@ -7412,7 +6095,7 @@ void update_oxygen(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -10, false);
+    generic_gas_update<-1, -10, false>(world, x, y);
 }
 
 // ============================================================================
@@ -7438,19 +6121,12 @@ void update_titanium(World& world, int32_t x, int32_t y) {
 // Clay - can be fired into brick by heat
 void update_clay(World& world, int32_t x, int32_t y) {
     // Check for heat sources - become brick
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            if (dx == 0 && dy == 0) continue;
-            if (!world.in_bounds(x + dx, y + dy)) continue;
-
-            MaterialID neighbor = world.get_material(x + dx, y + dy);
-            if (neighbor == MaterialID::Fire || neighbor == MaterialID::Lava ||
-                neighbor == MaterialID::Thermite || neighbor == MaterialID::Dragon_Fire) {
-                if ((world.random_int() & 15) == 0) {
-                    world.set_material(x, y, MaterialID::Brick);
-                    return;
-                }
-            }
+    static const MaterialID heat[] = {MaterialID::Fire, MaterialID::Lava, MaterialID::Thermite,
+                                      MaterialID::Dragon_Fire};
+    for (int i = heat_exposure(world, x, y, TemperatureField::KILN_POINT, heat); i > 0; i--) {
+        if ((world.random_int() & 15) == 0) {
+            world.set_material(x, y, MaterialID::Brick);
+            return;
         }
     }
 }
@@ -7532,50 +6208,24 @@ void update_bamboo(World& world, int32_t x, int32_t y) {
             if (neighbor == MaterialID::Fire || neighbor == MaterialID::Lava) {
                 world.set_material(x, y, MaterialID::Fire);
                 world.get_cell(x, y).set_lifetime(12);
-                return;
-            }
-        }
-    }
-
-    // Grow upward if near water
-    if ((world.random_int() & 255) == 0) {
-        bool has_water = false;
-        for (int dy = -2; dy <= 2; dy++) {
-            for (int dx = -2; dx <= 2; dx++) {
-                if (world.in_bounds(x + dx, y + dy) &&
-                    world.get_material(x + dx, y + dy) == MaterialID::Water) {
-                    has_water = true;
-                    break;
-                }
-            }
-            if (has_water) break;
-        }
-
-        if (has_water && world.in_bounds(x, y - 1) &&
-            world.get_material(x, y - 1) == MaterialID::Empty) {
-            world.set_material(x, y - 1, MaterialID::Bamboo);
-        }
-    }
-}
-
-// Honeycomb - melts into honey when heated
-void update_honeycomb(World& world, int32_t x, int32_t y) {
-    // Check for heat - melts into honey
-    for (int dy = -1; dy <= 1; dy++) {
-        for (int dx = -1; dx <= 1; dx++) {
-            if (dx == 0 && dy == 0) continue;
-            if (!world.in_bounds(x + dx, y + dy)) continue;
-
-            MaterialID neighbor = world.get_material(x + dx, y + dy);
-            if (neighbor == MaterialID::Fire || neighbor == MaterialID::Lava ||
-                neighbor == MaterialID::Thermite) {
-                if ((world.random_int() & 7) == 0) {
-                    world.set_material(x, y, MaterialID::Honey);
-                    return;
-                }
+                return;
             }
         }
     }
+
+    // Growing is a random tick (tick_bamboo)
+}
+
+// Honeycomb - melts into honey when heated
+void update_honeycomb(World& world, int32_t x, int32_t y) {
+    // Check for heat - melts into honey
+    static const MaterialID heat[] = {MaterialID::Fire, MaterialID::Lava, MaterialID::Thermite};
+    for (int i = heat_exposure(world, x, y, TemperatureField::MELT_POINT, heat); i > 0; i--) {
+        if ((world.random_int() & 7) == 0) {
+            world.set_material(x, y, MaterialID::Honey);
+            return;
+        }
+    }
 }
 
 // Bone - static, can be dissolved by acid
@@ -7771,7 +6421,7 @@ void update_granite(World& world, int32_t x, int32_t y) {
 
 void update_marble(World& world, int32_t x, int32_t y) {
     // Polished stone - dissolves slowly in acid
-    if ((world.random_int() % 200) == 0) {
+    if (world.random_one_in(200)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy) &&
@@ -7786,7 +6436,7 @@ void update_marble(World& world, int32_t x, int32_t y) {
 
 void update_sandstone(World& world, int32_t x, int32_t y) {
     // Compressed sand - erodes with water contact
-    if ((world.random_int() % 500) == 0) {
+    if (world.random_one_in(500)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy) &&
@@ -7801,7 +6451,7 @@ void update_sandstone(World& world, int32_t x, int32_t y) {
 
 void update_limestone(World& world, int32_t x, int32_t y) {
     // Calcium rock - dissolves in acid
-    if ((world.random_int() % 100) == 0) {
+    if (world.random_one_in(100)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy) &&
@@ -7836,12 +6486,12 @@ void update_soil(World& world, int32_t x, int32_t y) {
     if (!world.in_bounds(x, y + 1) ||
         world.get_material(x, y + 1) == MaterialID::Empty ||
         world.get_material(x, y + 1) == MaterialID::Water) {
-        generic_powder_update(world, x, y, 1, 8);
+        generic_powder_update<1, 8>(world, x, y);
         return;
     }
 
     // Grow grass on top if exposed to air
-    if ((world.random_int() % 1000) == 0 &&
+    if (world.random_one_in(1000) &&
         world.in_bounds(x, y - 1) &&
         world.get_material(x, y - 1) == MaterialID::Empty) {
         // Check if there's water nearby to grow
@@ -7896,7 +6546,7 @@ void update_flour(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 1, 8);
+    generic_powder_update<1, 8>(world, x, y);
 }
 
 void update_sulfur(World& world, int32_t x, int32_t y) {
@@ -7918,7 +6568,7 @@ void update_sulfur(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 2, 12);
+    generic_powder_update<2, 12>(world, x, y);
 }
 
 void update_cement(World& world, int32_t x, int32_t y) {
@@ -7934,33 +6584,12 @@ void update_cement(World& world, int32_t x, int32_t y) {
             }
         }
     }
-    generic_powder_update(world, x, y, 2, 14);
+    generic_powder_update<2, 14>(world, x, y);
 }
 
 void update_fertilizer(World& world, int32_t x, int32_t y) {
-    // Helps plants grow - accelerates nearby organic growth
-    if ((world.random_int() % 30) == 0) {
-        for (int dy = -2; dy <= 2; dy++) {
-            for (int dx = -2; dx <= 2; dx++) {
-                if (world.in_bounds(x + dx, y + dy)) {
-                    MaterialID neighbor = world.get_material(x + dx, y + dy);
-                    // Boost plant growth
-                    if (neighbor == MaterialID::Seed) {
-                        world.set_material(x + dx, y + dy, MaterialID::Vine);
-                        world.set_material(x, y, MaterialID::Empty);
-                        return;
-                    }
-                    if (neighbor == MaterialID::Grass && (world.random_int() % 20) == 0) {
-                        if (world.in_bounds(x + dx, y + dy - 1) &&
-                            world.get_material(x + dx, y + dy - 1) == MaterialID::Empty) {
-                            world.set_material(x + dx, y + dy - 1, MaterialID::Flower);
-                        }
-                    }
-                }
-            }
-        }
-    }
-    generic_powder_update(world, x, y, 2, 10);
+    // Boosting plants is a random tick (tick_fertilizer)
+    generic_powder_update<2, 10>(world, x, y);
 }
 
 void update_volcanic_ash(World& world, int32_t x, int32_t y) {
@@ -7986,14 +6615,14 @@ void update_volcanic_ash(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 1, 6);
+    generic_powder_update<1, 6>(world, x, y);
 }
 
 // === EXPANSION: LIQUIDS (118-122) ===
 
 void update_brine(World& world, int32_t x, int32_t y) {
     // Salt water - evaporates to leave salt
-    if ((world.random_int() % 2000) == 0) {
+    if (world.random_one_in(2000)) {
         world.set_material(x, y, MaterialID::Salt);
         return;
     }
@@ -8004,7 +6633,7 @@ void update_brine(World& world, int32_t x, int32_t y) {
     if (!world.try_move_cell(x, y, x + dir, y + 1)) {
         if (!world.try_move_cell(x, y, x - dir, y + 1)) {
             // Spread horizontally
-            int spread = 3 + (world.random_int() % 3);
+            int spread = 3 + world.random_below(3);
             bool moved = false;
             for (int i = 1; i <= spread && !moved; i++) {
                 if (world.try_move_cell(x, y, x + dir * i, y)) {
@@ -8020,7 +6649,7 @@ void update_brine(World& world, int32_t x, int32_t y) {
 
 void update_coffee(World& world, int32_t x, int32_t y) {
     // Brown liquid - stains things, evaporates slowly
-    if ((world.random_int() % 3000) == 0) {
+    if (world.random_one_in(3000)) {
         world.set_material(x, y, MaterialID::Steam);
         return;
     }
@@ -8048,7 +6677,7 @@ void update_coffee(World& world, int32_t x, int32_t y) {
 void update_soap(World& world, int32_t x, int32_t y) {
     // Bubbly cleaner - creates bubbles, floats on water
     // Chance to create bubble
-    if ((world.random_int() % 100) == 0 &&
+    if (world.random_one_in(100) &&
         world.in_bounds(x, y - 1) && world.get_material(x, y - 1) == MaterialID::Empty) {
         world.set_material(x, y - 1, MaterialID::Steam);  // Bubble effect
         world.get_cell(x, y - 1).set_lifetime(30);
@@ -8060,24 +6689,24 @@ void update_soap(World& world, int32_t x, int32_t y) {
         return;
     }
 
-    generic_slow_liquid_update(world, x, y, 1);
+    generic_slow_liquid_update<1>(world, x, y);
 }
 
 void update_paint(World& world, int32_t x, int32_t y) {
     // Colorful liquid - sticks to surfaces
-    generic_slow_liquid_update(world, x, y, 2);
+    generic_slow_liquid_update<2>(world, x, y);
 }
 
 void update_sewage(World& world, int32_t x, int32_t y) {
     // Gross waste - spawns miasma, kills plants
-    if ((world.random_int() % 200) == 0 &&
+    if (world.random_one_in(200) &&
         world.in_bounds(x, y - 1) && world.get_material(x, y - 1) == MaterialID::Empty) {
         world.set_material(x, y - 1, MaterialID::Miasma);
         world.get_cell(x, y - 1).set_lifetime(40);
     }
 
     // Kill nearby plants
-    if ((world.random_int() % 50) == 0) {
+    if (world.random_one_in(50)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy)) {
@@ -8091,7 +6720,7 @@ void update_sewage(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_slow_liquid_update(world, x, y, 1);
+    generic_slow_liquid_update<1>(world, x, y);
 }
 
 // === EXPANSION: GASES (123-129) ===
@@ -8112,7 +6741,7 @@ void update_ammonia(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -2, -15, true);
+    generic_gas_update<-2, -15, true>(world, x, y);
 }
 
 void update_carbon_dioxide(World& world, int32_t x, int32_t y) {
@@ -8149,14 +6778,14 @@ void update_carbon_dioxide(World& world, int32_t x, int32_t y) {
         if (cell.get_lifetime() == 0) {
             world.set_material(x, y, MaterialID::Empty);
         }
-    } else if ((world.random_int() % 500) == 0) {
+    } else if (world.random_one_in(500)) {
         world.set_material(x, y, MaterialID::Empty);
     }
 }
 
 void update_nitrous(World& world, int32_t x, int32_t y) {
     // Laughing gas - rises fast, harmless
-    generic_gas_update(world, x, y, -3, -20, true);
+    generic_gas_update<-3, -20, true>(world, x, y);
 }
 
 void update_steam_hot(World& world, int32_t x, int32_t y) {
@@ -8168,13 +6797,13 @@ void update_steam_hot(World& world, int32_t x, int32_t y) {
         for (int dx = -1; dx <= 1; dx++) {
             if (world.in_bounds(x + dx, y + dy)) {
                 MaterialID neighbor = world.get_material(x + dx, y + dy);
-                if (neighbor == MaterialID::Person || neighbor == MaterialID::Flesh) {
+                if (neighbor == MaterialID::Person) {
                     // Damage
-                    Cell& target = world.get_cell(x + dx, y + dy);
-                    target.damage_health(5);
+                    AgentHandle target = world.get_agent(x + dx, y + dy);
+                    if (target != AgentTable::INVALID) world.agents().damage_health(target, 5);
                 }
                 // Cook food
-                if (neighbor == MaterialID::Egg && (world.random_int() % 30) == 0) {
+                if (neighbor == MaterialID::Egg && world.random_one_in(30)) {
                     world.set_material(x + dx, y + dy, MaterialID::Flesh);  // Cooked egg
                 }
             }
@@ -8190,7 +6819,7 @@ void update_steam_hot(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -2, -15, false);
+    generic_gas_update<-2, -15, false>(world, x, y);
 }
 
 void update_miasma(World& world, int32_t x, int32_t y) {
@@ -8203,19 +6832,19 @@ void update_miasma(World& world, int32_t x, int32_t y) {
             if (world.in_bounds(x + dx, y + dy)) {
                 MaterialID neighbor = world.get_material(x + dx, y + dy);
                 if (neighbor == MaterialID::Person) {
-                    Cell& target = world.get_cell(x + dx, y + dy);
-                    target.damage_health(2);
+                    AgentHandle target = world.get_agent(x + dx, y + dy);
+                    if (target != AgentTable::INVALID) world.agents().damage_health(target, 2);
                 }
                 // Wilt plants
                 if ((neighbor == MaterialID::Flower || neighbor == MaterialID::Leaf) &&
-                    (world.random_int() % 20) == 0) {
+                    world.random_one_in(20)) {
                     world.set_material(x + dx, y + dy, MaterialID::Empty);
                 }
             }
         }
     }
 
-    generic_gas_update(world, x, y, -1, -8, true);
+    generic_gas_update<-1, -8, true>(world, x, y);
 }
 
 void update_pheromone(World& world, int32_t x, int32_t y) {
@@ -8229,12 +6858,12 @@ void update_pheromone(World& world, int32_t x, int32_t y) {
             world.set_material(x, y, MaterialID::Empty);
             return;
         }
-    } else if ((world.random_int() % 300) == 0) {
+    } else if (world.random_one_in(300)) {
         world.set_material(x, y, MaterialID::Empty);
         return;
     }
 
-    generic_gas_update(world, x, y, -1, -5, false);
+    generic_gas_update<-1, -5, false>(world, x, y);
 }
 
 void update_nerve_gas(World& world, int32_t x, int32_t y) {
@@ -8253,16 +6882,13 @@ void update_nerve_gas(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -10, true);
+    generic_gas_update<-1, -10, true>(world, x, y);
 }
 
 // === EXPANSION: SOLIDS (130-136) ===
 
 void update_silver(World& world, int32_t x, int32_t y) {
-    // Precious metal - tarnishes slowly
-    if ((world.random_int() % 10000) == 0) {
-        // Could add tarnish effect
-    }
+    // Precious metal - static solid (inert)
     (void)world; (void)x; (void)y;
 }
 
@@ -8288,7 +6914,7 @@ void update_zinc(World& world, int32_t x, int32_t y) {
             if (world.in_bounds(x + dx, y + dy) &&
                 world.get_material(x + dx, y + dy) == MaterialID::Acid) {
                 world.set_material(x + dx, y + dy, MaterialID::Hydrogen);
-                if ((world.random_int() % 10) == 0) {
+                if (world.random_one_in(10)) {
                     world.set_material(x, y, MaterialID::Empty);
                     return;
                 }
@@ -8304,7 +6930,7 @@ void update_bronze(World& world, int32_t x, int32_t y) {
 
 void update_steel(World& world, int32_t x, int32_t y) {
     // Iron-carbon alloy - rusts very slowly
-    if ((world.random_int() % 20000) == 0) {
+    if (world.random_one_in(20000)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy) &&
@@ -8327,7 +6953,7 @@ void update_pollen(World& world, int32_t x, int32_t y) {
     if (world.in_bounds(x, y + 1)) {
         MaterialID below = world.get_material(x, y + 1);
         if (below == MaterialID::Soil || below == MaterialID::Grass || below == MaterialID::Dirt) {
-            if ((world.random_int() % 10) == 0) {
+            if (world.random_one_in(10)) {
                 world.set_material(x, y, MaterialID::Flower);
                 return;
             }
@@ -8335,36 +6961,12 @@ void update_pollen(World& world, int32_t x, int32_t y) {
     }
 
     // Float like dust
-    generic_gas_update(world, x, y, -1, -5, true);
+    generic_gas_update<-1, -5, true>(world, x, y);
 }
 
 void update_root(World& world, int32_t x, int32_t y) {
-    // Underground plant - grows through soil, absorbs water
-    if ((world.random_int() % 100) == 0) {
-        // Grow downward through soil
-        int grow_dir = (world.random_int() % 3) - 1;  // -1, 0, or 1
-        int gx = x + grow_dir;
-        int gy = y + 1;
-
-        if (world.in_bounds(gx, gy)) {
-            MaterialID target = world.get_material(gx, gy);
-            if (target == MaterialID::Soil || target == MaterialID::Dirt) {
-                world.set_material(gx, gy, MaterialID::Root);
-            }
-        }
-
-        // Absorb nearby water
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                if (world.in_bounds(x + dx, y + dy) &&
-                    world.get_material(x + dx, y + dy) == MaterialID::Water) {
-                    world.set_material(x + dx, y + dy, MaterialID::Empty);
-                    // Could spawn something above ground
-                    break;
-                }
-            }
-        }
-    }
+    // Underground plant; growing and drinking are random ticks (tick_root)
+    (void)world; (void)x; (void)y;
 }
 
 void update_bark(World& world, int32_t x, int32_t y) {
@@ -8398,7 +7000,7 @@ void update_fruit(World& world, int32_t x, int32_t y) {
     }
 
     // Rot over time
-    if ((world.random_int() % 5000) == 0) {
+    if (world.random_one_in(5000)) {
         world.set_material(x, y, MaterialID::Mud);
     }
 }
@@ -8426,29 +7028,7 @@ void update_egg(World& world, int32_t x, int32_t y) {
         }
     }
 
-    // Incubate over time
-    if ((world.random_int() % 3000) == 0) {
-        // Check if warm
-        bool warm = false;
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                if (world.in_bounds(x + dx, y + dy)) {
-                    MaterialID neighbor = world.get_material(x + dx, y + dy);
-                    if (neighbor == MaterialID::Fire || neighbor == MaterialID::Lava ||
-                        neighbor == MaterialID::Steam_Hot) {
-                        warm = true;
-                        break;
-                    }
-                }
-            }
-            if (warm) break;
-        }
-        if (warm) {
-            // Hatch!
-            world.set_material(x, y, MaterialID::Person);
-            world.get_cell(x, y).set_health(50);
-        }
-    }
+    // Incubating is a random tick (tick_egg)
 }
 
 void update_web(World& world, int32_t x, int32_t y) {
@@ -8471,7 +7051,7 @@ void update_web(World& world, int32_t x, int32_t y) {
 
 void update_mucus(World& world, int32_t x, int32_t y) {
     // Biological slime - slow liquid
-    generic_slow_liquid_update(world, x, y, 4);
+    generic_slow_liquid_update<4>(world, x, y);
 }
 
 // === EXPANSION: SPECIAL (144-151) ===
@@ -8513,27 +7093,7 @@ void update_bomb(World& world, int32_t x, int32_t y) {
 
     if (detonate) {
         // Medium explosion
-        int radius = 8;
-        for (int ey = -radius; ey <= radius; ey++) {
-            for (int ex = -radius; ex <= radius; ex++) {
-                if (ex * ex + ey * ey <= radius * radius) {
-                    if (world.in_bounds(x + ex, y + ey)) {
-                        MaterialID m = world.get_material(x + ex, y + ey);
-                        if (m != MaterialID::Bedrock && m != MaterialID::Obsidian) {
-                            if (ex * ex + ey * ey <= (radius/2) * (radius/2)) {
-                                world.set_material(x + ex, y + ey, MaterialID::Fire);
-                                world.get_cell(x + ex, y + ey).set_lifetime(20);
-                            } else if ((world.random_int() % 2) == 0) {
-                                world.set_material(x + ex, y + ey, MaterialID::Smoke);
-                                world.get_cell(x + ex, y + ey).set_lifetime(30);
-                            } else {
-                                world.set_material(x + ex, y + ey, MaterialID::Empty);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        Explosions::detonate(world, x, y, BlastType::Bomb);
     }
 }
 
@@ -8562,31 +7122,7 @@ void update_nuke(World& world, int32_t x, int32_t y) {
 
     if (detonate) {
         // Massive explosion
-        int radius = 40;
-        for (int ey = -radius; ey <= radius; ey++) {
-            for (int ex = -radius; ex <= radius; ex++) {
-                if (ex * ex + ey * ey <= radius * radius) {
-                    if (world.in_bounds(x + ex, y + ey)) {
-                        MaterialID m = world.get_material(x + ex, y + ey);
-                        if (m != MaterialID::Bedrock) {
-                            int dist_sq = ex * ex + ey * ey;
-                            if (dist_sq <= (radius/3) * (radius/3)) {
-                                world.set_material(x + ex, y + ey, MaterialID::Plasma);
-                                world.get_cell(x + ex, y + ey).set_lifetime(40);
-                            } else if (dist_sq <= (radius/2) * (radius/2)) {
-                                world.set_material(x + ex, y + ey, MaterialID::Fire);
-                                world.get_cell(x + ex, y + ey).set_lifetime(30);
-                            } else if ((world.random_int() % 3) == 0) {
-                                world.set_material(x + ex, y + ey, MaterialID::Smoke);
-                                world.get_cell(x + ex, y + ey).set_lifetime(50);
-                            } else {
-                                world.set_material(x + ex, y + ey, MaterialID::Empty);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        Explosions::detonate(world, x, y, BlastType::Nuke);
     }
 }
 
@@ -8631,25 +7167,150 @@ void update_laser(World& world, int32_t x, int32_t y) {
     }
 }
 
+namespace {
+
+// Black hole zones (radii in cells)
+constexpr int BH_EVENT_HORIZON = 2;       // Schwarzschild radius - point of no return
+constexpr int BH_INNERMOST_ORBIT = 5;     // ISCO - innermost stable circular orbit (3x Schwarzschild)
+constexpr int BH_ACCRETION_DISK = 12;     // Visible accretion disk outer edge
+
+} // namespace
+
+void apply_black_hole_pull(World& world, int32_t px, int32_t py, int32_t dx, int32_t dy, uint32_t mass) {
+    const int innermost_orbit_sq = BH_INNERMOST_ORBIT * BH_INNERMOST_ORBIT;
+    const int accretion_disk_sq = BH_ACCRETION_DISK * BH_ACCRETION_DISK;
+    int dist_sq = dx * dx + dy * dy;
+
+    // Performance: Sparse sampling in outer regions
+    if (dist_sq > accretion_disk_sq && mass < 8) {
+        // Process only 1/8 of cells in outer region per hole cell
+        if ((world.random_int() & 7) >= mass) return;
+    }
+
+    if (!world.in_bounds(px, py)) return;
+    MaterialID m = world.get_material(px, py);
+
+    // Skip empty and immovable
+    if (m == MaterialID::Empty) return;
+    if (m == MaterialID::Black_Hole || m == MaterialID::White_Hole ||
+        m == MaterialID::Bedrock) return;
+
+    float dist = sqrtf((float)dist_sq);
+    float inv_dist = 1.0f / dist;
+
+    // === TIME DILATION ===
+    // Particles slow down as they approach event horizon
+    // Simulated by reducing move probability near the center
+    float time_factor = dist / BH_ACCRETION_DISK;  // 0 at center, 1 at disk edge
+    if (time_factor < 0.3f) time_factor = 0.3f;  // Cap minimum speed
+
+    // === GRAVITATIONAL STRENGTH ===
+    // Inverse square law: F = GM/r², M = number of merged hole cells
+    float gravity_strength = 500.0f * (float)mass / (float)dist_sq;
+    gravity_strength *= time_factor;  // Apply time dilation
+
+    int pull_chance = (int)(gravity_strength);
+    if (pull_chance < 1) pull_chance = 1;
+    if (pull_chance > 100) pull_chance = 100;
+
+    if ((int)world.random_below(100) >= pull_chance) return;
+
+    // === MOVEMENT CALCULATION ===
+    float norm_x = -dx * inv_dist;  // Unit vector toward black hole
+    float norm_y = -dy * inv_dist;
+    float tang_x = -norm_y;          // Tangent (perpendicular, counterclockwise)
+    float tang_y = norm_x;
+
+    float move_x_f, move_y_f;
+
+    if (dist_sq <= innermost_orbit_sq) {
+        // === INSIDE ISCO - Unstable, spiraling inward ===
+        // Matter here cannot maintain stable orbit, falls rapidly
+
+        // Strong radial pull with slight rotation
+        float spiral = 0.2f;
+        move_x_f = norm_x * 0.8f + tang_x * spiral;
+        move_y_f = norm_y * 0.8f + tang_y * spiral;
+
+        // === TIDAL FORCES / SPAGHETTIFICATION ===
+        // Differential gravity stretches objects radially
+        if (world.random_one_in(3)) {
+            // Stretch along radial direction (toward/away from BH)
+            int stretch_x = px + (int)(norm_x * 2);
+            int stretch_y = py + (int)(norm_y * 2);
+            if (world.in_bounds(stretch_x, stretch_y) &&
+                world.get_material(stretch_x, stretch_y) == MaterialID::Empty) {
+                // Clone particle along stretch direction (visual tidal effect)
+                world.set_material(stretch_x, stretch_y, m);
+            }
+        }
+
+    } else if (dist_sq <= accretion_disk_sq) {
+        // === ACCRETION DISK - Keplerian orbital motion ===
+        // Orbital velocity: v ∝ 1/√r (faster closer to center)
+        float orbital_speed = 1.0f / sqrtf(dist / BH_INNERMOST_ORBIT);
+        if (orbital_speed > 1.0f) orbital_speed = 1.0f;
+
+        // Gradual inspiral - mostly tangential with slight inward drift
+        float inspiral_rate = 0.15f;  // Rate of inward spiral
+        move_x_f = tang_x * orbital_speed + norm_x * inspiral_rate;
+        move_y_f = tang_y * orbital_speed + norm_y * inspiral_rate;
+
+    } else {
+        // === OUTER REGION - Simple gravitational attraction ===
+        // Particles fall roughly straight toward black hole
+
+        // Add slight deflection based on initial velocity (gravitational lensing)
+        float deflection = 0.1f * (1.0f - dist / BLACK_HOLE_GRAVITY_WELL);
+        move_x_f = norm_x + tang_x * deflection;
+        move_y_f = norm_y + tang_y * deflection;
+    }
+
+    // Convert to discrete movement
+    int move_x = (move_x_f > 0.3f) ? 1 : (move_x_f < -0.3f) ? -1 : 0;
+    int move_y = (move_y_f > 0.3f) ? 1 : (move_y_f < -0.3f) ? -1 : 0;
+
+    // Attempt to move
+    int new_x = px + move_x;
+    int new_y = py + move_y;
+
+    if (world.in_bounds(new_x, new_y)) {
+        MaterialID target = world.get_material(new_x, new_y);
+        bool moved = false;
+        if (target == MaterialID::Empty) {
+            moved = true;
+        } else if (dist_sq <= accretion_disk_sq &&
+                   target != MaterialID::Black_Hole &&
+                   target != MaterialID::Bedrock &&
+                   target != MaterialID::White_Hole) {
+            // In accretion disk, particles can push past each other (turbulent flow)
+            moved = world.random_one_in(5);
+        }
+        if (moved) {
+            world.swap_cells(px, py, new_x, new_y);
+            world.get_cell(new_x, new_y).mark_updated();
+            world.activate_chunk_at_position(new_x, new_y);
+        }
+    }
+}
+
 void update_black_hole(World& world, int32_t x, int32_t y) {
     // Realistic black hole simulation with performance optimizations
     // Features: Event horizon, photon sphere, accretion disk with Keplerian rotation,
     // relativistic jets, tidal forces (spaghettification), gravitational lensing,
-    // time dilation effect, Hawking radiation, and mass accumulation
+    // time dilation effect, Hawking radiation, and mass accumulation.
+    // The well beyond the photon sphere is applied by the shared gravity field
+    // (see GravityField), which merges neighbouring black hole cells.
 
     // === PHYSICAL PARAMETERS ===
-    const int event_horizon = 2;      // Schwarzschild radius - point of no return
-    const int photon_sphere = 3;      // 1.5x event horizon - light orbits here
-    const int innermost_orbit = 5;    // ISCO - innermost stable circular orbit (3x Schwarzschild)
-    const int accretion_disk = 12;    // Visible accretion disk outer edge
-    const int gravity_well = 30;      // Gravitational influence radius
+    const int event_horizon = BH_EVENT_HORIZON;
+    const int photon_sphere = BLACK_HOLE_PHOTON_SPHERE;  // 1.5x event horizon - light orbits here
 
     // Pre-compute squared radii (avoid sqrt in hot path)
     const int event_horizon_sq = event_horizon * event_horizon;
     const int photon_sphere_sq = photon_sphere * photon_sphere;
-    const int innermost_orbit_sq = innermost_orbit * innermost_orbit;
-    const int accretion_disk_sq = accretion_disk * accretion_disk;
-    const int gravity_well_sq = gravity_well * gravity_well;
+
+    world.gravity_field().add_source(x, y, GravityField::SourceKind::Attractor);
 
     // Track mass consumed this frame for jet emission
     int mass_consumed = 0;
@@ -8663,13 +7324,13 @@ void update_black_hole(World& world, int32_t x, int32_t y) {
     if (stored_mass > 15) {
         // Emit jet particles upward and downward
         for (int jet_dir = -1; jet_dir <= 1; jet_dir += 2) {
-            int jet_dist = 3 + (world.random_int() % 4);
+            int jet_dist = 3 + world.random_below(4);
             int jy = y + jet_dir * jet_dist;
-            int jx = x + (world.random_int() % 3) - 1;  // Slight spread
+            int jx = x + world.random_below(3) - 1;  // Slight spread
 
             if (world.in_bounds(jx, jy) && world.get_material(jx, jy) == MaterialID::Empty) {
                 world.set_material(jx, jy, MaterialID::Plasma);
-                world.get_cell(jx, jy).set_lifetime(15 + world.random_int() % 10);
+                world.get_cell(jx, jy).set_lifetime(15 + world.random_below(10));
                 // Give jet particles velocity away from black hole
                 world.get_cell(jx, jy).velocity_y = jet_dir * 8;
             }
@@ -8680,10 +7341,10 @@ void update_black_hole(World& world, int32_t x, int32_t y) {
     // === HAWKING RADIATION ===
     // Quantum effect - black holes slowly evaporate by emitting particles
     // Emits from just outside event horizon in random direction
-    if ((world.random_int() % 3000) == 0) {
-        float angle = (world.random_int() % 360) * 3.14159f / 180.0f;
-        int ex = x + (int)(cosf(angle) * (event_horizon + 1));
-        int ey = y + (int)(sinf(angle) * (event_horizon + 1));
+    if (world.random_one_in(3000)) {
+        const UnitDirection& direction = random_direction(world);
+        int ex = x + (int)(direction.dx * (event_horizon + 1));
+        int ey = y + (int)(direction.dy * (event_horizon + 1));
         if (world.in_bounds(ex, ey) && world.get_material(ex, ey) == MaterialID::Empty) {
             // Hawking radiation appears as high-energy particles
             world.set_material(ex, ey, MaterialID::Spark);
@@ -8691,23 +7352,13 @@ void update_black_hole(World& world, int32_t x, int32_t y) {
         }
     }
 
-    // === MAIN GRAVITY PROCESSING ===
-    // Process gravity field with sparse sampling for performance
-    for (int dy = -gravity_well; dy <= gravity_well; dy++) {
-        for (int dx = -gravity_well; dx <= gravity_well; dx++) {
+    // === EVENT HORIZON AND PHOTON SPHERE ===
+    for (int dy = -photon_sphere; dy <= photon_sphere; dy++) {
+        for (int dx = -photon_sphere; dx <= photon_sphere; dx++) {
             if (dx == 0 && dy == 0) continue;
 
             int dist_sq = dx * dx + dy * dy;
-
-            // Skip outside gravity well
-            if (dist_sq > gravity_well_sq) continue;
-
-            // Performance: Sparse sampling in outer regions
-            if (dist_sq > accretion_disk_sq) {
-                // Process only 1/8 of cells in outer region
-                if (((dx ^ dy) & 1) != 0) continue;
-                if ((world.random_int() & 3) != 0) continue;
-            }
+            if (dist_sq > photon_sphere_sq) continue;
 
             int px = x + dx;
             int py = y + dy;
@@ -8726,11 +7377,11 @@ void update_black_hole(World& world, int32_t x, int32_t y) {
                 mass_consumed++;
 
                 // Matter crossing event horizon releases energy
-                if ((world.random_int() % 4) == 0) {
+                if (world.random_one_in(4)) {
                     // X-ray burst at random point on photon sphere
-                    float burst_angle = (world.random_int() % 360) * 3.14159f / 180.0f;
-                    int bx = x + (int)(cosf(burst_angle) * photon_sphere);
-                    int by = y + (int)(sinf(burst_angle) * photon_sphere);
+                    const UnitDirection& burst = random_direction(world);
+                    int bx = x + (int)(burst.dx * photon_sphere);
+                    int by = y + (int)(burst.dy * photon_sphere);
                     if (world.in_bounds(bx, by) && world.get_material(bx, by) == MaterialID::Empty) {
                         world.set_material(bx, by, MaterialID::Plasma);
                         world.get_cell(bx, by).set_lifetime(6);
@@ -8739,119 +7390,25 @@ void update_black_hole(World& world, int32_t x, int32_t y) {
                 continue;
             }
 
-            // Calculate distance (only when needed)
-            float dist = sqrtf((float)dist_sq);
-            float inv_dist = 1.0f / dist;
-
             // === PHOTON SPHERE - Light orbits here ===
             // Plasma/Spark/Fire particles orbit instead of falling in
-            if (dist_sq <= photon_sphere_sq && dist_sq > event_horizon_sq) {
-                if (m == MaterialID::Plasma || m == MaterialID::Spark ||
-                    m == MaterialID::Fire || m == MaterialID::Magic) {
-                    // Pure tangential motion - stable orbit
-                    float tang_x = -dy * inv_dist;
-                    float tang_y = dx * inv_dist;
-                    int orbit_x = px + ((tang_x > 0.5f) ? 1 : (tang_x < -0.5f) ? -1 : 0);
-                    int orbit_y = py + ((tang_y > 0.5f) ? 1 : (tang_y < -0.5f) ? -1 : 0);
-
-                    if (world.in_bounds(orbit_x, orbit_y) &&
-                        world.get_material(orbit_x, orbit_y) == MaterialID::Empty) {
-                        world.swap_cells(px, py, orbit_x, orbit_y);
-                    }
-                    continue;
+            if (m == MaterialID::Plasma || m == MaterialID::Spark ||
+                m == MaterialID::Fire || m == MaterialID::Magic) {
+                // Pure tangential motion - stable orbit
+                float inv_dist = 1.0f / sqrtf((float)dist_sq);
+                float tang_x = -dy * inv_dist;
+                float tang_y = dx * inv_dist;
+                int orbit_x = px + ((tang_x > 0.5f) ? 1 : (tang_x < -0.5f) ? -1 : 0);
+                int orbit_y = py + ((tang_y > 0.5f) ? 1 : (tang_y < -0.5f) ? -1 : 0);
+
+                if (world.in_bounds(orbit_x, orbit_y) &&
+                    world.get_material(orbit_x, orbit_y) == MaterialID::Empty) {
+                    world.swap_cells(px, py, orbit_x, orbit_y);
                 }
+                continue;
             }
 
-            // === TIME DILATION ===
-            // Particles slow down as they approach event horizon
-            // Simulated by reducing move probability near the center
-            float time_factor = dist / accretion_disk;  // 0 at center, 1 at disk edge
-            if (time_factor < 0.3f) time_factor = 0.3f;  // Cap minimum speed
-
-            // === GRAVITATIONAL STRENGTH ===
-            // Inverse square law: F = GM/r²
-            float gravity_strength = 500.0f / (float)dist_sq;
-            gravity_strength *= time_factor;  // Apply time dilation
-
-            int pull_chance = (int)(gravity_strength);
-            if (pull_chance < 1) pull_chance = 1;
-            if (pull_chance > 100) pull_chance = 100;
-
-            if ((int)(world.random_int() % 100) >= pull_chance) continue;
-
-            // === MOVEMENT CALCULATION ===
-            float norm_x = -dx * inv_dist;  // Unit vector toward black hole
-            float norm_y = -dy * inv_dist;
-            float tang_x = -norm_y;          // Tangent (perpendicular, counterclockwise)
-            float tang_y = norm_x;
-
-            float move_x_f, move_y_f;
-
-            if (dist_sq <= innermost_orbit_sq) {
-                // === INSIDE ISCO - Unstable, spiraling inward ===
-                // Matter here cannot maintain stable orbit, falls rapidly
-
-                // Strong radial pull with slight rotation
-                float spiral = 0.2f;
-                move_x_f = norm_x * 0.8f + tang_x * spiral;
-                move_y_f = norm_y * 0.8f + tang_y * spiral;
-
-                // === TIDAL FORCES / SPAGHETTIFICATION ===
-                // Differential gravity stretches objects radially
-                if ((world.random_int() % 3) == 0) {
-                    // Stretch along radial direction (toward/away from BH)
-                    int stretch_x = px + (int)(norm_x * 2);
-                    int stretch_y = py + (int)(norm_y * 2);
-                    if (world.in_bounds(stretch_x, stretch_y) &&
-                        world.get_material(stretch_x, stretch_y) == MaterialID::Empty) {
-                        // Clone particle along stretch direction (visual tidal effect)
-                        world.set_material(stretch_x, stretch_y, m);
-                    }
-                }
-
-            } else if (dist_sq <= accretion_disk_sq) {
-                // === ACCRETION DISK - Keplerian orbital motion ===
-                // Orbital velocity: v ∝ 1/√r (faster closer to center)
-                float orbital_speed = 1.0f / sqrtf(dist / innermost_orbit);
-                if (orbital_speed > 1.0f) orbital_speed = 1.0f;
-
-                // Gradual inspiral - mostly tangential with slight inward drift
-                float inspiral_rate = 0.15f;  // Rate of inward spiral
-                move_x_f = tang_x * orbital_speed + norm_x * inspiral_rate;
-                move_y_f = tang_y * orbital_speed + norm_y * inspiral_rate;
-
-            } else {
-                // === OUTER REGION - Simple gravitational attraction ===
-                // Particles fall roughly straight toward black hole
-
-                // Add slight deflection based on initial velocity (gravitational lensing)
-                float deflection = 0.1f * (1.0f - dist / gravity_well);
-                move_x_f = norm_x + tang_x * deflection;
-                move_y_f = norm_y + tang_y * deflection;
-            }
-
-            // Convert to discrete movement
-            int move_x = (move_x_f > 0.3f) ? 1 : (move_x_f < -0.3f) ? -1 : 0;
-            int move_y = (move_y_f > 0.3f) ? 1 : (move_y_f < -0.3f) ? -1 : 0;
-
-            // Attempt to move
-            int new_x = px + move_x;
-            int new_y = py + move_y;
-
-            if (world.in_bounds(new_x, new_y)) {
-                MaterialID target = world.get_material(new_x, new_y);
-                if (target == MaterialID::Empty) {
-                    world.swap_cells(px, py, new_x, new_y);
-                } else if (dist_sq <= accretion_disk_sq &&
-                           target != MaterialID::Black_Hole &&
-                           target != MaterialID::Bedrock &&
-                           target != MaterialID::White_Hole) {
-                    // In accretion disk, particles can push past each other (turbulent flow)
-                    if ((world.random_int() % 5) == 0) {
-                        world.swap_cells(px, py, new_x, new_y);
-                    }
-                }
-            }
+            apply_black_hole_pull(world, px, py, dx, dy, 1);
         }
     }
 
@@ -8862,48 +7419,42 @@ void update_black_hole(World& world, int32_t x, int32_t y) {
     }
 }
 
-void update_white_hole(World& world, int32_t x, int32_t y) {
-    // Repels matter
-    int push_radius = 15;
-
-    // Push nearby materials away from center
-    for (int dy = -push_radius; dy <= push_radius; dy++) {
-        for (int dx = -push_radius; dx <= push_radius; dx++) {
-            if (dx == 0 && dy == 0) continue;
-
-            int dist_sq = dx * dx + dy * dy;
-            if (dist_sq > push_radius * push_radius) continue;
-            if ((world.random_int() % 5) != 0) continue;
-
-            int px = x + dx;
-            int py = y + dy;
+void apply_white_hole_push(World& world, int32_t px, int32_t py, int32_t dx, int32_t dy, uint32_t mass) {
+    // Each merged white hole cell gets its own 1-in-5 chance
+    if (world.random_below(5) >= mass) return;
 
-            if (!world.in_bounds(px, py)) continue;
-            MaterialID m = world.get_material(px, py);
-            if (m == MaterialID::Empty || m == MaterialID::Black_Hole ||
-                m == MaterialID::White_Hole || m == MaterialID::Bedrock) continue;
+    if (!world.in_bounds(px, py)) return;
+    MaterialID m = world.get_material(px, py);
+    if (m == MaterialID::Empty || m == MaterialID::Black_Hole ||
+        m == MaterialID::White_Hole || m == MaterialID::Bedrock) return;
 
-            // Move away from white hole
-            int move_x = (dx > 0) ? 1 : (dx < 0) ? -1 : 0;
-            int move_y = (dy > 0) ? 1 : (dy < 0) ? -1 : 0;
+    // Move away from white hole
+    int move_x = (dx > 0) ? 1 : (dx < 0) ? -1 : 0;
+    int move_y = (dy > 0) ? 1 : (dy < 0) ? -1 : 0;
 
-            int new_x = px + move_x;
-            int new_y = py + move_y;
+    int new_x = px + move_x;
+    int new_y = py + move_y;
 
-            if (world.in_bounds(new_x, new_y) &&
-                world.get_material(new_x, new_y) == MaterialID::Empty) {
-                world.swap_cells(px, py, new_x, new_y);
-            }
-        }
+    if (world.in_bounds(new_x, new_y) &&
+        world.get_material(new_x, new_y) == MaterialID::Empty) {
+        world.swap_cells(px, py, new_x, new_y);
+        world.get_cell(new_x, new_y).mark_updated();
+        world.activate_chunk_at_position(new_x, new_y);
     }
 }
 
+void update_white_hole(World& world, int32_t x, int32_t y) {
+    // Repels matter out to WHITE_HOLE_PUSH_RADIUS; the push itself is applied
+    // by the shared gravity field
+    world.gravity_field().add_source(x, y, GravityField::SourceKind::Repeller);
+}
+
 void update_acid_gas(World& world, int32_t x, int32_t y) {
     // Corrosive vapor - damages materials
     Cell& cell = world.get_cell(x, y);
 
     // Corrode nearby materials
-    if ((world.random_int() % 10) == 0) {
+    if (world.random_one_in(10)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy)) {
@@ -8912,7 +7463,7 @@ void update_acid_gas(World& world, int32_t x, int32_t y) {
                     if (neighbor == MaterialID::Metal || neighbor == MaterialID::Copper ||
                         neighbor == MaterialID::Iron_Filings || neighbor == MaterialID::Flesh ||
                         neighbor == MaterialID::Wood || neighbor == MaterialID::Leaf) {
-                        if ((world.random_int() % 5) == 0) {
+                        if (world.random_one_in(5)) {
                             world.set_material(x + dx, y + dy, MaterialID::Empty);
                         }
                     }
@@ -8921,7 +7472,7 @@ void update_acid_gas(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_gas_update(world, x, y, -1, -10, true);
+    generic_gas_update<-1, -10, true>(world, x, y);
 }
 
 void update_ice_bomb(World& world, int32_t x, int32_t y) {
@@ -8947,28 +7498,7 @@ void update_ice_bomb(World& world, int32_t x, int32_t y) {
     }
 
     if (detonate) {
-        int radius = 12;
-        for (int ey = -radius; ey <= radius; ey++) {
-            for (int ex = -radius; ex <= radius; ex++) {
-                if (ex * ex + ey * ey <= radius * radius) {
-                    if (world.in_bounds(x + ex, y + ey)) {
-                        MaterialID m = world.get_material(x + ex, y + ey);
-                        if (m == MaterialID::Water) {
-                            world.set_material(x + ex, y + ey, MaterialID::Ice);
-                        } else if (m == MaterialID::Lava) {
-                            world.set_material(x + ex, y + ey, MaterialID::Obsidian);
-                        } else if (m == MaterialID::Steam || m == MaterialID::Steam_Hot) {
-                            world.set_material(x + ex, y + ey, MaterialID::Snow);
-                        } else if (m == MaterialID::Fire || m == MaterialID::Ember) {
-                            world.set_material(x + ex, y + ey, MaterialID::Empty);
-                        } else if (m == MaterialID::Empty && (world.random_int() % 3) == 0) {
-                            world.set_material(x + ex, y + ey, MaterialID::Frost);
-                            world.get_cell(x + ex, y + ey).set_lifetime(40);
-                        }
-                    }
-                }
-            }
-        }
+        Explosions::detonate(world, x, y, BlastType::IceBomb);
         world.set_material(x, y, MaterialID::Ice);
     }
 }
@@ -8995,25 +7525,7 @@ void update_fire_bomb(World& world, int32_t x, int32_t y) {
     }
 
     if (detonate) {
-        int radius = 10;
-        for (int ey = -radius; ey <= radius; ey++) {
-            for (int ex = -radius; ex <= radius; ex++) {
-                if (ex * ex + ey * ey <= radius * radius) {
-                    if (world.in_bounds(x + ex, y + ey)) {
-                        MaterialID m = world.get_material(x + ex, y + ey);
-                        if (m != MaterialID::Bedrock && m != MaterialID::Water) {
-                            if (ex * ex + ey * ey <= (radius/2) * (radius/2)) {
-                                world.set_material(x + ex, y + ey, MaterialID::Napalm);
-                                world.get_cell(x + ex, y + ey).set_lifetime(50);
-                            } else if (m == MaterialID::Empty || (world.random_int() % 2) == 0) {
-                                world.set_material(x + ex, y + ey, MaterialID::Fire);
-                                world.get_cell(x + ex, y + ey).set_lifetime(25);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        Explosions::detonate(world, x, y, BlastType::FireBomb);
     }
 }
 
@@ -9034,7 +7546,7 @@ void update_mana(World& world, int32_t x, int32_t y) {
     }
 
     // Energize nearby magic things
-    if ((world.random_int() % 50) == 0) {
+    if (world.random_one_in(50)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy)) {
@@ -9062,15 +7574,15 @@ void update_mirage(World& world, int32_t x, int32_t y) {
             world.set_material(x, y, MaterialID::Empty);
             return;
         }
-    } else if ((world.random_int() % 200) == 0) {
+    } else if (world.random_one_in(200)) {
         world.set_material(x, y, MaterialID::Empty);
         return;
     }
 
     // Shimmer around
-    if ((world.random_int() % 5) == 0) {
-        int dx = (world.random_int() % 3) - 1;
-        int dy = (world.random_int() % 3) - 1;
+    if (world.random_one_in(5)) {
+        int dx = world.random_below(3) - 1;
+        int dy = world.random_below(3) - 1;
         if (world.in_bounds(x + dx, y + dy) && world.get_material(x + dx, y + dy) == MaterialID::Empty) {
             world.swap_cells(x, y, x + dx, y + dy);
         }
@@ -9120,26 +7632,14 @@ void update_cursed(World& world, int32_t x, int32_t y) {
     // Dark corruption - spreads slowly, damages life
     Cell& cell = world.get_cell(x, y);
 
-    // Spread to nearby materials
-    if ((world.random_int() % 200) == 0) {
-        int dx = (world.random_int() % 3) - 1;
-        int dy = (world.random_int() % 3) - 1;
-        if (world.in_bounds(x + dx, y + dy)) {
-            MaterialID neighbor = world.get_material(x + dx, y + dy);
-            // Corrupt organic materials
-            if (neighbor == MaterialID::Grass || neighbor == MaterialID::Flower ||
-                neighbor == MaterialID::Leaf || neighbor == MaterialID::Wood) {
-                world.set_material(x + dx, y + dy, MaterialID::Cursed);
-            }
-        }
-    }
+    // Spreading is a random tick (tick_cursed)
 
     // Damage nearby people
     for (int dy = -1; dy <= 1; dy++) {
         for (int dx = -1; dx <= 1; dx++) {
-            if (world.in_bounds(x + dx, y + dy) &&
-                world.get_material(x + dx, y + dy) == MaterialID::Person) {
-                world.get_cell(x + dx, y + dy).damage_health(1);
+            AgentHandle target = world.get_agent(x + dx, y + dy);
+            if (target != AgentTable::INVALID) {
+                world.agents().damage_health(target, 1);
             }
         }
     }
@@ -9148,15 +7648,14 @@ void update_cursed(World& world, int32_t x, int32_t y) {
 void update_blessed(World& world, int32_t x, int32_t y) {
     // Light purification - heals and protects
     // Heal nearby people
-    if ((world.random_int() % 30) == 0) {
+    if (world.random_one_in(30)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
-                if (world.in_bounds(x + dx, y + dy) &&
-                    world.get_material(x + dx, y + dy) == MaterialID::Person) {
-                    Cell& target = world.get_cell(x + dx, y + dy);
-                    uint8_t health = target.get_health();
+                AgentHandle target = world.get_agent(x + dx, y + dy);
+                if (target != AgentTable::INVALID) {
+                    uint8_t health = world.agents().get_health(target);
                     if (health < 100) {
-                        target.set_health(health + 1);
+                        world.agents().set_health(target, health + 1);
                     }
                 }
             }
@@ -9185,14 +7684,14 @@ void update_soul(World& world, int32_t x, int32_t y) {
             world.set_material(x, y, MaterialID::Empty);
             return;
         }
-    } else if ((world.random_int() % 500) == 0) {
+    } else if (world.random_one_in(500)) {
         world.set_material(x, y, MaterialID::Empty);
         return;
     }
 
     // Rise slowly with wandering
-    if ((world.random_int() % 3) == 0) {
-        int dx = (world.random_int() % 3) - 1;
+    if (world.random_one_in(3)) {
+        int dx = world.random_below(3) - 1;
         if (world.in_bounds(x + dx, y - 1) && world.get_material(x + dx, y - 1) == MaterialID::Empty) {
             world.swap_cells(x, y, x + dx, y - 1);
         }
@@ -9213,9 +7712,9 @@ void update_spirit(World& world, int32_t x, int32_t y) {
     }
 
     // Wander randomly, can pass through things
-    if ((world.random_int() % 2) == 0) {
-        int dx = (world.random_int() % 3) - 1;
-        int dy = (world.random_int() % 3) - 1;
+    if (world.random_one_in(2)) {
+        int dx = world.random_below(3) - 1;
+        int dy = world.random_below(3) - 1;
         if (world.in_bounds(x + dx, y + dy)) {
             MaterialID target = world.get_material(x + dx, y + dy);
             if (target == MaterialID::Empty) {
@@ -9233,22 +7732,21 @@ void update_aether(World& world, int32_t x, int32_t y) {
     Cell& cell = world.get_cell(x, y);
 
     // Heal nearby people
-    if ((world.random_int() % 50) == 0) {
+    if (world.random_one_in(50)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
-                if (world.in_bounds(x + dx, y + dy) &&
-                    world.get_material(x + dx, y + dy) == MaterialID::Person) {
-                    Cell& target = world.get_cell(x + dx, y + dy);
-                    uint8_t health = target.get_health();
+                AgentHandle target = world.get_agent(x + dx, y + dy);
+                if (target != AgentTable::INVALID) {
+                    uint8_t health = world.agents().get_health(target);
                     if (health < 100) {
-                        target.set_health(health + 2);
+                        world.agents().set_health(target, health + 2);
                     }
                 }
             }
         }
     }
 
-    generic_gas_update(world, x, y, -3, -20, true);
+    generic_gas_update<-3, -20, true>(world, x, y);
 }
 
 void update_nether(World& world, int32_t x, int32_t y) {
@@ -9261,11 +7759,12 @@ void update_nether(World& world, int32_t x, int32_t y) {
             if (world.in_bounds(x + dx, y + dy)) {
                 MaterialID neighbor = world.get_material(x + dx, y + dy);
                 if (neighbor == MaterialID::Person) {
-                    world.get_cell(x + dx, y + dy).damage_health(3);
+                    AgentHandle target = world.get_agent(x + dx, y + dy);
+                    if (target != AgentTable::INVALID) world.agents().damage_health(target, 3);
                 }
                 // Wilt plants
                 if ((neighbor == MaterialID::Grass || neighbor == MaterialID::Flower) &&
-                    (world.random_int() % 10) == 0) {
+                    world.random_one_in(10)) {
                     world.set_material(x + dx, y + dy, MaterialID::Ash);
                 }
             }
@@ -9296,13 +7795,14 @@ void update_phoenix_ash(World& world, int32_t x, int32_t y) {
     Cell& cell = world.get_cell(x, y);
 
     // Check for bones nearby - revive to person
-    if ((world.random_int() % 100) == 0) {
+    if (world.random_one_in(100)) {
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
                 if (world.in_bounds(x + dx, y + dy) &&
                     world.get_material(x + dx, y + dy) == MaterialID::Bone) {
                     world.set_material(x + dx, y + dy, MaterialID::Person);
-                    world.get_cell(x + dx, y + dy).set_health(30);
+                    AgentHandle revived = world.get_agent(x + dx, y + dy);
+                    if (revived != AgentTable::INVALID) world.agents().set_health(revived, 30);
                     world.set_material(x, y, MaterialID::Fire);
                     world.get_cell(x, y).set_lifetime(20);
                     return;
@@ -9326,7 +7826,193 @@ void update_phoenix_ash(World& world, int32_t x, int32_t y) {
         }
     }
 
-    generic_powder_update(world, x, y, 1, 6);
+    generic_powder_update<1, 6>(world, x, y);
+}
+
+// ============================================================================
+// RANDOM TICKS - slow growth, run by Simulation on random cells per chunk
+// ============================================================================
+
+static void tick_moss(World& world, int32_t x, int32_t y) {
+    // Moss spreads slowly on stone/brick/wood
+    if (!tick_chance(world, 128)) return;
+    uint32_t dir = world.random_int() & 3;
+    int dx = (dir == 0) ? -1 : (dir == 1) ? 1 : 0;
+    int dy = (dir == 2) ? -1 : (dir == 3) ? 1 : 0;
+    int nx = x + dx, ny = y + dy;
+    if (world.in_bounds(nx, ny)) {
+        MaterialID m = world.get_material(nx, ny);
+        if (m == MaterialID::Stone || m == MaterialID::Brick || m == MaterialID::Wood) {
+            world.set_material(nx, ny, MaterialID::Moss);
+        }
+    }
+}
+
+static void tick_vine(World& world, int32_t x, int32_t y) {
+    // Vines grow downward slowly
+    if (!tick_chance(world, 64)) return;
+    if (world.in_bounds(x, y + 1) && world.get_material(x, y + 1) == MaterialID::Empty) {
+        world.set_material(x, y + 1, MaterialID::Vine);
+    }
+}
+
+static void tick_fungus(World& world, int32_t x, int32_t y) {
+    // Fungus spreads slowly and releases spores
+    if (tick_chance(world, 256)) {
+        uint32_t dir = world.random_int() & 3;
+        int dx = (dir == 0) ? -1 : (dir == 1) ? 1 : 0;
+        int dy = (dir == 2) ? -1 : (dir == 3) ? 1 : 0;
+        int nx = x + dx, ny = y + dy;
+        if (world.in_bounds(nx, ny)) {
+            MaterialID m = world.get_material(nx, ny);
+            if (m == MaterialID::Wood || m == MaterialID::Dirt ||
+                m == MaterialID::Grass || m == MaterialID::Flesh) {
+                world.set_material(nx, ny, MaterialID::Fungus);
+            }
+        }
+    }
+    if (tick_chance(world, 512)) {
+        if (world.in_bounds(x, y - 1) && world.get_material(x, y - 1) == MaterialID::Empty) {
+            world.set_material(x, y - 1, MaterialID::Spore);
+            world.get_cell(x, y - 1).set_lifetime(40);
+        }
+    }
+}
+
+static void tick_coral(World& world, int32_t x, int32_t y) {
+    // Coral grows slowly underwater, up and sideways into the water
+    if (!tick_chance(world, 512)) return;
+    bool underwater = false;
+    for (int dy = -1; dy <= 1 && !underwater; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int nx = x + dx, ny = y + dy;
+            if (world.in_bounds(nx, ny) && world.get_material(nx, ny) == MaterialID::Water) {
+                underwater = true;
+                break;
+            }
+        }
+    }
+    if (!underwater) return;
+
+    uint32_t dir = world.random_int() & 3;
+    int dx = (dir == 0) ? -1 : (dir == 1) ? 1 : 0;
+    int dy = (dir == 2) ? -1 : 0;
+    int nx = x + dx, ny = y + dy;
+    if (world.in_bounds(nx, ny) && world.get_material(nx, ny) == MaterialID::Water) {
+        world.set_material(nx, ny, MaterialID::Coral);
+    }
+}
+
+static void tick_bamboo(World& world, int32_t x, int32_t y) {
+    // Grow upward if near water
+    if (!tick_chance(world, 256)) return;
+    if (!world.in_bounds(x, y - 1) || world.get_material(x, y - 1) != MaterialID::Empty) return;
+    for (int dy = -2; dy <= 2; dy++) {
+        for (int dx = -2; dx <= 2; dx++) {
+            if (world.in_bounds(x + dx, y + dy) &&
+                world.get_material(x + dx, y + dy) == MaterialID::Water) {
+                world.set_material(x, y - 1, MaterialID::Bamboo);
+                return;
+            }
+        }
+    }
+}
+
+static void tick_fertilizer(World& world, int32_t x, int32_t y) {
+    // Helps plants grow - accelerates nearby organic growth
+    if (!tick_chance(world, 30)) return;
+    for (int dy = -2; dy <= 2; dy++) {
+        for (int dx = -2; dx <= 2; dx++) {
+            if (world.in_bounds(x + dx, y + dy)) {
+                MaterialID neighbor = world.get_material(x + dx, y + dy);
+                // Boost plant growth
+                if (neighbor == MaterialID::Seed) {
+                    world.set_material(x + dx, y + dy, MaterialID::Vine);
+                    world.set_material(x, y, MaterialID::Empty);
+                    return;
+                }
+                if (neighbor == MaterialID::Grass && world.random_one_in(20)) {
+                    if (world.in_bounds(x + dx, y + dy - 1) &&
+                        world.get_material(x + dx, y + dy - 1) == MaterialID::Empty) {
+                        world.set_material(x + dx, y + dy - 1, MaterialID::Flower);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void tick_root(World& world, int32_t x, int32_t y) {
+    if (!tick_chance(world, 100)) return;
+
+    // Grow downward through soil
+    int grow_dir = world.random_below(3) - 1;  // -1, 0, or 1
+    int gx = x + grow_dir;
+    int gy = y + 1;
+    if (world.in_bounds(gx, gy)) {
+        MaterialID target = world.get_material(gx, gy);
+        if (target == MaterialID::Soil || target == MaterialID::Dirt) {
+            world.set_material(gx, gy, MaterialID::Root);
+        }
+    }
+
+    // Absorb nearby water (the first found on each row)
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (world.in_bounds(x + dx, y + dy) &&
+                world.get_material(x + dx, y + dy) == MaterialID::Water) {
+                world.set_material(x + dx, y + dy, MaterialID::Empty);
+                break;
+            }
+        }
+    }
+}
+
+static void tick_egg(World& world, int32_t x, int32_t y) {
+    // Incubate: hatch when warm
+    if (!tick_chance(world, 3000)) return;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (!world.in_bounds(x + dx, y + dy)) continue;
+            MaterialID neighbor = world.get_material(x + dx, y + dy);
+            if (neighbor == MaterialID::Fire || neighbor == MaterialID::Lava ||
+                neighbor == MaterialID::Steam_Hot) {
+                world.set_material(x, y, MaterialID::Person);
+                AgentHandle hatchling = world.get_agent(x, y);
+                if (hatchling != AgentTable::INVALID) world.agents().set_health(hatchling, 50);
+                return;
+            }
+        }
+    }
+}
+
+static void tick_cursed(World& world, int32_t x, int32_t y) {
+    // Corrupt nearby organic materials
+    if (!tick_chance(world, 200)) return;
+    int dx = world.random_below(3) - 1;
+    int dy = world.random_below(3) - 1;
+    if (world.in_bounds(x + dx, y + dy)) {
+        MaterialID neighbor = world.get_material(x + dx, y + dy);
+        if (neighbor == MaterialID::Grass || neighbor == MaterialID::Flower ||
+            neighbor == MaterialID::Leaf || neighbor == MaterialID::Wood) {
+            world.set_material(x + dx, y + dy, MaterialID::Cursed);
+        }
+    }
+}
+
+void random_tick(World& world, int32_t x, int32_t y, MaterialID material) {
+    switch (material) {
+        case MaterialID::Moss: tick_moss(world, x, y); break;
+        case MaterialID::Vine: tick_vine(world, x, y); break;
+        case MaterialID::Fungus: tick_fungus(world, x, y); break;
+        case MaterialID::Coral: tick_coral(world, x, y); break;
+        case MaterialID::Bamboo: tick_bamboo(world, x, y); break;
+        case MaterialID::Fertilizer: tick_fertilizer(world, x, y); break;
+        case MaterialID::Root: tick_root(world, x, y); break;
+        case MaterialID::Egg: tick_egg(world, x, y); break;
+        case MaterialID::Cursed: tick_cursed(world, x, y); break;
+        default: break;
+    }
 }
 
 } // namespace Materials
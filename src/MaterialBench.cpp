@@ -0,0 +1,194 @@
+#include "MaterialBench.h"
+#include "World.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PixelEngine {
+
+namespace {
+
+// Enum spellings ("Iron_Filings"); labels may differ ("Iron Files")
+constexpr const char* MATERIAL_IDENTIFIERS[] = {
+#define MATERIAL(Name, ...) #Name,
+#include "Materials.def"
+};
+
+struct BenchResult {
+    uint64_t cell_frames = 0;  // Live cells of the material, summed over frames
+    double seconds = 0.0;      // Time spent in Simulation::update
+};
+
+// Names with spaces and underscores ignored, case-folded
+std::string fold_name(const char* name) {
+    std::string folded;
+    for (const char* c = name; *c; ++c) {
+        if (*c == ' ' || *c == '_') continue;
+        folded += static_cast<char>(std::tolower(static_cast<unsigned char>(*c)));
+    }
+    return folded;
+}
+
+bool find_material(const char* name, MaterialID& out) {
+    std::string wanted = fold_name(name);
+    for (size_t id = 0; id < static_cast<size_t>(MaterialID::COUNT); ++id) {
+        if (fold_name(MATERIAL_IDENTIFIERS[id]) == wanted ||
+            fold_name(Materials::MATERIAL_LABELS[id]) == wanted) {
+            out = static_cast<MaterialID>(id);
+            return true;
+        }
+    }
+    return false;
+}
+
+BenchResult bench_material(MaterialID material, uint32_t frames, uint32_t seed) {
+    // Fresh world per material: no state carries over between runs
+    MaterialSystem material_system;
+    auto world = std::make_unique<World>(WORLD_WIDTH, WORLD_HEIGHT, material_system);
+    Simulation simulation(*world);
+    simulation.set_rest_detection_enabled(false);
+    world->seed_rng(seed);
+
+    const int32_t width = world->get_width();
+    const int32_t height = world->get_height();
+    for (int32_t x = 0; x < width; ++x) {
+        world->set_material(x, height - 1, MaterialID::Stone);
+    }
+    for (int32_t y = 0; y < height - 1; ++y) {
+        world->set_material(0, y, MaterialID::Stone);
+        world->set_material(width - 1, y, MaterialID::Stone);
+    }
+
+    // Middle half of the rows, every other cell on average
+    uint32_t state = seed != 0 ? seed : 1;
+    for (int32_t y = height / 4; y < height * 3 / 4; ++y) {
+        for (int32_t x = 1; x < width - 1; ++x) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            if (state & 1) world->set_material(x, y, material);
+        }
+    }
+
+    BenchResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t f = 0; f < frames; ++f) {
+        result.cell_frames += world->census().get_count(material);
+        simulation.update();
+    }
+    auto end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+} // namespace
+
+static void print_bench_usage() {
+    std::cout << "Usage: PixelEngine --bench [options]\n"
+              << "  --material <name>  Benchmark one material (default: every powder, liquid and gas)\n"
+              << "  --frames <n>       Simulation steps per material (default 120)\n"
+              << "  --seed <n>         World and layout seed (default 1)\n"
+              << "  --runs <n>         Timed runs per material; best and median are reported (default 5)\n";
+}
+
+int run_material_bench_cli(int argc, char* argv[]) {
+    uint32_t frames = 120;
+    uint32_t seed = 1;
+    uint32_t runs = 5;
+    std::vector<MaterialID> materials;
+
+    // argv[1] is --bench itself
+    for (int i = 2; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0) {
+            print_bench_usage();
+            return 0;
+        }
+        if (!value) {
+            std::cerr << "Missing value for " << arg << "\n";
+            print_bench_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--material") == 0) {
+            MaterialID material;
+            if (!find_material(value, material)) {
+                std::cerr << "Unknown material: " << value << "\n";
+                return 1;
+            }
+            materials.push_back(material);
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--runs") == 0) {
+            runs = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            print_bench_usage();
+            return 1;
+        }
+        ++i;  // Consumed the value
+    }
+
+    if (frames == 0 || runs == 0) {
+        print_bench_usage();
+        return 1;
+    }
+
+    if (materials.empty()) {
+        for (const MaterialDef& def : MATERIAL_DEFS) {
+            if (def.state == MaterialState::Powder || def.state == MaterialState::Liquid ||
+                def.state == MaterialState::Gas) {
+                materials.push_back(def.id);
+            }
+        }
+    }
+
+    std::cout << "Material bench: " << materials.size() << " materials, " << frames
+              << " frames x " << runs << " runs each, " << WORLD_WIDTH << "x" << WORLD_HEIGHT
+              << ", seed " << seed << "\n";
+    std::printf("%-20s %12s %10s %10s\n", "material", "cells/frame", "best ns", "median ns");
+
+    // Every run replays the same world, so the runs differ only by noise:
+    // the best is the cleanest figure, the median shows how quiet the box was
+    BenchResult total;
+    double total_best = 0.0;
+    double total_median = 0.0;
+    std::vector<double> timings(runs);
+    for (MaterialID material : materials) {
+        BenchResult result;
+        for (uint32_t run = 0; run < runs; ++run) {
+            result = bench_material(material, frames, seed);
+            timings[run] = result.seconds;
+        }
+        std::sort(timings.begin(), timings.end());
+        double best = timings[0];
+        double median = runs % 2 ? timings[runs / 2] : (timings[runs / 2 - 1] + timings[runs / 2]) * 0.5;
+        total.cell_frames += result.cell_frames;
+        total_best += best;
+        total_median += median;
+
+        double cells = static_cast<double>(result.cell_frames);
+        std::printf("%-20s %12llu %10.2f %10.2f\n", Materials::MATERIAL_LABELS[static_cast<size_t>(material)],
+                    static_cast<unsigned long long>(result.cell_frames / frames),
+                    cells > 0 ? best * 1e9 / cells : 0.0, cells > 0 ? median * 1e9 / cells : 0.0);
+    }
+
+    double cells = static_cast<double>(total.cell_frames);
+    std::printf("%-20s %12s %10.2f %10.2f\n", "all", "",
+                cells > 0 ? total_best * 1e9 / cells : 0.0, cells > 0 ? total_median * 1e9 / cells : 0.0);
+    return 0;
+}
+
+} // namespace PixelEngine
@@ -0,0 +1,53 @@
+#include "MaterialCensus.h"
+
+namespace PixelEngine {
+
+void MaterialCensus::resize(int32_t chunk_count) {
+    words_per_material_ = (chunk_count + 63) / 64;
+    counts_.assign(chunk_count, {});
+    presence_ = std::make_unique<std::atomic<uint64_t>[]>(MATERIAL_COUNT * words_per_material_);
+
+    for (int32_t chunk = 0; chunk < chunk_count; ++chunk) {
+        counts_[chunk][static_cast<size_t>(MaterialID::Empty)] = CHUNK_SIZE * CHUNK_SIZE;
+        set_presence(MaterialID::Empty, chunk);
+    }
+}
+
+void MaterialCensus::reset_chunk(int32_t chunk_index) {
+    std::array<uint16_t, MATERIAL_COUNT>& counts = counts_[chunk_index];
+    for (size_t material = 0; material < MATERIAL_COUNT; ++material) {
+        if (counts[material] != 0) {
+            counts[material] = 0;
+            clear_presence(static_cast<MaterialID>(material), chunk_index);
+        }
+    }
+    counts[static_cast<size_t>(MaterialID::Empty)] = CHUNK_SIZE * CHUNK_SIZE;
+    set_presence(MaterialID::Empty, chunk_index);
+}
+
+bool MaterialCensus::contains(MaterialID material) const {
+    const std::atomic<uint64_t>* words = &presence_[static_cast<size_t>(material) * words_per_material_];
+    for (int32_t word = 0; word < words_per_material_; ++word) {
+        if (words[word].load(std::memory_order_relaxed) != 0) return true;
+    }
+    return false;
+}
+
+uint32_t MaterialCensus::get_count(MaterialID material) const {
+    uint32_t total = 0;
+    for_each_chunk_with(material, [&](int32_t chunk_index) {
+        total += counts_[chunk_index][static_cast<size_t>(material)];
+    });
+    return total;
+}
+
+void MaterialCensus::get_histogram(std::array<uint32_t, MATERIAL_COUNT>& histogram) const {
+    histogram.fill(0);
+    for (const auto& counts : counts_) {
+        for (size_t material = 0; material < MATERIAL_COUNT; ++material) {
+            histogram[material] += counts[material];
+        }
+    }
+}
+
+} // namespace PixelEngine
@@ -2,6 +2,7 @@
 #import <Cocoa/Cocoa.h>
 #import <MetalKit/MetalKit.h>
 #import <QuartzCore/QuartzCore.h>
+#include <algorithm>
 
 // Use fully qualified names in Objective-C++ interface
 using PixelEngine::PlatformCallbacks;
@@ -125,6 +126,13 @@ using PixelEngine::MaterialID;
     if (_inputState->mouse_x >= PixelEngine::WORLD_WIDTH) _inputState->mouse_x = PixelEngine::WORLD_WIDTH - 1;
     if (_inputState->mouse_y < 0) _inputState->mouse_y = 0;
     if (_inputState->mouse_y >= PixelEngine::WORLD_HEIGHT) _inputState->mouse_y = PixelEngine::WORLD_HEIGHT - 1;
+
+    // Queue the position for stroke interpolation
+    if (_inputState->mouse_left_down || _inputState->mouse_right_down) {
+        int32_t slot = std::min(_inputState->mouse_sample_count, InputState::MAX_MOUSE_SAMPLES - 1);
+        _inputState->mouse_samples[slot] = {_inputState->mouse_x, _inputState->mouse_y};
+        _inputState->mouse_sample_count = slot + 1;
+    }
 }
 
 - (void)keyDown:(NSEvent*)event {
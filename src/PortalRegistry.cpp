@@ -0,0 +1,104 @@
+#include "PortalRegistry.h"
+#include <algorithm>
+
+namespace PixelEngine {
+
+void PortalRegistry::resize(int32_t width, int32_t height) {
+    clear();
+    pages_wide_ = (width + (1 << PAGE_SHIFT) - 1) >> PAGE_SHIFT;
+    int32_t pages_high = (height + (1 << PAGE_SHIFT) - 1) >> PAGE_SHIFT;
+    slot_pages_.clear();
+    slot_pages_.resize(static_cast<size_t>(pages_wide_) * pages_high);
+}
+
+uint32_t& PortalRegistry::slot_at(uint32_t packed) {
+    constexpr int32_t PAGE_SIZE = 1 << PAGE_SHIFT;
+    int32_t x = static_cast<int32_t>(packed & 0xFFFF);
+    int32_t y = static_cast<int32_t>(packed >> 16);
+    std::unique_ptr<uint32_t[]>& page = slot_pages_[(y >> PAGE_SHIFT) * pages_wide_ + (x >> PAGE_SHIFT)];
+    if (!page) {
+        page = std::make_unique<uint32_t[]>(PAGE_SIZE * PAGE_SIZE);
+        std::fill(page.get(), page.get() + PAGE_SIZE * PAGE_SIZE, NO_SLOT);
+    }
+    return page[(y & (PAGE_SIZE - 1)) * PAGE_SIZE + (x & (PAGE_SIZE - 1))];
+}
+
+void PortalRegistry::set_slots(uint32_t channel) {
+    const std::vector<uint32_t>& exits = channels_[channel].exits;
+    for (size_t i = 0; i < exits.size(); ++i) {
+        slot_at(exits[i]) = static_cast<uint32_t>(i << 6) | channel;
+    }
+}
+
+void PortalRegistry::add(int32_t x, int32_t y, MaterialID material, uint8_t channel, bool in_order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t index = channel & (CHANNEL_COUNT - 1);
+    Channel& entry = channels_[index];
+
+    if (material == MaterialID::Portal_Out) {
+        uint32_t& slot = slot_at(pack(x, y));
+        if (slot != NO_SLOT) return;  // Already registered
+        slot = static_cast<uint32_t>(entry.exits.size() << 6) | index;
+        entry.exits.push_back(pack(x, y));
+        entry.in_order = entry.in_order && in_order;
+    } else if (material == MaterialID::Portal_In) {
+        ++entry.entrances;
+    }
+}
+
+void PortalRegistry::remove(int32_t x, int32_t y, MaterialID material, uint8_t channel, bool in_order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Channel& entry = channels_[channel & (CHANNEL_COUNT - 1)];
+
+    if (material == MaterialID::Portal_Out) {
+        // The slot names the channel the exit was registered on, even if
+        // some rule rewrote the cell's lifetime bits since
+        uint32_t& slot = slot_at(pack(x, y));
+        if (slot == NO_SLOT) return;
+        Channel& owner = channels_[slot & (CHANNEL_COUNT - 1)];
+        size_t position = slot >> 6;
+        uint32_t moved = owner.exits.back();
+        owner.exits[position] = moved;
+        owner.exits.pop_back();
+        if (position < owner.exits.size()) {
+            slot_at(moved) = static_cast<uint32_t>(position << 6) | (slot & (CHANNEL_COUNT - 1));
+        }
+        slot = NO_SLOT;
+        owner.in_order = owner.in_order && in_order;
+    } else if (material == MaterialID::Portal_In && entry.entrances > 0) {
+        --entry.entrances;
+    }
+}
+
+bool PortalRegistry::pick_exit(uint8_t channel, uint32_t random, int32_t& x, int32_t& y) {
+    uint32_t index = channel & (CHANNEL_COUNT - 1);
+    Channel& entry = channels_[index];
+    if (entry.exits.empty()) return false;
+
+    // Serial edits leave the list in an order that only depends on the
+    // world; after edits from parallel chunk tasks, sort it once
+    if (!entry.in_order) {
+        std::sort(entry.exits.begin(), entry.exits.end());
+        set_slots(index);
+        entry.in_order = true;
+    }
+
+    uint32_t packed = entry.exits[random % entry.exits.size()];
+    x = static_cast<int32_t>(packed & 0xFFFF);
+    y = static_cast<int32_t>(packed >> 16);
+    return true;
+}
+
+void PortalRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Channel& entry : channels_) {
+        for (uint32_t packed : entry.exits) {
+            slot_at(packed) = NO_SLOT;
+        }
+        entry.exits.clear();
+        entry.entrances = 0;
+        entry.in_order = true;
+    }
+}
+
+} // namespace PixelEngine
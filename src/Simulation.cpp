@@ -3,13 +3,61 @@
 
 namespace PixelEngine {
 
+// Materials whose update can touch cells more than one chunk away, or shared
+// per-world state (Person scans whole columns for ground and builds; Portal_In
+// teleports anywhere and picks exits from the portal registry). Everything else reaches
+// at most ~40 cells (nuke radius), which fits inside the phase window.
+static inline bool is_wide_reach(MaterialID material) {
+    return material == MaterialID::Person || material == MaterialID::Portal_In;
+}
+
+// Rest mask of a row while rest detection is off
+static const uint64_t NO_RESTING_CELLS = 0;
+
+// Per-chunk RNG seed for one frame (murmur3 finalizer, never zero)
+static uint32_t mix_chunk_seed(uint32_t frame_seed, uint32_t chunk_index) {
+    uint32_t h = frame_seed ^ (chunk_index * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h != 0 ? h : 1;
+}
+
 Simulation::Simulation(World& world)
     : world_(world)
     , material_system_(world.get_material_system())
     , frame_count_(0)
     , active_chunk_count_(0)
     , updated_cell_count_(0)
-    , scan_direction_(false) {
+    , active_super_chunk_count_(0)
+    , scan_direction_(false)
+    , deterministic_(false)
+    , rest_detection_enabled_(true)
+    , liquid_leveling_enabled_(false) {
+
+    Materials::build_rest_kernel_tables(material_system_, rest_tables_);
+    liquid_leveler_.resize(world_.get_width(), world_.get_height());
+
+    chunk_tasks_.resize(world_.get_chunks_wide() * world_.get_chunks_high());
+    random_tick_marks_.assign(world_.get_chunks_wide() * world_.get_chunks_high(), 0);
+    for (MaterialID material : Materials::RANDOM_TICK_MATERIALS) {
+        has_random_tick_[static_cast<size_t>(material)] = 1;
+    }
+    for (MaterialID material : Materials::INERT_MATERIALS) {
+        is_inert_[static_cast<size_t>(material)] = 1;
+    }
+}
+
+void Simulation::set_thread_count(uint32_t thread_count) {
+    pool_.reset();
+    if (thread_count == 1) return;
+
+    pool_ = std::make_unique<ThreadPool>(thread_count);
+    if (pool_->get_thread_count() <= 1) {
+        pool_.reset();
+    }
 }
 
 void Simulation::update() {
@@ -17,38 +65,273 @@ void Simulation::update() {
     active_chunk_count_ = 0;
     updated_cell_count_ = 0;
 
+    // Lower the flags of super-chunks that fell asleep last frame
+    active_super_chunk_count_ = world_.refresh_super_chunks();
+
     // Scan bottom-to-top (gravity simulation)
     // Alternate left-right scan direction each frame for better dispersion
     scan_direction_ = !scan_direction_;
 
-    for (int32_t chunk_y = world_.get_chunks_high() - 1; chunk_y >= 0; --chunk_y) {
-        if (scan_direction_) {
-            // Scan left to right
-            for (int32_t chunk_x = 0; chunk_x < world_.get_chunks_wide(); ++chunk_x) {
-                Chunk* chunk = world_.get_chunk(chunk_x, chunk_y);
-                if (chunk && chunk->is_active) {
-                    update_chunk(chunk, chunk_x, chunk_y);
-                    ++active_chunk_count_;
-                }
+    if (pool_ || deterministic_) {
+        update_phased();
+    } else {
+        update_serial();
+    }
+
+    // Slow growth on a few random cells per chunk
+    run_random_ticks();
+
+    // Pour resting liquid bodies level in bulk
+    if (liquid_leveling_enabled_) {
+        liquid_leveler_.step(world_);
+    }
+
+    // Black_Hole / White_Hole pull and push, merged per 8×8 tile
+    world_.gravity_field().step(world_);
+
+    // Spread heat from this frame's sources and sinks (when enabled)
+    world_.temperature_field().step(world_);
+
+    // Join / split conductor networks and spark the ones Lightning charged
+    world_.conductors().step(world_);
+
+    // Advance Person construction sites within the per-frame block budget
+    world_.build_jobs().step(world_);
+
+    // Clear updated flags for next frame
+    world_.clear_updated_flags();
+}
+
+void Simulation::run_random_ticks() {
+    const MaterialCensus& census = world_.census();
+    random_tick_chunks_.clear();
+    for (MaterialID material : Materials::RANDOM_TICK_MATERIALS) {
+        census.for_each_chunk_with(material, [&](int32_t chunk_index) {
+            if (!random_tick_marks_[chunk_index]) {
+                random_tick_marks_[chunk_index] = 1;
+                random_tick_chunks_.push_back(chunk_index);
             }
+        });
+    }
+    std::sort(random_tick_chunks_.begin(), random_tick_chunks_.end());
+
+    const int32_t chunks_wide = world_.get_chunks_wide();
+    for (int32_t chunk_index : random_tick_chunks_) {
+        random_tick_marks_[chunk_index] = 0;
+        const Chunk* chunk = world_.get_chunk(chunk_index % chunks_wide, chunk_index / chunks_wide);
+        int32_t base_x = (chunk_index % chunks_wide) * CHUNK_SIZE;
+        int32_t base_y = (chunk_index / chunks_wide) * CHUNK_SIZE;
+
+        // Picks may repeat; each cell still averages one tick per interval
+        for (int32_t i = 0; i < RANDOM_TICKS_PER_CHUNK; ++i) {
+            uint32_t local = world_.random_int() & (CHUNK_SIZE * CHUNK_SIZE - 1);
+            MaterialID material = chunk->cells[local].material_id;
+            if (!has_random_tick_[static_cast<size_t>(material)]) continue;
+
+            int32_t x = base_x + static_cast<int32_t>(local % CHUNK_SIZE);
+            int32_t y = base_y + static_cast<int32_t>(local / CHUNK_SIZE);
+            if (!world_.in_bounds(x, y)) continue;
+            Materials::random_tick(world_, x, y, material);
+        }
+    }
+}
+
+void Simulation::update_serial() {
+    // Bottom-to-top; left to right on scan_direction_ frames
+    world_.for_each_active_chunk(true, !scan_direction_, [&](int32_t chunk_x, int32_t chunk_y, Chunk& chunk) {
+        updated_cell_count_ += update_chunk(&chunk, chunk_x, chunk_y);
+        ++active_chunk_count_;
+    });
+}
+
+// Phased schedule: chunks are split into 9 phases by (chunk_x % 3, chunk_y % 3).
+// A chunk task may read and write its own chunk plus one chunk of margin on
+// every side (64 cells), so two chunks of the same phase never touch the same
+// cell and a phase's result does not depend on how its chunks are spread over
+// threads. Phases run in fixed order, each chunk draws from its own RNG stream
+// seeded from (world RNG, chunk index), and wide-reach cells are replayed
+// serially in chunk order at the end - the frame is identical for 1..N threads.
+// Each phase's active chunks are collected when the phase starts (through the
+// super-chunk flags), so chunks woken by earlier phases still run this frame.
+// Discovery events are still pushed concurrently, so only their queue order
+// varies.
+void Simulation::update_phased() {
+    const int32_t chunks_wide = world_.get_chunks_wide();
+    const uint32_t frame_seed = world_.random_int();
+
+    auto run_chunk = [&](uint32_t chunk_index) {
+        ChunkTask& task = chunk_tasks_[chunk_index];
+        int32_t chunk_x = static_cast<int32_t>(chunk_index) % chunks_wide;
+        int32_t chunk_y = static_cast<int32_t>(chunk_index) / chunks_wide;
+        Chunk* chunk = world_.get_chunk(chunk_x, chunk_y);
+
+        task.rng.seed(mix_chunk_seed(frame_seed, chunk_index));
+        World::RngScope rng_scope(task.rng);
+        AgentTable::SpawnScope spawn_scope(task.agents);
+        task.updated_cells = update_chunk(chunk, chunk_x, chunk_y, &task.deferred);
+    };
+
+    ran_chunks_.clear();
+    for (int32_t phase = 0; phase < 9; ++phase) {
+        phase_chunks_.clear();
+        world_.for_each_active_chunk(false, false, [&](int32_t chunk_x, int32_t chunk_y, Chunk&) {
+            if ((chunk_y % 3) * 3 + (chunk_x % 3) == phase) {
+                phase_chunks_.push_back(static_cast<uint32_t>(chunk_y * chunks_wide + chunk_x));
+            }
+        });
+
+        if (pool_) {
+            pool_->parallel_for(static_cast<uint32_t>(phase_chunks_.size()),
+                                [&](uint32_t i) { run_chunk(phase_chunks_[i]); });
         } else {
-            // Scan right to left
-            for (int32_t chunk_x = world_.get_chunks_wide() - 1; chunk_x >= 0; --chunk_x) {
-                Chunk* chunk = world_.get_chunk(chunk_x, chunk_y);
-                if (chunk && chunk->is_active) {
-                    update_chunk(chunk, chunk_x, chunk_y);
-                    ++active_chunk_count_;
-                }
+            for (uint32_t chunk_index : phase_chunks_) {
+                run_chunk(chunk_index);
             }
         }
+        ran_chunks_.insert(ran_chunks_.end(), phase_chunks_.begin(), phase_chunks_.end());
     }
 
-    // Clear updated flags for next frame
-    world_.clear_updated_flags();
+    // Persons spawned during the phases get their final handles in chunk
+    // order, so handle numbers (stored in the cells) match for any thread count
+    std::sort(ran_chunks_.begin(), ran_chunks_.end());
+    AgentTable& agents = world_.agents();
+    for (uint32_t chunk_index : ran_chunks_) {
+        ++active_chunk_count_;
+        updated_cell_count_ += chunk_tasks_[chunk_index].updated_cells;
+        agents.commit(chunk_tasks_[chunk_index].agents, [&](int32_t x, int32_t y, AgentHandle handle) {
+            world_.get_cell(x, y).set_agent_handle(handle);
+        });
+    }
+    agents.end_spawns();
+
+    run_deferred_cells();
+}
+
+void Simulation::run_deferred_cells() {
+    for (uint32_t chunk_index : ran_chunks_) {
+        ChunkTask& task = chunk_tasks_[chunk_index];
+        for (const DeferredCell& deferred : task.deferred) {
+            // Skip cells that were displaced or consumed during the phases
+            const Cell& cell = world_.get_cell(deferred.x, deferred.y);
+            if (cell.material_id != deferred.material || cell.was_updated()) continue;
+
+            update_cell(deferred.x, deferred.y, deferred.material);
+
+            if (world_.get_cell(deferred.x, deferred.y).material_id != deferred.material) {
+                ++updated_cell_count_;
+                int32_t chunk_x = deferred.x / CHUNK_SIZE;
+                int32_t chunk_y = deferred.y / CHUNK_SIZE;
+                world_.activate_chunk(chunk_x, chunk_y);
+                world_.activate_chunk(chunk_x - 1, chunk_y);
+                world_.activate_chunk(chunk_x + 1, chunk_y);
+                world_.activate_chunk(chunk_x, chunk_y - 1);
+                world_.activate_chunk(chunk_x, chunk_y + 1);
+            }
+        }
+        task.deferred.clear();
+    }
+}
+
+void Simulation::load_kernel_row(int32_t base_x, int32_t world_y, uint8_t* row) const {
+    constexpr uint8_t WALL = static_cast<uint8_t>(MaterialID::Stone);
+
+    if (world_y < 0 || world_y >= world_.get_height()) {
+        std::fill(row, row + KERNEL_ROW_SIZE, WALL);
+        return;
+    }
+
+    // Middle 64 cells come straight from one chunk row
+    const Chunk* chunk = world_.get_chunk(base_x / CHUNK_SIZE, world_y / CHUNK_SIZE);
+    const Cell* cells = &chunk->cells[(world_y % CHUNK_SIZE) * CHUNK_SIZE];
+    uint8_t* middle = row + KERNEL_MARGIN;
+    int32_t lanes = std::min(CHUNK_SIZE, world_.get_width() - base_x);
+    for (int32_t i = 0; i < lanes; ++i) {
+        middle[i] = static_cast<uint8_t>(cells[i].material_id);
+    }
+    for (int32_t i = lanes; i < CHUNK_SIZE; ++i) {
+        middle[i] = WALL;
+    }
+
+    for (int32_t i = 0; i < KERNEL_MARGIN; ++i) {
+        row[i] = static_cast<uint8_t>(world_.get_material(base_x - KERNEL_MARGIN + i, world_y));
+        middle[CHUNK_SIZE + i] = static_cast<uint8_t>(world_.get_material(base_x + CHUNK_SIZE + i, world_y));
+    }
+}
+
+// Row kernel for rest detection. Per lane (one cell of the 64-wide chunk
+// row) a plain powder grain rests if all three cells below reject it (same
+// test as World::can_move_to, via density ranks) and none of its 8
+// neighbours can trigger its rule. A plain liquid rests under the same two
+// conditions when, in addition, no cell within its reach along the row is
+// Empty. A resting cell's rule would only reset its velocity (and maybe flip
+// water's flow direction); since that only depends on the materials the
+// kernel reads, the answer holds until World::unsettle_region says one of
+// them changed.
+uint64_t Simulation::find_resting_cells(int32_t base_x, int32_t world_y, int32_t lanes) const {
+    constexpr uint8_t EMPTY = static_cast<uint8_t>(MaterialID::Empty);
+    const auto& powder_bit = rest_tables_.powder_bit;
+    const auto& liquid_bit = rest_tables_.liquid_bit;
+
+    uint8_t mid[KERNEL_ROW_SIZE];
+    load_kernel_row(base_x, world_y, mid);
+
+    uint16_t any_candidate = 0;
+    for (int32_t i = KERNEL_MARGIN; i < KERNEL_MARGIN + lanes; ++i) {
+        any_candidate |= powder_bit[mid[i]] | liquid_bit[mid[i]];
+    }
+    if (any_candidate == 0) return 0;
+
+    uint8_t up[KERNEL_ROW_SIZE];
+    uint8_t down[KERNEL_ROW_SIZE];
+    load_kernel_row(base_x, world_y - 1, up);
+    load_kernel_row(base_x, world_y + 1, down);
+
+    // Translate ids once per cell, then work lane-parallel on small arrays.
+    // Powder bits sit in the low half of a trigger word, liquid bits in the
+    // high half.
+    auto trigger_bits = [&](uint8_t material) {
+        return static_cast<uint32_t>(rest_tables_.reacts_with[material]) |
+               static_cast<uint32_t>(rest_tables_.liquid_reacts_with[material]) << 16;
+    };
+    uint8_t sink[KERNEL_ROW_SIZE];
+    uint32_t react_up[KERNEL_ROW_SIZE];
+    uint32_t react_mid[KERNEL_ROW_SIZE];
+    uint32_t react_down[KERNEL_ROW_SIZE];
+    for (int32_t i = 0; i < KERNEL_ROW_SIZE; ++i) {
+        sink[i] = rest_tables_.sink_key[down[i]];
+        react_up[i] = trigger_bits(up[i]);
+        react_mid[i] = trigger_bits(mid[i]);
+        react_down[i] = trigger_bits(down[i]);
+    }
+
+    uint64_t resting = 0;
+    for (int32_t lane = 0; lane < lanes; ++lane) {
+        int32_t c = lane + KERNEL_MARGIN;
+        uint8_t material = mid[c];
+        uint32_t bit = powder_bit[material] | static_cast<uint32_t>(liquid_bit[material]) << 16;
+        uint8_t rank = rest_tables_.move_rank[material];
+
+        uint32_t triggers = react_up[c - 1] | react_up[c] | react_up[c + 1] |
+                            react_mid[c - 1] | react_mid[c + 1] |
+                            react_down[c - 1] | react_down[c] | react_down[c + 1];
+        bool blocked = sink[c - 1] >= rank && sink[c] >= rank && sink[c + 1] >= rank;
+
+        // Sideways spreading only enters Empty cells (0 reach for powders)
+        for (int32_t d = 1; d <= rest_tables_.liquid_reach[material]; ++d) {
+            blocked = blocked && mid[c - d] != EMPTY && mid[c + d] != EMPTY;
+        }
+
+        bool rests = bit != 0 && (triggers & bit) == 0 && blocked;
+        resting |= static_cast<uint64_t>(rests) << lane;
+    }
+    return resting;
 }
 
-void Simulation::update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y) {
+uint32_t Simulation::update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y,
+                                  std::vector<DeferredCell>* deferred) {
     bool chunk_had_movement = false;
+    bool all_resting = true;  // Every non-empty cell was skipped as resting
+    uint32_t updated_cells = 0;
 
     // Calculate world-space base coordinates for this chunk
     int32_t base_x = chunk_x * CHUNK_SIZE;
@@ -62,21 +345,51 @@ void Simulation::update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y) {
     for (int32_t local_y = max_local_y - 1; local_y >= 0; --local_y) {
         int32_t world_y = base_y + local_y;
 
+        // Recompute the row's rest mask if something near it changed. The
+        // stale bit is dropped first, so writes made while the row runs
+        // mark it again for next frame; World clears the bits of cells
+        // they affect right away.
+        const uint64_t* resting = &NO_RESTING_CELLS;
+        if (rest_detection_enabled_) {
+            uint64_t row_bit = 1ull << local_y;
+            if (chunk->stale_rows & row_bit) {
+                chunk->stale_rows &= ~row_bit;
+                chunk->resting[local_y] = find_resting_cells(base_x, world_y, max_local_x);
+            }
+            resting = &chunk->resting[local_y];
+        }
+
         if (scan_direction_) {
             for (int32_t local_x = 0; local_x < max_local_x; ++local_x) {
                 Cell& cell = chunk->cells[local_y * CHUNK_SIZE + local_x];
                 MaterialID material = cell.material_id;
 
-                // Skip empty and already-updated cells
-                if (material == MaterialID::Empty || cell.was_updated()) continue;
+                // Skip empty / inert and already-updated cells
+                if (is_inert_[static_cast<size_t>(material)]) continue;
+                if (cell.was_updated()) {
+                    all_resting = false;
+                    continue;
+                }
+
+                // Stuck until a neighbour changes: its rule would only
+                // reset velocity_y, so do that and skip it
+                if ((*resting >> local_x) & 1) {
+                    cell.velocity_y = 0;
+                    continue;
+                }
+                all_resting = false;
 
                 int32_t world_x = base_x + local_x;
+                if (deferred && is_wide_reach(material)) {
+                    deferred->push_back({world_x, world_y, material});
+                    continue;
+                }
                 update_cell(world_x, world_y, material);
 
                 // Check if cell changed
                 if (chunk->cells[local_y * CHUNK_SIZE + local_x].material_id != material) {
                     chunk_had_movement = true;
-                    ++updated_cell_count_;
+                    ++updated_cells;
                 }
             }
         } else {
@@ -84,14 +397,28 @@ void Simulation::update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y) {
                 Cell& cell = chunk->cells[local_y * CHUNK_SIZE + local_x];
                 MaterialID material = cell.material_id;
 
-                if (material == MaterialID::Empty || cell.was_updated()) continue;
+                if (is_inert_[static_cast<size_t>(material)]) continue;
+                if (cell.was_updated()) {
+                    all_resting = false;
+                    continue;
+                }
+
+                if ((*resting >> local_x) & 1) {
+                    cell.velocity_y = 0;
+                    continue;
+                }
+                all_resting = false;
 
                 int32_t world_x = base_x + local_x;
+                if (deferred && is_wide_reach(material)) {
+                    deferred->push_back({world_x, world_y, material});
+                    continue;
+                }
                 update_cell(world_x, world_y, material);
 
                 if (chunk->cells[local_y * CHUNK_SIZE + local_x].material_id != material) {
                     chunk_had_movement = true;
-                    ++updated_cell_count_;
+                    ++updated_cells;
                 }
             }
         }
@@ -107,560 +434,18 @@ void Simulation::update_chunk(Chunk* chunk, int32_t chunk_x, int32_t chunk_y) {
         world_.activate_chunk(chunk_x, chunk_y + 1);
     } else {
         ++chunk->sleep_counter;
-        if (chunk->sleep_counter >= CHUNK_SLEEP_THRESHOLD) {
+        uint32_t threshold = all_resting ? CHUNK_REST_SLEEP_THRESHOLD : CHUNK_SLEEP_THRESHOLD;
+        if (chunk->sleep_counter >= threshold) {
             chunk->is_active = false;
         }
     }
+
+    return updated_cells;
 }
 
 void Simulation::update_cell(int32_t x, int32_t y, MaterialID material) {
-    // Call the appropriate update function based on material type
-    switch (material) {
-        case MaterialID::Empty:
-            Materials::update_empty(world_, x, y);
-            break;
-
-        case MaterialID::Stone:
-            Materials::update_stone(world_, x, y);
-            break;
-
-        case MaterialID::Sand:
-            Materials::update_sand(world_, x, y);
-            break;
-
-        case MaterialID::Water:
-            Materials::update_water(world_, x, y);
-            break;
-
-        case MaterialID::Steam:
-            Materials::update_steam(world_, x, y);
-            break;
-
-        case MaterialID::Oil:
-            Materials::update_oil(world_, x, y);
-            break;
-
-        case MaterialID::Fire:
-            Materials::update_fire(world_, x, y);
-            break;
-
-        case MaterialID::Wood:
-            Materials::update_wood(world_, x, y);
-            break;
-
-        case MaterialID::Acid:
-            Materials::update_acid(world_, x, y);
-            break;
-
-        case MaterialID::Lava:
-            Materials::update_lava(world_, x, y);
-            break;
-
-        case MaterialID::Ash:
-            Materials::update_ash(world_, x, y);
-            break;
-
-        case MaterialID::Grass:
-            Materials::update_grass(world_, x, y);
-            break;
-
-        case MaterialID::Smoke:
-            Materials::update_smoke(world_, x, y);
-            break;
-
-        case MaterialID::Person:
-            Materials::update_person(world_, x, y);
-            break;
-
-        // ====== POWDERS (10-19) ======
-        case MaterialID::Dirt:
-            Materials::update_dirt(world_, x, y);
-            break;
-        case MaterialID::Gravel:
-            Materials::update_gravel(world_, x, y);
-            break;
-        case MaterialID::Snow:
-            Materials::update_snow(world_, x, y);
-            break;
-        case MaterialID::Gunpowder:
-            Materials::update_gunpowder(world_, x, y);
-            break;
-        case MaterialID::Salt:
-            Materials::update_salt(world_, x, y);
-            break;
-        case MaterialID::Coal:
-            Materials::update_coal(world_, x, y);
-            break;
-        case MaterialID::Rust:
-            Materials::update_rust(world_, x, y);
-            break;
-        case MaterialID::Sawdust:
-            Materials::update_sawdust(world_, x, y);
-            break;
-        case MaterialID::Glass_Powder:
-            Materials::update_glass_powder(world_, x, y);
-            break;
-
-        // ====== LIQUIDS (20-29) ======
-        case MaterialID::Honey:
-            Materials::update_honey(world_, x, y);
-            break;
-        case MaterialID::Mud:
-            Materials::update_mud(world_, x, y);
-            break;
-        case MaterialID::Blood:
-            Materials::update_blood(world_, x, y);
-            break;
-        case MaterialID::Poison:
-            Materials::update_poison(world_, x, y);
-            break;
-        case MaterialID::Slime:
-            Materials::update_slime(world_, x, y);
-            break;
-        case MaterialID::Milk:
-            Materials::update_milk(world_, x, y);
-            break;
-        case MaterialID::Alcohol:
-            Materials::update_alcohol(world_, x, y);
-            break;
-        case MaterialID::Mercury:
-            Materials::update_mercury(world_, x, y);
-            break;
-        case MaterialID::Petrol:
-            Materials::update_petrol(world_, x, y);
-            break;
-        case MaterialID::Glue:
-            Materials::update_glue(world_, x, y);
-            break;
-
-        // ====== GASES (30-39) ======
-        case MaterialID::Toxic_Gas:
-            Materials::update_toxic_gas(world_, x, y);
-            break;
-        case MaterialID::Hydrogen:
-            Materials::update_hydrogen(world_, x, y);
-            break;
-        case MaterialID::Helium:
-            Materials::update_helium(world_, x, y);
-            break;
-        case MaterialID::Methane:
-            Materials::update_methane(world_, x, y);
-            break;
-        case MaterialID::Spark:
-            Materials::update_spark(world_, x, y);
-            break;
-        case MaterialID::Plasma:
-            Materials::update_plasma(world_, x, y);
-            break;
-        case MaterialID::Dust:
-            Materials::update_dust(world_, x, y);
-            break;
-        case MaterialID::Spore:
-            Materials::update_spore(world_, x, y);
-            break;
-        case MaterialID::Confetti:
-            Materials::update_confetti(world_, x, y);
-            break;
-
-        // ====== SOLIDS (40-49) ======
-        case MaterialID::Metal:
-            Materials::update_metal(world_, x, y);
-            break;
-        case MaterialID::Gold:
-            Materials::update_gold(world_, x, y);
-            break;
-        case MaterialID::Ice:
-            Materials::update_ice(world_, x, y);
-            break;
-        case MaterialID::Glass:
-            Materials::update_glass(world_, x, y);
-            break;
-        case MaterialID::Brick:
-            Materials::update_brick(world_, x, y);
-            break;
-        case MaterialID::Obsidian:
-            Materials::update_obsidian(world_, x, y);
-            break;
-        case MaterialID::Diamond:
-            Materials::update_diamond(world_, x, y);
-            break;
-        case MaterialID::Copper:
-            Materials::update_copper(world_, x, y);
-            break;
-        case MaterialID::Rubber:
-            Materials::update_rubber(world_, x, y);
-            break;
-
-        // ====== ORGANIC (50-59) ======
-        case MaterialID::Leaf:
-            Materials::update_leaf(world_, x, y);
-            break;
-        case MaterialID::Moss:
-            Materials::update_moss(world_, x, y);
-            break;
-        case MaterialID::Vine:
-            Materials::update_vine(world_, x, y);
-            break;
-        case MaterialID::Fungus:
-            Materials::update_fungus(world_, x, y);
-            break;
-        case MaterialID::Seed:
-            Materials::update_seed(world_, x, y);
-            break;
-        case MaterialID::Flower:
-            Materials::update_flower(world_, x, y);
-            break;
-        case MaterialID::Algae:
-            Materials::update_algae(world_, x, y);
-            break;
-        case MaterialID::Coral:
-            Materials::update_coral(world_, x, y);
-            break;
-        case MaterialID::Wax:
-            Materials::update_wax(world_, x, y);
-            break;
-        case MaterialID::Flesh:
-            Materials::update_flesh(world_, x, y);
-            break;
-
-        // ====== SPECIAL (60-69) ======
-        case MaterialID::Clone:
-            Materials::update_clone(world_, x, y);
-            break;
-        case MaterialID::Void:
-            Materials::update_void(world_, x, y);
-            break;
-        case MaterialID::Fuse:
-            Materials::update_fuse(world_, x, y);
-            break;
-        case MaterialID::TNT:
-            Materials::update_tnt(world_, x, y);
-            break;
-        case MaterialID::C4:
-            Materials::update_c4(world_, x, y);
-            break;
-        case MaterialID::Firework:
-            Materials::update_firework(world_, x, y);
-            break;
-        case MaterialID::Lightning:
-            Materials::update_lightning(world_, x, y);
-            break;
-        case MaterialID::Portal_In:
-            Materials::update_portal_in(world_, x, y);
-            break;
-        case MaterialID::Portal_Out:
-            Materials::update_portal_out(world_, x, y);
-            break;
-
-        // ====== FANTASY (70-79) ======
-        case MaterialID::Magic:
-            Materials::update_magic(world_, x, y);
-            break;
-        case MaterialID::Crystal:
-            Materials::update_crystal(world_, x, y);
-            break;
-        case MaterialID::Ectoplasm:
-            Materials::update_ectoplasm(world_, x, y);
-            break;
-        case MaterialID::Antimatter:
-            Materials::update_antimatter(world_, x, y);
-            break;
-        case MaterialID::Fairy_Dust:
-            Materials::update_fairy_dust(world_, x, y);
-            break;
-        case MaterialID::Dragon_Fire:
-            Materials::update_dragon_fire(world_, x, y);
-            break;
-        case MaterialID::Frost:
-            Materials::update_frost(world_, x, y);
-            break;
-        case MaterialID::Ember:
-            Materials::update_ember(world_, x, y);
-            break;
-        case MaterialID::Stardust:
-            Materials::update_stardust(world_, x, y);
-            break;
-        case MaterialID::Void_Dust:
-            Materials::update_void_dust(world_, x, y);
-            break;
-        case MaterialID::Life:
-            Materials::update_life(world_, x, y);
-            break;
-
-        // ====== NEW POWDERS (81-85) ======
-        case MaterialID::Thermite_Powder:
-            Materials::update_thermite_powder(world_, x, y);
-            break;
-        case MaterialID::Sugar:
-            Materials::update_sugar(world_, x, y);
-            break;
-        case MaterialID::Iron_Filings:
-            Materials::update_iron_filings(world_, x, y);
-            break;
-        case MaterialID::Chalk:
-            Materials::update_chalk(world_, x, y);
-            break;
-        case MaterialID::Calcium:
-            Materials::update_calcium(world_, x, y);
-            break;
-
-        // ====== NEW LIQUIDS (86-90) ======
-        case MaterialID::Tar:
-            Materials::update_tar(world_, x, y);
-            break;
-        case MaterialID::Juice:
-            Materials::update_juice(world_, x, y);
-            break;
-        case MaterialID::Sap:
-            Materials::update_sap(world_, x, y);
-            break;
-        case MaterialID::Bleach:
-            Materials::update_bleach(world_, x, y);
-            break;
-        case MaterialID::Ink:
-            Materials::update_ink(world_, x, y);
-            break;
-
-        // ====== NEW GASES (91-93) ======
-        case MaterialID::Chlorine:
-            Materials::update_chlorine(world_, x, y);
-            break;
-        case MaterialID::Liquid_Nitrogen:
-            Materials::update_liquid_nitrogen(world_, x, y);
-            break;
-        case MaterialID::Oxygen:
-            Materials::update_oxygen(world_, x, y);
-            break;
-
-        // ====== NEW SOLIDS (94-97) ======
-        case MaterialID::Concrete:
-            Materials::update_concrete(world_, x, y);
-            break;
-        case MaterialID::Titanium:
-            Materials::update_titanium(world_, x, y);
-            break;
-        case MaterialID::Clay:
-            Materials::update_clay(world_, x, y);
-            break;
-        case MaterialID::Charcoal:
-            Materials::update_charcoal(world_, x, y);
-            break;
-
-        // ====== NEW ORGANIC (98-100) ======
-        case MaterialID::Bamboo:
-            Materials::update_bamboo(world_, x, y);
-            break;
-        case MaterialID::Honeycomb:
-            Materials::update_honeycomb(world_, x, y);
-            break;
-        case MaterialID::Bone:
-            Materials::update_bone(world_, x, y);
-            break;
-
-        // ====== NEW SPECIAL (101-102) ======
-        case MaterialID::Napalm:
-            Materials::update_napalm(world_, x, y);
-            break;
-        case MaterialID::Thermite:
-            Materials::update_thermite(world_, x, y);
-            break;
-
-        // ====== EXPANSION: BASIC (103-112) ======
-        case MaterialID::Bedrock:
-            Materials::update_bedrock(world_, x, y);
-            break;
-        case MaterialID::Ceramic:
-            Materials::update_ceramic(world_, x, y);
-            break;
-        case MaterialID::Granite:
-            Materials::update_granite(world_, x, y);
-            break;
-        case MaterialID::Marble:
-            Materials::update_marble(world_, x, y);
-            break;
-        case MaterialID::Sandstone:
-            Materials::update_sandstone(world_, x, y);
-            break;
-        case MaterialID::Limestone:
-            Materials::update_limestone(world_, x, y);
-            break;
-        case MaterialID::Slate:
-            Materials::update_slate(world_, x, y);
-            break;
-        case MaterialID::Basalt:
-            Materials::update_basalt(world_, x, y);
-            break;
-        case MaterialID::Quartz_Block:
-            Materials::update_quartz_block(world_, x, y);
-            break;
-        case MaterialID::Soil:
-            Materials::update_soil(world_, x, y);
-            break;
-
-        // ====== EXPANSION: POWDERS (113-117) ======
-        case MaterialID::Flour:
-            Materials::update_flour(world_, x, y);
-            break;
-        case MaterialID::Sulfur:
-            Materials::update_sulfur(world_, x, y);
-            break;
-        case MaterialID::Cement:
-            Materials::update_cement(world_, x, y);
-            break;
-        case MaterialID::Fertilizer:
-            Materials::update_fertilizer(world_, x, y);
-            break;
-        case MaterialID::Volcanic_Ash:
-            Materials::update_volcanic_ash(world_, x, y);
-            break;
-
-        // ====== EXPANSION: LIQUIDS (118-122) ======
-        case MaterialID::Brine:
-            Materials::update_brine(world_, x, y);
-            break;
-        case MaterialID::Coffee:
-            Materials::update_coffee(world_, x, y);
-            break;
-        case MaterialID::Soap:
-            Materials::update_soap(world_, x, y);
-            break;
-        case MaterialID::Paint:
-            Materials::update_paint(world_, x, y);
-            break;
-        case MaterialID::Sewage:
-            Materials::update_sewage(world_, x, y);
-            break;
-
-        // ====== EXPANSION: GASES (123-129) ======
-        case MaterialID::Ammonia:
-            Materials::update_ammonia(world_, x, y);
-            break;
-        case MaterialID::Carbon_Dioxide:
-            Materials::update_carbon_dioxide(world_, x, y);
-            break;
-        case MaterialID::Nitrous:
-            Materials::update_nitrous(world_, x, y);
-            break;
-        case MaterialID::Steam_Hot:
-            Materials::update_steam_hot(world_, x, y);
-            break;
-        case MaterialID::Miasma:
-            Materials::update_miasma(world_, x, y);
-            break;
-        case MaterialID::Pheromone:
-            Materials::update_pheromone(world_, x, y);
-            break;
-        case MaterialID::Nerve_Gas:
-            Materials::update_nerve_gas(world_, x, y);
-            break;
-
-        // ====== EXPANSION: SOLIDS (130-136) ======
-        case MaterialID::Silver:
-            Materials::update_silver(world_, x, y);
-            break;
-        case MaterialID::Platinum:
-            Materials::update_platinum(world_, x, y);
-            break;
-        case MaterialID::Lead:
-            Materials::update_lead(world_, x, y);
-            break;
-        case MaterialID::Tin:
-            Materials::update_tin(world_, x, y);
-            break;
-        case MaterialID::Zinc:
-            Materials::update_zinc(world_, x, y);
-            break;
-        case MaterialID::Bronze:
-            Materials::update_bronze(world_, x, y);
-            break;
-        case MaterialID::Steel:
-            Materials::update_steel(world_, x, y);
-            break;
-
-        // ====== EXPANSION: ORGANIC (137-143) ======
-        case MaterialID::Pollen:
-            Materials::update_pollen(world_, x, y);
-            break;
-        case MaterialID::Root:
-            Materials::update_root(world_, x, y);
-            break;
-        case MaterialID::Bark:
-            Materials::update_bark(world_, x, y);
-            break;
-        case MaterialID::Fruit:
-            Materials::update_fruit(world_, x, y);
-            break;
-        case MaterialID::Egg:
-            Materials::update_egg(world_, x, y);
-            break;
-        case MaterialID::Web:
-            Materials::update_web(world_, x, y);
-            break;
-        case MaterialID::Mucus:
-            Materials::update_mucus(world_, x, y);
-            break;
-
-        // ====== EXPANSION: SPECIAL (144-151) ======
-        case MaterialID::Bomb:
-            Materials::update_bomb(world_, x, y);
-            break;
-        case MaterialID::Nuke:
-            Materials::update_nuke(world_, x, y);
-            break;
-        case MaterialID::Laser:
-            Materials::update_laser(world_, x, y);
-            break;
-        case MaterialID::Black_Hole:
-            Materials::update_black_hole(world_, x, y);
-            break;
-        case MaterialID::White_Hole:
-            Materials::update_white_hole(world_, x, y);
-            break;
-        case MaterialID::Acid_Gas:
-            Materials::update_acid_gas(world_, x, y);
-            break;
-        case MaterialID::Ice_Bomb:
-            Materials::update_ice_bomb(world_, x, y);
-            break;
-        case MaterialID::Fire_Bomb:
-            Materials::update_fire_bomb(world_, x, y);
-            break;
-
-        // ====== EXPANSION: FANTASY (152-161) ======
-        case MaterialID::Mana:
-            Materials::update_mana(world_, x, y);
-            break;
-        case MaterialID::Mirage:
-            Materials::update_mirage(world_, x, y);
-            break;
-        case MaterialID::Holy_Water:
-            Materials::update_holy_water(world_, x, y);
-            break;
-        case MaterialID::Cursed:
-            Materials::update_cursed(world_, x, y);
-            break;
-        case MaterialID::Blessed:
-            Materials::update_blessed(world_, x, y);
-            break;
-        case MaterialID::Soul:
-            Materials::update_soul(world_, x, y);
-            break;
-        case MaterialID::Spirit:
-            Materials::update_spirit(world_, x, y);
-            break;
-        case MaterialID::Aether:
-            Materials::update_aether(world_, x, y);
-            break;
-        case MaterialID::Nether:
-            Materials::update_nether(world_, x, y);
-            break;
-        case MaterialID::Phoenix_Ash:
-            Materials::update_phoenix_ash(world_, x, y);
-            break;
-
-        default:
-            break;
-    }
+    // One indirect call through the table generated from Materials.def
+    Materials::UPDATE_FUNCTIONS[static_cast<size_t>(material)](world_, x, y);
 }
 
 } // namespace PixelEngine
@@ -0,0 +1,226 @@
+#include "TemperatureField.h"
+#include "World.h"
+#include <algorithm>
+#include <array>
+
+namespace PixelEngine {
+
+namespace {
+
+struct ThermalSource {
+    MaterialID material;
+    int16_t temperature;
+};
+
+// Hot materials hold their sample at least this warm, cold ones at most
+// this cold. Stays within ±4096 so the int16 stencil cannot overflow.
+constexpr ThermalSource THERMAL_SOURCES[] = {
+    {MaterialID::Fire, 400},
+    {MaterialID::Ember, 250},
+    {MaterialID::Lava, 1000},
+    {MaterialID::Dragon_Fire, 800},
+    {MaterialID::Plasma, 2500},
+    {MaterialID::Thermite, 2500},
+    {MaterialID::Frost, -40},
+    {MaterialID::Liquid_Nitrogen, -196},
+};
+
+// Materials whose rules read the field; their sleeping chunks are woken
+// once a sample reaches MELT_POINT (the lowest threshold)
+constexpr MaterialID HEAT_SENSITIVE[] = {
+    MaterialID::Ice,
+    MaterialID::Snow,
+    MaterialID::Wax,
+    MaterialID::Clay,
+    MaterialID::Honeycomb,
+};
+
+// Diffused heat loses 1/64 per step toward ambient
+constexpr int32_t COOLING_SHIFT = 6;
+
+const std::array<int16_t, static_cast<size_t>(MaterialID::COUNT)>& temperature_table() {
+    static const auto table = [] {
+        std::array<int16_t, static_cast<size_t>(MaterialID::COUNT)> t{};
+        for (const ThermalSource& source : THERMAL_SOURCES) {
+            t[static_cast<size_t>(source.material)] = source.temperature;
+        }
+        return t;
+    }();
+    return table;
+}
+
+} // namespace
+
+int16_t TemperatureField::get_material_temperature(MaterialID material) {
+    return temperature_table()[static_cast<size_t>(material)];
+}
+
+void TemperatureField::resize(int32_t width, int32_t height) {
+    width_ = width;
+    height_ = height;
+    samples_wide_ = (width + SAMPLE_SIZE - 1) >> SAMPLE_SHIFT;
+    samples_high_ = (height + SAMPLE_SIZE - 1) >> SAMPLE_SHIFT;
+    stride_ = samples_wide_ + 2;
+
+    size_t padded = static_cast<size_t>(stride_) * (samples_high_ + 2);
+    current_.assign(padded, 0);
+    next_.assign(padded, 0);
+    warm_row0_ = 0;
+    warm_row1_ = -1;
+    stale_row0_ = 0;
+    stale_row1_ = -1;
+
+    int32_t chunk_count = ((width + CHUNK_SIZE - 1) / CHUNK_SIZE) * ((height + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    chunk_marks_.assign(chunk_count, 0);
+    marked_chunks_.clear();
+}
+
+void TemperatureField::set_enabled(bool enabled) {
+    if (!enabled) clear();
+    enabled_ = enabled;
+}
+
+void TemperatureField::clear() {
+    std::fill(current_.begin(), current_.end(), 0);
+    std::fill(next_.begin(), next_.end(), 0);
+    warm_row0_ = 0;
+    warm_row1_ = -1;
+    stale_row0_ = 0;
+    stale_row1_ = -1;
+}
+
+void TemperatureField::step(World& world) {
+    if (!enabled_) return;
+    diffuse();
+    apply_sources(world);
+    wake_heated_chunks(world);
+}
+
+void TemperatureField::diffuse() {
+    if (warm_row0_ > warm_row1_) return;  // All ambient: nothing to spread
+
+    // Heat spreads one row per step; rows outside stay ambient in both grids
+    int32_t row0 = std::max(warm_row0_ - 1, 0);
+    int32_t row1 = std::min(warm_row1_ + 1, samples_high_ - 1);
+    int32_t new_row0 = samples_high_;
+    int32_t new_row1 = -1;
+
+    // next_ still holds an older step; clear its rows this step won't write
+    for (int32_t row = stale_row0_; row <= stale_row1_; ++row) {
+        if (row >= row0 && row <= row1) continue;
+        int16_t* out = &next_[static_cast<size_t>(row + 1) * stride_ + 1];
+        std::fill(out, out + samples_wide_, 0);
+    }
+
+    for (int32_t row = row0; row <= row1; ++row) {
+        const int16_t* up = &current_[static_cast<size_t>(row) * stride_ + 1];
+        const int16_t* mid = up + stride_;
+        const int16_t* down = mid + stride_;
+        int16_t* out = &next_[static_cast<size_t>(row + 1) * stride_ + 1];
+
+        // Weights 4/8 self, 1/8 per neighbour, then cooling; branch-free
+        // over int16 lanes so it vectorizes
+        int16_t any = 0;
+        for (int32_t i = 0; i < samples_wide_; ++i) {
+            int16_t avg = static_cast<int16_t>((4 * mid[i] + up[i] + down[i] + mid[i - 1] + mid[i + 1]) >> 3);
+            int16_t t = static_cast<int16_t>(avg - (avg >> COOLING_SHIFT));
+            out[i] = t;
+            any |= t;
+        }
+        if (any != 0) {
+            new_row0 = std::min(new_row0, row);
+            new_row1 = row;
+        }
+    }
+
+    current_.swap(next_);
+    stale_row0_ = warm_row0_;
+    stale_row1_ = warm_row1_;
+    warm_row0_ = new_row0;
+    warm_row1_ = new_row1;
+}
+
+void TemperatureField::apply_sources(World& world) {
+    const auto& table = temperature_table();
+    const MaterialCensus& census = world.census();
+    const int32_t chunks_wide = world.get_chunks_wide();
+
+    // Chunks holding any source or sink, in index order
+    marked_chunks_.clear();
+    for (const ThermalSource& source : THERMAL_SOURCES) {
+        census.for_each_chunk_with(source.material, [&](int32_t chunk_index) {
+            if (!chunk_marks_[chunk_index]) {
+                chunk_marks_[chunk_index] = 1;
+                marked_chunks_.push_back(chunk_index);
+            }
+        });
+    }
+    std::sort(marked_chunks_.begin(), marked_chunks_.end());
+
+    for (int32_t chunk_index : marked_chunks_) {
+        chunk_marks_[chunk_index] = 0;
+        int32_t chunk_x = chunk_index % chunks_wide;
+        int32_t chunk_y = chunk_index / chunks_wide;
+        const Chunk* chunk = world.get_chunk(chunk_x, chunk_y);
+
+        int32_t base_x = chunk_x * CHUNK_SIZE;
+        int32_t base_y = chunk_y * CHUNK_SIZE;
+        int32_t lanes = std::min(CHUNK_SIZE, width_ - base_x);
+        int32_t rows = std::min(CHUNK_SIZE, height_ - base_y);
+        for (int32_t local_y = 0; local_y < rows; ++local_y) {
+            const Cell* cells = &chunk->cells[local_y * CHUNK_SIZE];
+            int16_t* samples = &current_[static_cast<size_t>(((base_y + local_y) >> SAMPLE_SHIFT) + 1) * stride_ +
+                                         (base_x >> SAMPLE_SHIFT) + 1];
+            bool touched = false;
+            for (int32_t i = 0; i < lanes; ++i) {
+                int16_t t = table[static_cast<size_t>(cells[i].material_id)];
+                if (t == 0) continue;
+                int16_t& sample = samples[i >> SAMPLE_SHIFT];
+                sample = t > 0 ? std::max(sample, t) : std::min(sample, t);
+                touched = true;
+            }
+            if (touched) {
+                int32_t row = (base_y + local_y) >> SAMPLE_SHIFT;
+                if (warm_row0_ > warm_row1_) {
+                    warm_row0_ = warm_row1_ = row;
+                } else {
+                    warm_row0_ = std::min(warm_row0_, row);
+                    warm_row1_ = std::max(warm_row1_, row);
+                }
+            }
+        }
+    }
+}
+
+void TemperatureField::wake_heated_chunks(World& world) {
+    if (warm_row0_ > warm_row1_) return;
+
+    const MaterialCensus& census = world.census();
+    const int32_t chunks_wide = world.get_chunks_wide();
+    constexpr int32_t SAMPLES_PER_CHUNK = CHUNK_SIZE >> SAMPLE_SHIFT;
+
+    for (MaterialID material : HEAT_SENSITIVE) {
+        census.for_each_chunk_with(material, [&](int32_t chunk_index) {
+            int32_t chunk_x = chunk_index % chunks_wide;
+            int32_t chunk_y = chunk_index / chunks_wide;
+            Chunk* chunk = world.get_chunk(chunk_x, chunk_y);
+            if (chunk->is_active) return;
+
+            int32_t row0 = std::max(chunk_y * SAMPLES_PER_CHUNK, warm_row0_);
+            int32_t row1 = std::min((chunk_y + 1) * SAMPLES_PER_CHUNK, warm_row1_ + 1);
+            int32_t col0 = chunk_x * SAMPLES_PER_CHUNK;
+            int32_t col1 = std::min(col0 + SAMPLES_PER_CHUNK, samples_wide_);
+            for (int32_t row = row0; row < row1; ++row) {
+                const int16_t* samples = &current_[static_cast<size_t>(row + 1) * stride_ + 1];
+                for (int32_t col = col0; col < col1; ++col) {
+                    if (samples[col] >= MELT_POINT) {
+                        world.activate_chunk(chunk_x, chunk_y);
+                        return;
+                    }
+                }
+            }
+        });
+    }
+}
+
+} // namespace PixelEngine
@@ -0,0 +1,92 @@
+#include "ThreadPool.h"
+
+namespace PixelEngine {
+
+ThreadPool::ThreadPool(uint32_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+        if (thread_count == 0) thread_count = 1;
+    }
+
+    // The caller is one of the threads
+    workers_.reserve(thread_count - 1);
+    for (uint32_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run_indices(const std::function<void(uint32_t)>& fn, uint32_t count) {
+    for (;;) {
+        uint32_t index = next_index_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) break;
+        fn(index);
+    }
+}
+
+void ThreadPool::parallel_for(uint32_t count, const std::function<void(uint32_t)>& fn) {
+    if (count == 0) return;
+
+    // Nothing to share - run inline without touching the workers
+    if (workers_.empty() || count == 1) {
+        for (uint32_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        job_count_ = count;
+        next_index_.store(0, std::memory_order_relaxed);
+        active_workers_ = static_cast<uint32_t>(workers_.size());
+        ++job_generation_;
+    }
+    work_cv_.notify_all();
+
+    run_indices(fn, count);
+
+    // Wait for workers to drain their last indices
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return active_workers_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::worker_loop() {
+    uint64_t seen_generation = 0;
+
+    for (;;) {
+        const std::function<void(uint32_t)>* job;
+        uint32_t count;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [&]() { return stopping_ || job_generation_ != seen_generation; });
+            if (stopping_) return;
+            seen_generation = job_generation_;
+            job = job_;
+            count = job_count_;
+        }
+
+        run_indices(*job, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
+
+} // namespace PixelEngine
@@ -1,4 +1,5 @@
 #include "World.h"
+#include <algorithm>
 #include <cstring>
 #include <random>
 
@@ -8,7 +9,7 @@ World::World(int32_t width, int32_t height, MaterialSystem& material_system)
     : width_(width)
     , height_(height)
     , material_system_(material_system)
-    , rng_state_(std::random_device{}()) {
+    , rng_(std::random_device{}()) {
 
     // Calculate chunk grid dimensions
     chunks_wide_ = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
@@ -16,33 +17,20 @@ World::World(int32_t width, int32_t height, MaterialSystem& material_system)
 
     // Allocate chunks
     chunks_.resize(chunks_wide_ * chunks_high_);
-}
-
-Cell& World::get_cell(int32_t x, int32_t y) {
-    int32_t chunk_x = x / CHUNK_SIZE;
-    int32_t chunk_y = y / CHUNK_SIZE;
-    int32_t local_x = x % CHUNK_SIZE;
-    int32_t local_y = y % CHUNK_SIZE;
-
-    Chunk& chunk = chunks_[chunk_y * chunks_wide_ + chunk_x];
-    return chunk.get_cell(local_x, local_y);
-}
-
-const Cell& World::get_cell(int32_t x, int32_t y) const {
-    int32_t chunk_x = x / CHUNK_SIZE;
-    int32_t chunk_y = y / CHUNK_SIZE;
-    int32_t local_x = x % CHUNK_SIZE;
-    int32_t local_y = y % CHUNK_SIZE;
 
-    const Chunk& chunk = chunks_[chunk_y * chunks_wide_ + chunk_x];
-    return chunk.get_cell(local_x, local_y);
-}
-
-MaterialID World::get_material(int32_t x, int32_t y) const {
-    if (!in_bounds(x, y)) {
-        return MaterialID::Stone;  // Out of bounds = solid wall
-    }
-    return get_cell(x, y).material_id;
+    supers_wide_ = (chunks_wide_ + SUPER_CHUNK_SIZE - 1) >> SUPER_CHUNK_SHIFT;
+    supers_high_ = (chunks_high_ + SUPER_CHUNK_SIZE - 1) >> SUPER_CHUNK_SHIFT;
+    super_active_ = std::make_unique<std::atomic<uint8_t>[]>(supers_wide_ * supers_high_);
+    super_active_counts_.assign(supers_wide_ * supers_high_, 0);
+    stamp_marks_.assign(chunks_wide_ * chunks_high_, 0);
+
+    gravity_field_.resize(width, height);
+    temperature_field_.resize(width, height);
+    conductors_.resize(width, height);
+    census_.resize(chunks_wide_ * chunks_high_);
+    agents_.resize(width, height);
+    portal_registry_.resize(width, height);
+    reactions_.build();
 }
 
 void World::set_material(int32_t x, int32_t y, MaterialID material) {
@@ -50,12 +38,44 @@ void World::set_material(int32_t x, int32_t y, MaterialID material) {
         return;
     }
 
-    get_cell(x, y).material_id = material;
+    Cell& cell = get_cell(x, y);
+    MaterialID previous = cell.material_id;
+    cell.material_id = material;
+    census_.replace(world_to_chunk_index(x, y), previous, material);
     activate_chunk_at_position(x, y);
+    if (previous != material) {
+        unsettle_region(x, y, x, y);
+    }
 
-    // Notify callback when a non-empty material spawns (for Story Mode discovery)
-    if (material != MaterialID::Empty && material_spawn_callback_) {
-        material_spawn_callback_(material);
+    // Keep the portal registry current; a new portal starts on channel 0
+    if (previous != material &&
+        (PortalRegistry::is_portal(previous) || PortalRegistry::is_portal(material))) {
+        if (PortalRegistry::is_portal(previous)) {
+            portal_registry_.remove(x, y, previous, cell.get_lifetime(), !in_chunk_task());
+        }
+        if (PortalRegistry::is_portal(material)) {
+            cell.set_lifetime(0);
+            portal_registry_.add(x, y, material, 0, !in_chunk_task());
+        }
+    }
+
+    if (ConductorNetwork::is_conductor(previous) != ConductorNetwork::is_conductor(material)) {
+        conductors_.note_change(x, y);
+    }
+
+    // A Person cell written here is a new Person
+    if (previous == MaterialID::Person) {
+        agents_.despawn(resolve_agent(cell, x, y));
+        // Don't let the new material inherit the handle as velocity / lifetime
+        cell.set_agent_handle(0);
+    }
+    if (material == MaterialID::Person) {
+        cell.set_agent_handle(agents_.spawn(x, y));
+    }
+
+    // Report non-empty spawns for Story Mode discovery (collapsed per material)
+    if (material != MaterialID::Empty && discovery_events_enabled_) {
+        discovery_events_.push_material_spawned(material);
     }
 
     // Activate neighboring chunks if on chunk boundary
@@ -73,131 +93,288 @@ void World::set_material(int32_t x, int32_t y, MaterialID material) {
     }
 }
 
-bool World::can_move_to(int32_t x, int32_t y, int32_t new_x, int32_t new_y) const {
-    if (!in_bounds(new_x, new_y)) {
-        return false;
-    }
-
-    MaterialID current_material = get_material(x, y);
-    MaterialID target_material = get_material(new_x, new_y);
+void World::run_swap_hooks(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    Cell& cell1 = get_cell(x1, y1);
+    Cell& cell2 = get_cell(x2, y2);
 
-    // Can always move into empty space
-    if (target_material == MaterialID::Empty) {
-        return true;
+    // Let moved Persons' agents follow their cells
+    if (cell1.material_id == MaterialID::Person || cell2.material_id == MaterialID::Person) {
+        AgentHandle agent1 = cell1.material_id == MaterialID::Person ? resolve_agent(cell1, x2, y2) : AgentTable::INVALID;
+        AgentHandle agent2 = cell2.material_id == MaterialID::Person ? resolve_agent(cell2, x1, y1) : AgentTable::INVALID;
+        if (agent1 != AgentTable::INVALID) {
+            agents_.move(agent1, x1, y1);
+            cell1.set_agent_handle(agent1);
+        }
+        if (agent2 != AgentTable::INVALID) {
+            agents_.move(agent2, x2, y2);
+            cell2.set_agent_handle(agent2);
+        }
     }
 
-    // Get material properties
-    const auto& current_def = material_system_.get_material(current_material);
-    const auto& target_def = material_system_.get_material(target_material);
-
-    // Solids can't be displaced
-    if (target_def.state == MaterialState::Solid) {
-        return false;
+    // A portal was pushed around: re-register it (with its channel) at its
+    // new spot. Both old spots go first, so two swapped exits don't collide
+    if (PortalRegistry::is_portal(cell1.material_id) || PortalRegistry::is_portal(cell2.material_id)) {
+        bool in_order = !in_chunk_task();
+        if (PortalRegistry::is_portal(cell2.material_id)) {
+            portal_registry_.remove(x1, y1, cell2.material_id, cell2.get_lifetime(), in_order);
+        }
+        if (PortalRegistry::is_portal(cell1.material_id)) {
+            portal_registry_.remove(x2, y2, cell1.material_id, cell1.get_lifetime(), in_order);
+        }
+        if (PortalRegistry::is_portal(cell2.material_id)) {
+            portal_registry_.add(x2, y2, cell2.material_id, cell2.get_lifetime(), in_order);
+        }
+        if (PortalRegistry::is_portal(cell1.material_id)) {
+            portal_registry_.add(x1, y1, cell1.material_id, cell1.get_lifetime(), in_order);
+        }
     }
+}
 
-    // Denser materials displace lighter ones (when moving down)
-    if (new_y > y && current_def.density > target_def.density) {
-        return true;
-    }
+void World::set_portal_channel(int32_t x, int32_t y, uint8_t channel) {
+    if (!in_bounds(x, y)) return;
 
-    // Lighter materials (gases) displace heavier ones (when moving up)
-    if (new_y < y && current_def.density < target_def.density) {
-        return true;
-    }
+    Cell& cell = get_cell(x, y);
+    if (!PortalRegistry::is_portal(cell.material_id)) return;
 
-    return false;
+    channel &= PortalRegistry::CHANNEL_COUNT - 1;
+    if (cell.get_lifetime() == channel) return;
+    portal_registry_.remove(x, y, cell.material_id, cell.get_lifetime(), !in_chunk_task());
+    cell.set_lifetime(channel);
+    portal_registry_.add(x, y, cell.material_id, channel, !in_chunk_task());
 }
 
-bool World::try_move_cell(int32_t x, int32_t y, int32_t new_x, int32_t new_y) {
-    if (!can_move_to(x, y, new_x, new_y)) {
-        return false;
-    }
+AgentHandle World::get_agent(int32_t x, int32_t y) const {
+    if (!in_bounds(x, y)) return AgentTable::INVALID;
 
-    // Don't move if already updated this frame (prevents double-updates)
-    if (get_cell(x, y).was_updated()) {
-        return false;
-    }
-
-    swap_cells(x, y, new_x, new_y);
+    const Cell& cell = get_cell(x, y);
+    return cell.material_id == MaterialID::Person ? resolve_agent(cell, x, y) : AgentTable::INVALID;
+}
 
-    // Mark as updated
-    get_cell(new_x, new_y).mark_updated();
+AgentHandle World::resolve_agent(const Cell& cell, int32_t x, int32_t y) const {
+    AgentHandle handle = cell.get_agent_handle();
+    if (agents_.is_at(handle, x, y)) return handle;
+    // Some rule overwrote the cell's velocity / lifetime bits; ask the hash
+    return agents_.find_at(x, y);
+}
 
-    // Activate destination chunk
-    activate_chunk_at_position(new_x, new_y);
+uint8_t World::get_portal_channel(int32_t x, int32_t y) const {
+    if (!in_bounds(x, y)) return 0;
 
-    return true;
+    const Cell& cell = get_cell(x, y);
+    return PortalRegistry::is_portal(cell.material_id) ? cell.get_lifetime() : 0;
 }
 
-void World::swap_cells(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
-    Cell& cell1 = get_cell(x1, y1);
-    Cell& cell2 = get_cell(x2, y2);
+uint32_t World::refresh_super_chunks() {
+    uint32_t active_supers = 0;
+    for (int32_t super_y = 0; super_y < supers_high_; ++super_y) {
+        for (int32_t super_x = 0; super_x < supers_wide_; ++super_x) {
+            int32_t super_index = super_y * supers_wide_ + super_x;
+            if (!super_active_[super_index].load(std::memory_order_relaxed)) continue;
+
+            uint8_t active = 0;
+            int32_t first_x = super_x << SUPER_CHUNK_SHIFT;
+            int32_t first_y = super_y << SUPER_CHUNK_SHIFT;
+            for (int32_t chunk_y = first_y; chunk_y < std::min(first_y + SUPER_CHUNK_SIZE, chunks_high_); ++chunk_y) {
+                for (int32_t chunk_x = first_x; chunk_x < std::min(first_x + SUPER_CHUNK_SIZE, chunks_wide_); ++chunk_x) {
+                    active += chunks_[chunk_y * chunks_wide_ + chunk_x].is_active ? 1 : 0;
+                }
+            }
 
-    // Swap entire cell contents (material_id, flags, velocity_y)
-    // This preserves all per-cell state like health, lifetime, direction
-    Cell temp = cell1;
-    cell1 = cell2;
-    cell2 = temp;
+            super_active_counts_[super_index] = active;
+            if (active == 0) {
+                super_active_[super_index].store(0, std::memory_order_relaxed);
+            } else {
+                ++active_supers;
+            }
+        }
+    }
+    return active_supers;
 }
 
-Chunk* World::get_chunk(int32_t chunk_x, int32_t chunk_y) {
-    if (chunk_x < 0 || chunk_x >= chunks_wide_ ||
-        chunk_y < 0 || chunk_y >= chunks_high_) {
-        return nullptr;
+void World::activate_region(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y) {
+    unsettle_region(min_x, min_y, max_x, max_y);
+
+    min_x = std::max(min_x - 1, 0);
+    min_y = std::max(min_y - 1, 0);
+    max_x = std::min(max_x + 1, width_ - 1);
+    max_y = std::min(max_y + 1, height_ - 1);
+    if (min_x > max_x || min_y > max_y) return;
+
+    for (int32_t chunk_y = min_y / CHUNK_SIZE; chunk_y <= max_y / CHUNK_SIZE; ++chunk_y) {
+        for (int32_t chunk_x = min_x / CHUNK_SIZE; chunk_x <= max_x / CHUNK_SIZE; ++chunk_x) {
+            activate_chunk(chunk_x, chunk_y);
+        }
     }
-    return &chunks_[chunk_y * chunks_wide_ + chunk_x];
 }
 
-const Chunk* World::get_chunk(int32_t chunk_x, int32_t chunk_y) const {
-    if (chunk_x < 0 || chunk_x >= chunks_wide_ ||
-        chunk_y < 0 || chunk_y >= chunks_high_) {
-        return nullptr;
+void World::stamp_spans(std::vector<RowSpan>& spans, MaterialID material, uint8_t lifetime, int8_t velocity_y) {
+    // Clip, then merge overlapping and touching spans of a row
+    size_t kept = 0;
+    for (const RowSpan& span : spans) {
+        RowSpan clipped = {span.y, std::max(span.x0, 0), std::min(span.x1, width_ - 1)};
+        if (clipped.y >= 0 && clipped.y < height_ && clipped.x0 <= clipped.x1) {
+            spans[kept++] = clipped;
+        }
+    }
+    spans.resize(kept);
+    if (spans.empty()) return;
+
+    std::sort(spans.begin(), spans.end(), [](const RowSpan& a, const RowSpan& b) {
+        return a.y < b.y || (a.y == b.y && a.x0 < b.x0);
+    });
+    kept = 0;
+    for (size_t i = 1; i < spans.size(); ++i) {
+        RowSpan& last = spans[kept];
+        if (spans[i].y == last.y && spans[i].x0 <= last.x1 + 1) {
+            last.x1 = std::max(last.x1, spans[i].x1);
+        } else {
+            spans[++kept] = spans[i];
+        }
+    }
+    spans.resize(kept + 1);
+
+    auto has_registry_state = [](MaterialID m) {
+        return m == MaterialID::Person || PortalRegistry::is_portal(m);
+    };
+    const bool registered = has_registry_state(material);
+
+    for (const RowSpan& span : spans) {
+        for_each_row_span(span.y, span.x0, span.x1, [&](Cell* cells, int32_t count, int32_t first_x) {
+            int32_t chunk_index = world_to_chunk_index(first_x, span.y);
+            for (int32_t i = 0; i < count; ++i) {
+                Cell& cell = cells[i];
+                MaterialID previous = cell.material_id;
+                if (registered || has_registry_state(previous)) {
+                    // Rare: set_material despawns / registers; the registry
+                    // owns a Person's or portal's state bits
+                    set_material(first_x + i, span.y, material);
+                    if (registered) continue;
+                } else {
+                    cell.material_id = material;
+                    census_.replace(chunk_index, previous, material);
+                    if (ConductorNetwork::is_conductor(previous) != ConductorNetwork::is_conductor(material)) {
+                        conductors_.note_change(first_x + i, span.y);
+                    }
+                }
+                cell.flags = 0;
+                cell.set_lifetime(lifetime);
+                cell.velocity_y = velocity_y;
+            }
+        });
+
+        // The unsettled rectangle covers the one-cell margin activate_region
+        // wakes; collect its chunks and wake each once below
+        int32_t min_x = span.x0, min_y = span.y, max_x = span.x1, max_y = span.y;
+        if (!clear_rest_state(min_x, min_y, max_x, max_y)) continue;
+        for (int32_t chunk_y = min_y / CHUNK_SIZE; chunk_y <= max_y / CHUNK_SIZE; ++chunk_y) {
+            for (int32_t chunk_x = min_x / CHUNK_SIZE; chunk_x <= max_x / CHUNK_SIZE; ++chunk_x) {
+                int32_t chunk_index = chunk_y * chunks_wide_ + chunk_x;
+                if (!stamp_marks_[chunk_index]) {
+                    stamp_marks_[chunk_index] = 1;
+                    stamp_chunks_.push_back(chunk_index);
+                }
+            }
+        }
     }
-    return &chunks_[chunk_y * chunks_wide_ + chunk_x];
-}
 
-void World::activate_chunk(int32_t chunk_x, int32_t chunk_y) {
-    Chunk* chunk = get_chunk(chunk_x, chunk_y);
-    if (chunk) {
-        chunk->is_active = true;
-        chunk->sleep_counter = 0;
+    for (int32_t chunk_index : stamp_chunks_) {
+        stamp_marks_[chunk_index] = 0;
+        activate_chunk(chunk_index % chunks_wide_, chunk_index / chunks_wide_);
+    }
+    stamp_chunks_.clear();
+
+    if (material != MaterialID::Empty && discovery_events_enabled_) {
+        discovery_events_.push_material_spawned(material);
     }
 }
 
-void World::activate_chunk_at_position(int32_t world_x, int32_t world_y) {
-    if (!in_bounds(world_x, world_y)) {
-        return;
+// Bits first..last of a 64-bit mask (0 <= first <= last <= 63)
+static inline uint64_t bit_span(int32_t first, int32_t last) {
+    return (~0ull >> (63 - last)) & (~0ull << first);
+}
+
+void World::unsettle_region(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y) {
+    if (!clear_rest_state(min_x, min_y, max_x, max_y)) return;
+
+    for (int32_t chunk_y = min_y / CHUNK_SIZE; chunk_y <= max_y / CHUNK_SIZE; ++chunk_y) {
+        for (int32_t chunk_x = min_x / CHUNK_SIZE; chunk_x <= max_x / CHUNK_SIZE; ++chunk_x) {
+            activate_chunk(chunk_x, chunk_y);
+        }
     }
-    int32_t chunk_x = world_x / CHUNK_SIZE;
-    int32_t chunk_y = world_y / CHUNK_SIZE;
-    activate_chunk(chunk_x, chunk_y);
 }
 
-void World::clear_updated_flags() {
-    for (auto& chunk : chunks_) {
-        if (!chunk.is_active) {
-            continue;
+bool World::clear_rest_state(int32_t& min_x, int32_t& min_y, int32_t& max_x, int32_t& max_y) {
+    min_x = std::max(min_x - Materials::REST_KERNEL_REACH, 0);
+    min_y = std::max(min_y - 1, 0);
+    max_x = std::min(max_x + Materials::REST_KERNEL_REACH, width_ - 1);
+    max_y = std::min(max_y + 1, height_ - 1);
+    if (min_x > max_x || min_y > max_y) return false;
+
+    for (int32_t chunk_y = min_y / CHUNK_SIZE; chunk_y <= max_y / CHUNK_SIZE; ++chunk_y) {
+        int32_t base_y = chunk_y * CHUNK_SIZE;
+        int32_t row0 = std::max(min_y, base_y) - base_y;
+        int32_t row1 = std::min(max_y, base_y + CHUNK_SIZE - 1) - base_y;
+
+        for (int32_t chunk_x = min_x / CHUNK_SIZE; chunk_x <= max_x / CHUNK_SIZE; ++chunk_x) {
+            int32_t base_x = chunk_x * CHUNK_SIZE;
+            uint64_t lanes = bit_span(std::max(min_x, base_x) - base_x,
+                                      std::min(max_x, base_x + CHUNK_SIZE - 1) - base_x);
+
+            Chunk& chunk = chunks_[chunk_y * chunks_wide_ + chunk_x];
+            for (int32_t row = row0; row <= row1; ++row) {
+                chunk.resting[row] &= ~lanes;
+            }
+            chunk.stale_rows |= bit_span(row0, row1);
         }
+    }
+    return true;
+}
 
+void World::clear_updated_flags() {
+    for_each_active_chunk(false, false, [](int32_t, int32_t, Chunk& chunk) {
         for (int32_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i) {
             chunk.cells[i].clear_updated();
         }
-    }
+    });
 }
 
 void World::clear_world() {
-    // Clear all chunks - O(active chunks) operation
+    // Every portal goes; drop them in one pass rather than cell by cell
+    portal_registry_.clear();
+
+    // Clear all chunks - O(occupied chunks) operation
     for (auto& chunk : chunks_) {
-        // Only clear active chunks for performance
-        if (chunk.is_active) {
+        // Only clear chunks that hold something, for performance (settled
+        // chunks sleep, so activity alone is not enough)
+        int32_t chunk_index = static_cast<int32_t>(&chunk - chunks_.data());
+        if (chunk.is_active ||
+            census_.get_chunk_count(chunk_index, MaterialID::Empty) != CHUNK_SIZE * CHUNK_SIZE) {
             for (int32_t i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i) {
+                const Cell& cell = chunk.cells[i];
+                int32_t x = (chunk_index % chunks_wide_) * CHUNK_SIZE + i % CHUNK_SIZE;
+                int32_t y = (chunk_index / chunks_wide_) * CHUNK_SIZE + i / CHUNK_SIZE;
+                if (cell.material_id == MaterialID::Person) {
+                    agents_.despawn(resolve_agent(cell, x, y));
+                }
                 chunk.cells[i] = Cell(MaterialID::Empty);
             }
+            census_.reset_chunk(chunk_index);
         }
         // Deactivate all chunks
         chunk.is_active = false;
         chunk.sleep_counter = 0;
+        std::fill(std::begin(chunk.resting), std::end(chunk.resting), 0);
+        chunk.stale_rows = ~0ull;
     }
+    for (int32_t super_index = 0; super_index < supers_wide_ * supers_high_; ++super_index) {
+        super_active_[super_index].store(0, std::memory_order_relaxed);
+        super_active_counts_[super_index] = 0;
+    }
+
+    build_jobs_.clear();
+    gravity_field_.clear();
+    temperature_field_.clear();
+    conductors_.clear();
 }
 
 void World::generate_color_buffer(uint32_t* buffer, uint32_t background_color) const {
@@ -0,0 +1,363 @@
+#include "WorldFarm.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace PixelEngine {
+
+WorldFarm::WorldFarm(int32_t world_count, int32_t width, int32_t height, uint32_t thread_count)
+    : pool_(thread_count) {
+    slots_.reserve(world_count);
+    for (int32_t i = 0; i < world_count; ++i) {
+        slots_.push_back(std::make_unique<Slot>(width, height));
+    }
+}
+
+uint32_t WorldFarm::derive_seed(uint32_t base_seed, int32_t index) {
+    // splitmix-style scramble so neighbouring indices get unrelated streams
+    uint64_t z = (static_cast<uint64_t>(base_seed) << 32) + static_cast<uint32_t>(index) + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    uint32_t seed = static_cast<uint32_t>(z);
+    return seed != 0 ? seed : 1;
+}
+
+void WorldFarm::load(uint32_t base_seed) {
+    pool_.parallel_for(static_cast<uint32_t>(slots_.size()), [&](uint32_t i) {
+        Slot& slot = *slots_[i];
+        slot.seed = derive_seed(base_seed, static_cast<int32_t>(i));
+        slot.world.clear_world();
+        slot.world.seed_rng(slot.seed);
+        if (scene_loader_) {
+            scene_loader_(slot.world, slot.seed, static_cast<int32_t>(i));
+        }
+    });
+}
+
+void WorldFarm::step(uint32_t frames) {
+    pool_.parallel_for(static_cast<uint32_t>(slots_.size()), [&](uint32_t i) {
+        Slot& slot = *slots_[i];
+        for (uint32_t f = 0; f < frames; ++f) {
+            slot.simulation.update();
+        }
+    });
+}
+
+void WorldFarm::emit_outputs() {
+    if (!output_hook_) return;
+    pool_.parallel_for(static_cast<uint32_t>(slots_.size()), [&](uint32_t i) {
+        const Slot& slot = *slots_[i];
+        output_hook_(slot.world, slot.simulation, static_cast<int32_t>(i));
+    });
+}
+
+void WorldFarm::run(uint32_t base_seed, uint32_t frames) {
+    load(base_seed);
+    step(frames);
+    emit_outputs();
+}
+
+// ============================================================================
+// BUILT-IN SCENES
+// ============================================================================
+
+namespace {
+
+// Small local PRNG for scene layout (kept separate from the world's stream)
+struct SceneRng {
+    uint32_t state;
+    explicit SceneRng(uint32_t seed) : state(seed != 0 ? seed : 1) {}
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    int32_t range(int32_t lo, int32_t hi) {  // [lo, hi]
+        return lo + static_cast<int32_t>(next() % static_cast<uint32_t>(hi - lo + 1));
+    }
+};
+
+void fill_rect(World& world, int32_t x0, int32_t y0, int32_t x1, int32_t y1, MaterialID material) {
+    for (int32_t y = y0; y <= y1; ++y) {
+        for (int32_t x = x0; x <= x1; ++x) {
+            world.set_material(x, y, material);
+        }
+    }
+}
+
+void fill_disc(World& world, int32_t cx, int32_t cy, int32_t radius, MaterialID material) {
+    for (int32_t dy = -radius; dy <= radius; ++dy) {
+        for (int32_t dx = -radius; dx <= radius; ++dx) {
+            if (dx * dx + dy * dy <= radius * radius) {
+                world.set_material(cx + dx, cy + dy, material);
+            }
+        }
+    }
+}
+
+void scene_empty(World& world, uint32_t seed, int32_t index) {
+    (void)world; (void)seed; (void)index;
+}
+
+// Stone floor, a sand dump and a water pool
+void scene_sand_pile(World& world, uint32_t seed, int32_t index) {
+    (void)index;
+    SceneRng rng(seed);
+    int32_t w = world.get_width();
+    int32_t h = world.get_height();
+
+    fill_rect(world, 0, h - 8, w - 1, h - 1, MaterialID::Stone);
+
+    int32_t dump_x = rng.range(w / 5, w / 2);
+    int32_t dump_w = rng.range(w / 10, w / 4);
+    fill_rect(world, dump_x, h / 8, dump_x + dump_w, h / 8 + rng.range(h / 8, h / 3), MaterialID::Sand);
+
+    int32_t pool_x = rng.range(w / 2 + 20, w - w / 5);
+    fill_rect(world, pool_x, h / 3, std::min(w - 1, pool_x + rng.range(40, 120)), h / 3 + 40, MaterialID::Water);
+}
+
+// Ground with a handful of Life particles that turn into villagers
+void scene_village(World& world, uint32_t seed, int32_t index) {
+    (void)index;
+    SceneRng rng(seed);
+    int32_t w = world.get_width();
+    int32_t h = world.get_height();
+
+    int32_t ground = h - rng.range(40, 80);
+    fill_rect(world, 0, ground, w - 1, h - 1, MaterialID::Dirt);
+    fill_rect(world, 0, ground, w - 1, ground + 2, MaterialID::Grass);
+
+    int32_t people = rng.range(4, 12);
+    for (int32_t i = 0; i < people; ++i) {
+        world.set_material(rng.range(10, w - 10), rng.range(10, ground / 2), MaterialID::Life);
+    }
+}
+
+// Random blobs of random materials - exercises as many rules as possible
+void scene_fuzz(World& world, uint32_t seed, int32_t index) {
+    (void)index;
+    SceneRng rng(seed);
+    int32_t w = world.get_width();
+    int32_t h = world.get_height();
+    int32_t max_id = static_cast<int32_t>(MaterialID::COUNT) - 1;
+
+    int32_t blobs = rng.range(20, 60);
+    for (int32_t i = 0; i < blobs; ++i) {
+        MaterialID material = static_cast<MaterialID>(rng.range(1, max_id));
+        fill_disc(world, rng.range(0, w - 1), rng.range(0, h - 1), rng.range(2, 18), material);
+    }
+}
+
+struct SceneEntry {
+    const char* name;
+    void (*loader)(World& world, uint32_t seed, int32_t index);
+};
+
+const SceneEntry SCENES[] = {
+    {"empty", scene_empty},
+    {"sand_pile", scene_sand_pile},
+    {"village", scene_village},
+    {"fuzz", scene_fuzz},
+};
+
+} // namespace
+
+WorldFarm::SceneLoader WorldFarm::find_scene(const std::string& name) {
+    for (const auto& scene : SCENES) {
+        if (name == scene.name) {
+            return scene.loader;
+        }
+    }
+    return SceneLoader();
+}
+
+std::vector<std::string> WorldFarm::get_scene_names() {
+    std::vector<std::string> names;
+    for (const auto& scene : SCENES) {
+        names.push_back(scene.name);
+    }
+    return names;
+}
+
+bool WorldFarm::write_ppm_thumbnail(const World& world, const std::string& path,
+                                    int32_t scale, uint32_t background_color) {
+    if (scale < 1) scale = 1;
+
+    int32_t w = world.get_width();
+    int32_t h = world.get_height();
+    std::vector<uint32_t> pixels(static_cast<size_t>(w) * h);
+    world.generate_color_buffer(pixels.data(), background_color);
+
+    int32_t tw = w / scale;
+    int32_t th = h / scale;
+    if (tw == 0 || th == 0) return false;
+
+    // Box filter each scale×scale block (RGBA8 packed as r | g<<8 | b<<16)
+    std::vector<uint8_t> rgb(static_cast<size_t>(tw) * th * 3);
+    for (int32_t ty = 0; ty < th; ++ty) {
+        for (int32_t tx = 0; tx < tw; ++tx) {
+            uint32_t sum_r = 0, sum_g = 0, sum_b = 0;
+            for (int32_t sy = 0; sy < scale; ++sy) {
+                const uint32_t* row = pixels.data() + static_cast<size_t>(ty * scale + sy) * w + tx * scale;
+                for (int32_t sx = 0; sx < scale; ++sx) {
+                    uint32_t p = row[sx];
+                    sum_r += p & 0xFF;
+                    sum_g += (p >> 8) & 0xFF;
+                    sum_b += (p >> 16) & 0xFF;
+                }
+            }
+            uint32_t n = static_cast<uint32_t>(scale * scale);
+            uint8_t* out = rgb.data() + (static_cast<size_t>(ty) * tw + tx) * 3;
+            out[0] = static_cast<uint8_t>(sum_r / n);
+            out[1] = static_cast<uint8_t>(sum_g / n);
+            out[2] = static_cast<uint8_t>(sum_b / n);
+        }
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::fprintf(file, "P6\n%d %d\n255\n", tw, th);
+    bool ok = std::fwrite(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    std::fclose(file);
+    return ok;
+}
+
+// ============================================================================
+// COMMAND LINE
+// ============================================================================
+
+static void print_farm_usage() {
+    std::cout << "Usage: PixelEngine --farm <worlds> [options]\n"
+              << "  --frames <n>       Simulation steps per world (default 600)\n"
+              << "  --seed <n>         Base seed; world i uses a derived seed (default 1)\n"
+              << "  --scene <name>     Scene loader (default sand_pile)\n"
+              << "  --threads <n>      Worker threads, 0 = all cores (default 0)\n"
+              << "  --size <w>x<h>     World size (default " << WORLD_WIDTH << "x" << WORLD_HEIGHT << ")\n"
+              << "  --out <dir>        Write a PPM thumbnail per world into <dir>\n"
+              << "  --thumb-scale <n>  Thumbnail downscale factor (default 4)\n"
+              << "Scenes:";
+    for (const auto& name : WorldFarm::get_scene_names()) {
+        std::cout << " " << name;
+    }
+    std::cout << "\n";
+}
+
+int run_world_farm_cli(int argc, char* argv[]) {
+    int32_t world_count = 0;
+    uint32_t frames = 600;
+    uint32_t base_seed = 1;
+    uint32_t thread_count = 0;
+    int32_t width = WORLD_WIDTH;
+    int32_t height = WORLD_HEIGHT;
+    int32_t thumb_scale = 4;
+    std::string scene_name = "sand_pile";
+    std::string out_dir;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0) {
+            print_farm_usage();
+            return 0;
+        }
+        if (!value) {
+            std::cerr << "Missing value for " << arg << "\n";
+            print_farm_usage();
+            return 1;
+        }
+
+        if (std::strcmp(arg, "--farm") == 0) {
+            world_count = std::atoi(value);
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            base_seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--scene") == 0) {
+            scene_name = value;
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            thread_count = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (std::strcmp(arg, "--size") == 0) {
+            if (std::sscanf(value, "%dx%d", &width, &height) != 2) {
+                std::cerr << "Invalid --size (expected WxH): " << value << "\n";
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--out") == 0) {
+            out_dir = value;
+        } else if (std::strcmp(arg, "--thumb-scale") == 0) {
+            thumb_scale = std::atoi(value);
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            print_farm_usage();
+            return 1;
+        }
+        ++i;  // Consumed the value
+    }
+
+    if (world_count <= 0 || width <= 0 || height <= 0) {
+        print_farm_usage();
+        return 1;
+    }
+
+    WorldFarm::SceneLoader scene = WorldFarm::find_scene(scene_name);
+    if (!scene) {
+        std::cerr << "Unknown scene: " << scene_name << "\n";
+        print_farm_usage();
+        return 1;
+    }
+
+    if (!out_dir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(out_dir, ec);
+        if (ec) {
+            std::cerr << "Failed to create output directory " << out_dir << ": " << ec.message() << "\n";
+            return 1;
+        }
+    }
+
+    WorldFarm farm(world_count, width, height, thread_count);
+    farm.set_scene_loader(scene);
+
+    std::vector<uint8_t> write_failed(world_count, 0);
+    if (!out_dir.empty()) {
+        farm.set_output_hook([&](const World& world, const Simulation&, int32_t index) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "world_%05d.ppm", index);
+            std::string path = (std::filesystem::path(out_dir) / name).string();
+            if (!WorldFarm::write_ppm_thumbnail(world, path, thumb_scale)) {
+                write_failed[index] = 1;
+            }
+        });
+    }
+
+    std::cout << "World farm: " << world_count << " worlds (" << width << "x" << height
+              << "), scene '" << scene_name << "', " << frames << " frames, "
+              << farm.get_thread_count() << " threads\n";
+
+    auto start = std::chrono::steady_clock::now();
+    farm.run(base_seed, frames);
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    int failures = 0;
+    for (int32_t i = 0; i < world_count; ++i) {
+        if (write_failed[i]) {
+            std::cerr << "Failed to write thumbnail for world " << i << "\n";
+            ++failures;
+        }
+    }
+
+    std::cout << "Done in " << seconds << "s ("
+              << (seconds > 0.0 ? (static_cast<double>(world_count) * frames) / seconds : 0.0)
+              << " world-frames/s)\n";
+
+    return failures == 0 ? 0 : 1;
+}
+
+} // namespace PixelEngine
@@ -5,7 +5,12 @@
 #include "MetalRenderer.h"
 #include "GameMode.h"
 #include "DiscoverySystem.h"
+#include "WorldFarm.h"
+#include "MaterialBench.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <cmath>
@@ -25,230 +30,88 @@ struct MaterialCategory {
     bool is_open;  // Runtime state - whether dropdown is expanded
 };
 
-// Category: Basic
-static const MaterialEntry BASIC_MATERIALS[] = {
-    {MaterialID::Sand, "Sand"},
-    {MaterialID::Water, "Water"},
-    {MaterialID::Stone, "Stone"},
-    {MaterialID::Steam, "Steam"},
-    {MaterialID::Oil, "Oil"},
-    {MaterialID::Fire, "Fire"},
-    {MaterialID::Wood, "Wood"},
-    {MaterialID::Acid, "Acid"},
-    {MaterialID::Lava, "Lava"},
-    {MaterialID::Grass, "Grass"},
-    {MaterialID::Bedrock, "Bedrock"},
-    {MaterialID::Ceramic, "Ceramic"},
-    {MaterialID::Granite, "Granite"},
-    {MaterialID::Marble, "Marble"},
-    {MaterialID::Sandstone, "Sandstone"},
-    {MaterialID::Limestone, "Limestone"},
-    {MaterialID::Slate, "Slate"},
-    {MaterialID::Basalt, "Basalt"},
-    {MaterialID::Quartz_Block, "Quartz"},
-    {MaterialID::Soil, "Soil"},
-};
-
-// Category: Powders
-static const MaterialEntry POWDER_MATERIALS[] = {
-    {MaterialID::Ash, "Ash"},
-    {MaterialID::Dirt, "Dirt"},
-    {MaterialID::Gravel, "Gravel"},
-    {MaterialID::Snow, "Snow"},
-    {MaterialID::Gunpowder, "Gunpowder"},
-    {MaterialID::Salt, "Salt"},
-    {MaterialID::Coal, "Coal"},
-    {MaterialID::Rust, "Rust"},
-    {MaterialID::Sawdust, "Sawdust"},
-    {MaterialID::Glass_Powder, "Glass Pwdr"},
-    {MaterialID::Thermite_Powder, "Thermite P"},
-    {MaterialID::Sugar, "Sugar"},
-    {MaterialID::Iron_Filings, "Iron Files"},
-    {MaterialID::Chalk, "Chalk"},
-    {MaterialID::Calcium, "Calcium"},
-    {MaterialID::Flour, "Flour"},
-    {MaterialID::Sulfur, "Sulfur"},
-    {MaterialID::Cement, "Cement"},
-    {MaterialID::Fertilizer, "Fertilizer"},
-    {MaterialID::Volcanic_Ash, "Volc Ash"},
-};
+// Entries of one palette category in slot order, from Materials.def
+template <PaletteCategory Category>
+constexpr auto make_palette() {
+    constexpr size_t count = std::count(std::begin(Materials::MATERIAL_PALETTE),
+                                        std::end(Materials::MATERIAL_PALETTE), Category);
+    constexpr auto entries = [] {
+        std::array<MaterialEntry, count> out{};
+        for (size_t id = 0; id < std::size(Materials::MATERIAL_PALETTE); ++id) {
+            if (Materials::MATERIAL_PALETTE[id] != Category) continue;
+            size_t slot = static_cast<size_t>(Materials::MATERIAL_PALETTE_SLOT[id]);
+            if (slot < count) out[slot] = {static_cast<MaterialID>(id), Materials::MATERIAL_LABELS[id]};
+        }
+        return out;
+    }();
+    static_assert(std::all_of(entries.begin(), entries.end(), [](const MaterialEntry& e) { return e.name != nullptr; }),
+                  "palette slots of a category must be 0..count-1, each used once");
+    return entries;
+}
 
-// Category: Liquids
-static const MaterialEntry LIQUID_MATERIALS[] = {
-    {MaterialID::Honey, "Honey"},
-    {MaterialID::Mud, "Mud"},
-    {MaterialID::Blood, "Blood"},
-    {MaterialID::Poison, "Poison"},
-    {MaterialID::Slime, "Slime"},
-    {MaterialID::Milk, "Milk"},
-    {MaterialID::Alcohol, "Alcohol"},
-    {MaterialID::Mercury, "Mercury"},
-    {MaterialID::Petrol, "Petrol"},
-    {MaterialID::Glue, "Glue"},
-    {MaterialID::Tar, "Tar"},
-    {MaterialID::Juice, "Juice"},
-    {MaterialID::Sap, "Sap"},
-    {MaterialID::Bleach, "Bleach"},
-    {MaterialID::Ink, "Ink"},
-    {MaterialID::Brine, "Brine"},
-    {MaterialID::Coffee, "Coffee"},
-    {MaterialID::Soap, "Soap"},
-    {MaterialID::Paint, "Paint"},
-    {MaterialID::Sewage, "Sewage"},
-};
+static constexpr auto BASIC_MATERIALS = make_palette<PaletteCategory::Basic>();
+static constexpr auto POWDER_MATERIALS = make_palette<PaletteCategory::Powders>();
+static constexpr auto LIQUID_MATERIALS = make_palette<PaletteCategory::Liquids>();
+static constexpr auto GAS_MATERIALS = make_palette<PaletteCategory::Gases>();
+static constexpr auto SOLID_MATERIALS = make_palette<PaletteCategory::Solids>();
+static constexpr auto ORGANIC_MATERIALS = make_palette<PaletteCategory::Organic>();
+static constexpr auto SPECIAL_MATERIALS = make_palette<PaletteCategory::Special>();
+static constexpr auto FANTASY_MATERIALS = make_palette<PaletteCategory::Fantasy>();
 
-// Category: Gases
-static const MaterialEntry GAS_MATERIALS[] = {
-    {MaterialID::Smoke, "Smoke"},
-    {MaterialID::Toxic_Gas, "Toxic Gas"},
-    {MaterialID::Hydrogen, "Hydrogen"},
-    {MaterialID::Helium, "Helium"},
-    {MaterialID::Methane, "Methane"},
-    {MaterialID::Spark, "Spark"},
-    {MaterialID::Plasma, "Plasma"},
-    {MaterialID::Dust, "Dust"},
-    {MaterialID::Spore, "Spore"},
-    {MaterialID::Confetti, "Confetti"},
-    {MaterialID::Chlorine, "Chlorine"},
-    {MaterialID::Liquid_Nitrogen, "Liq Nitro"},
-    {MaterialID::Oxygen, "Oxygen"},
-    {MaterialID::Ammonia, "Ammonia"},
-    {MaterialID::Carbon_Dioxide, "CO2"},
-    {MaterialID::Nitrous, "Nitrous"},
-    {MaterialID::Steam_Hot, "Hot Steam"},
-    {MaterialID::Miasma, "Miasma"},
-    {MaterialID::Pheromone, "Pheromone"},
-    {MaterialID::Nerve_Gas, "Nerve Gas"},
-};
+static const int NUM_CATEGORIES = 8;
 
-// Category: Solids
-static const MaterialEntry SOLID_MATERIALS[] = {
-    {MaterialID::Metal, "Metal"},
-    {MaterialID::Gold, "Gold"},
-    {MaterialID::Ice, "Ice"},
-    {MaterialID::Glass, "Glass"},
-    {MaterialID::Brick, "Brick"},
-    {MaterialID::Obsidian, "Obsidian"},
-    {MaterialID::Diamond, "Diamond"},
-    {MaterialID::Copper, "Copper"},
-    {MaterialID::Rubber, "Rubber"},
-    {MaterialID::Concrete, "Concrete"},
-    {MaterialID::Titanium, "Titanium"},
-    {MaterialID::Clay, "Clay"},
-    {MaterialID::Charcoal, "Charcoal"},
-    {MaterialID::Silver, "Silver"},
-    {MaterialID::Platinum, "Platinum"},
-    {MaterialID::Lead, "Lead"},
-    {MaterialID::Tin, "Tin"},
-    {MaterialID::Zinc, "Zinc"},
-    {MaterialID::Bronze, "Bronze"},
-    {MaterialID::Steel, "Steel"},
-};
+static uint32_t g_frame_counter = 0;
 
-// Category: Organic
-static const MaterialEntry ORGANIC_MATERIALS[] = {
-    {MaterialID::Leaf, "Leaf"},
-    {MaterialID::Moss, "Moss"},
-    {MaterialID::Vine, "Vine"},
-    {MaterialID::Fungus, "Fungus"},
-    {MaterialID::Seed, "Seed"},
-    {MaterialID::Flower, "Flower"},
-    {MaterialID::Algae, "Algae"},
-    {MaterialID::Coral, "Coral"},
-    {MaterialID::Wax, "Wax"},
-    {MaterialID::Flesh, "Flesh"},
-    {MaterialID::Bamboo, "Bamboo"},
-    {MaterialID::Honeycomb, "Honeycomb"},
-    {MaterialID::Bone, "Bone"},
-    {MaterialID::Pollen, "Pollen"},
-    {MaterialID::Root, "Root"},
-    {MaterialID::Bark, "Bark"},
-    {MaterialID::Fruit, "Fruit"},
-    {MaterialID::Egg, "Egg"},
-    {MaterialID::Web, "Web"},
-    {MaterialID::Mucus, "Mucus"},
-};
+// ============================================================================
+// OVERLAY STAMPS - people / Life sprites as precomputed pixel offsets
+// ============================================================================
 
-// Category: Special
-static const MaterialEntry SPECIAL_MATERIALS[] = {
-    {MaterialID::Life, "Life"},       // Spawns people when landing safely
-    {MaterialID::Clone, "Clone"},
-    {MaterialID::Void, "Void"},
-    {MaterialID::Fuse, "Fuse"},
-    {MaterialID::TNT, "TNT"},
-    {MaterialID::C4, "C4"},
-    {MaterialID::Firework, "Firework"},
-    {MaterialID::Lightning, "Lightning"},
-    {MaterialID::Portal_In, "Portal In"},
-    {MaterialID::Portal_Out, "Portal Out"},
-    {MaterialID::Napalm, "Napalm"},
-    {MaterialID::Thermite, "Thermite"},
-    {MaterialID::Bomb, "Bomb"},
-    {MaterialID::Nuke, "Nuke"},
-    {MaterialID::Laser, "Laser"},
-    {MaterialID::Black_Hole, "Black Hole"},
-    {MaterialID::White_Hole, "White Hole"},
-    {MaterialID::Acid_Gas, "Acid Gas"},
-    {MaterialID::Ice_Bomb, "Ice Bomb"},
-    {MaterialID::Fire_Bomb, "Fire Bomb"},
+struct StampPixel {
+    int8_t dx, dy;
+    int32_t offset;  // dy * WORLD_WIDTH + dx
 };
 
-// Category: Fantasy
-static const MaterialEntry FANTASY_MATERIALS[] = {
-    {MaterialID::Magic, "Magic"},
-    {MaterialID::Crystal, "Crystal"},
-    {MaterialID::Ectoplasm, "Ectoplasm"},
-    {MaterialID::Antimatter, "Antimatter"},
-    {MaterialID::Fairy_Dust, "Fairy Dust"},
-    {MaterialID::Dragon_Fire, "Dragon Fire"},
-    {MaterialID::Frost, "Frost"},
-    {MaterialID::Ember, "Ember"},
-    {MaterialID::Stardust, "Stardust"},
-    {MaterialID::Void_Dust, "Void Dust"},
-    {MaterialID::Mana, "Mana"},
-    {MaterialID::Mirage, "Mirage"},
-    {MaterialID::Holy_Water, "Holy Water"},
-    {MaterialID::Cursed, "Cursed"},
-    {MaterialID::Blessed, "Blessed"},
-    {MaterialID::Soul, "Soul"},
-    {MaterialID::Spirit, "Spirit"},
-    {MaterialID::Aether, "Aether"},
-    {MaterialID::Nether, "Nether"},
-    {MaterialID::Phoenix_Ash, "PhoenixAsh"},
-};
+static constexpr StampPixel stamp_pixel(int8_t dx, int8_t dy) {
+    return {dx, dy, dy * WORLD_WIDTH + dx};
+}
 
-#define ARRAY_COUNT(arr) (sizeof(arr) / sizeof(arr[0]))
+// Every stamp fits in [-STAMP_REACH, STAMP_REACH] around its anchor
+static constexpr int32_t STAMP_REACH = 2;
 
-static const int NUM_CATEGORIES = 8;
+static constexpr StampPixel PERSON_BODY_STAMP[] = {
+    stamp_pixel(0, 0), stamp_pixel(1, 0), stamp_pixel(0, 1), stamp_pixel(1, 1)
+};
 
-// Global pointer for discovery system callbacks (C-style function pointers can't capture)
-static DiscoverySystem* g_discovery_system_ptr = nullptr;
-static uint32_t g_frame_counter = 0;
+static constexpr StampPixel PERSON_OUTLINE_STAMP[] = {
+    stamp_pixel(-1, -1), stamp_pixel(0, -1), stamp_pixel(1, -1), stamp_pixel(2, -1),
+    stamp_pixel(-1, 0), stamp_pixel(2, 0),
+    stamp_pixel(-1, 1), stamp_pixel(2, 1),
+    stamp_pixel(-1, 2), stamp_pixel(0, 2), stamp_pixel(1, 2), stamp_pixel(2, 2)
+};
 
-// Callback functions for Material.cpp discovery hooks
-static void discovery_callback(MaterialID mat_a, MaterialID mat_b,
-                               MaterialID result_a, MaterialID result_b,
-                               uint32_t frame_number) {
-    if (g_discovery_system_ptr) {
-        g_discovery_system_ptr->on_combination_occurred(mat_a, mat_b, result_a, result_b, frame_number);
-    }
-}
+static constexpr StampPixel LIFE_GLOW_STAMP[] = {
+    stamp_pixel(-1, -1), stamp_pixel(0, -1), stamp_pixel(1, -1),
+    stamp_pixel(-1, 0), stamp_pixel(1, 0),
+    stamp_pixel(-1, 1), stamp_pixel(0, 1), stamp_pixel(1, 1)
+};
 
-static bool material_unlock_checker(MaterialID id) {
-    if (g_discovery_system_ptr) {
-        return g_discovery_system_ptr->is_material_unlocked(id);
-    }
-    return true;  // If no discovery system, allow all materials
-}
+enum class PersonMood : uint8_t {
+    Healthy,
+    Injured,
+    Dying,
+    Swimming,
+    Panicking,
+    COUNT
+};
 
-// Safety net callback: unlock any material that spawns in the world
-// This catches materials created by reactions we might have missed in the combination list
-static void material_spawn_callback(MaterialID id) {
-    if (g_discovery_system_ptr && !g_discovery_system_ptr->is_material_unlocked(id)) {
-        // Unlock and show popup for auto-discovered materials
-        g_discovery_system_ptr->unlock_with_popup(id, g_frame_counter);
-    }
-}
+// {body, outline} per mood
+static constexpr uint32_t PERSON_MOOD_COLORS[static_cast<size_t>(PersonMood::COUNT)][2] = {
+    {0xFFFF00FF, 0xFFFFFFFF},  // Healthy: bright magenta, white outline
+    {0xFFFFFF00, 0xFFFFAA00},  // Injured: yellow, orange outline
+    {0xFF800000, 0xFFFF0000},  // Dying: dark red, red outline
+    {0xFF00FFFF, 0xFF0080FF},  // Swimming: cyan, blue outline
+    {0xFFFF6000, 0xFFFF0000},  // Panicking (fire / lava): orange-red, red outline
+};
 
 // Application class - ties everything together
 class PixelEngineApp {
@@ -276,15 +139,24 @@ public:
 
         pixel_buffer_.resize(WORLD_WIDTH * WORLD_HEIGHT);
 
+        // Spread chunk updates over every hardware thread
+        simulation_.set_thread_count(0);
+
+        // Let pools and basins settle in bulk
+        simulation_.set_liquid_leveling_enabled(true);
+
+        // Heat spreads through the temperature field
+        simulation_.set_temperature_enabled(true);
+
         // Initialize categories array
-        categories_[0] = {"Basic", BASIC_MATERIALS, (int)ARRAY_COUNT(BASIC_MATERIALS)};
-        categories_[1] = {"Powders", POWDER_MATERIALS, (int)ARRAY_COUNT(POWDER_MATERIALS)};
-        categories_[2] = {"Liquids", LIQUID_MATERIALS, (int)ARRAY_COUNT(LIQUID_MATERIALS)};
-        categories_[3] = {"Gases", GAS_MATERIALS, (int)ARRAY_COUNT(GAS_MATERIALS)};
-        categories_[4] = {"Solids", SOLID_MATERIALS, (int)ARRAY_COUNT(SOLID_MATERIALS)};
-        categories_[5] = {"Organic", ORGANIC_MATERIALS, (int)ARRAY_COUNT(ORGANIC_MATERIALS)};
-        categories_[6] = {"Special", SPECIAL_MATERIALS, (int)ARRAY_COUNT(SPECIAL_MATERIALS)};
-        categories_[7] = {"Fantasy", FANTASY_MATERIALS, (int)ARRAY_COUNT(FANTASY_MATERIALS)};
+        categories_[0] = {"Basic", BASIC_MATERIALS.data(), (int)BASIC_MATERIALS.size()};
+        categories_[1] = {"Powders", POWDER_MATERIALS.data(), (int)POWDER_MATERIALS.size()};
+        categories_[2] = {"Liquids", LIQUID_MATERIALS.data(), (int)LIQUID_MATERIALS.size()};
+        categories_[3] = {"Gases", GAS_MATERIALS.data(), (int)GAS_MATERIALS.size()};
+        categories_[4] = {"Solids", SOLID_MATERIALS.data(), (int)SOLID_MATERIALS.size()};
+        categories_[5] = {"Organic", ORGANIC_MATERIALS.data(), (int)ORGANIC_MATERIALS.size()};
+        categories_[6] = {"Special", SPECIAL_MATERIALS.data(), (int)SPECIAL_MATERIALS.size()};
+        categories_[7] = {"Fantasy", FANTASY_MATERIALS.data(), (int)FANTASY_MATERIALS.size()};
     }
 
     bool initialize() {
@@ -352,6 +224,31 @@ private:
 
     std::vector<uint32_t> pixel_buffer_;
 
+    // People drawn this frame (reused so the overlay never allocates)
+    struct OverlayPerson {
+        int16_t x, y;
+        PersonMood mood;
+        bool facing_right;
+    };
+    std::vector<OverlayPerson> overlay_people_;
+
+    // Flood fill seeds and editor stamp spans (reused across edits)
+    std::vector<std::pair<int32_t, int32_t>> fill_stack_;
+    std::vector<uint8_t> fill_visited_;  // Per cell, all clear between fills
+    std::vector<RowSpan> stamp_spans_;
+
+    // Brush stroke: half width per brush row, per-row extents of the
+    // segment being swept, this update's mouse samples and the last
+    // painted position while a button stays down
+    std::vector<int32_t> brush_profile_;
+    std::vector<int32_t> stroke_row_min_;
+    std::vector<int32_t> stroke_row_max_;
+    std::vector<MouseSample> stroke_samples_;
+    bool stroke_active_ = false;
+    int32_t stroke_x_ = 0;
+    int32_t stroke_y_ = 0;
+    GameMode last_input_mode_ = GameMode::MainMenu;
+
     float accumulator_;
     uint64_t frame_count_;
     float fps_timer_;
@@ -371,6 +268,7 @@ private:
     // Game mode and discovery system
     GameState game_state_;
     DiscoverySystem discovery_system_;
+    MaterialBitset reaction_filter_;  // Unlocked set the world's reaction table was built from
 
     // Material favorites bar (max 6 slots)
     static constexpr int MAX_FAVORITES = 6;
@@ -390,7 +288,7 @@ private:
         if (favorites_count_ >= MAX_FAVORITES) return false;
         if (is_favorite(mat)) return false;
         favorites_[favorites_count_++] = mat;
-        std::cout << "Added " << find_material_name(mat) << " to favorites\n";
+        std::cout << "Added " << get_material_name(mat) << " to favorites\n";
         return true;
     }
 
@@ -403,7 +301,7 @@ private:
                     favorites_[j] = favorites_[j + 1];
                 }
                 favorites_count_--;
-                std::cout << "Removed " << find_material_name(mat) << " from favorites\n";
+                std::cout << "Removed " << get_material_name(mat) << " from favorites\n";
                 return true;
             }
         }
@@ -454,7 +352,6 @@ private:
             while (accumulator_ >= effective_timestep && updates < max_updates) {
                 // Update frame counter for discovery system
                 g_frame_counter++;
-                set_current_frame(g_frame_counter);
 
                 simulation_.update();
                 accumulator_ -= effective_timestep;
@@ -472,7 +369,10 @@ private:
 
         // Check for new discoveries in story mode
         if (game_state_.current_mode == GameMode::StoryMode) {
+            // Apply combinations and spawns queued by the simulation this frame
+            discovery_system_.drain_events(world_.discovery_events(), g_frame_counter);
             check_discoveries();
+            sync_reaction_filter();
         }
 
         // FPS counter (always update)
@@ -494,6 +394,13 @@ private:
         }
     }
 
+    // Recompile the world's reactions when discoveries changed the unlocked set
+    void sync_reaction_filter() {
+        if (discovery_system_.get_unlocked_materials() == reaction_filter_) return;
+        reaction_filter_ = discovery_system_.get_unlocked_materials();
+        world_.set_reaction_filter(&reaction_filter_);
+    }
+
     void check_discoveries() {
         // Process any new discoveries from the discovery system
         while (discovery_system_.has_new_discovery()) {
@@ -533,18 +440,31 @@ private:
         return height;
     }
 
-    // Helper to place a single cell of material
-    void place_material_cell(int32_t x, int32_t y, MaterialID material) {
-        if (world_.in_bounds(x, y)) {
-            Cell& cell = world_.get_cell(x, y);
-            cell.flags = 0;
-            cell.velocity_y = 0;
-            world_.set_material(x, y, material);
+    // Over the material panel (right) or the brush palette (left), where
+    // clicks and strokes don't paint
+    bool is_over_ui(int32_t x, int32_t y, int ui_height) const {
+        return (x >= UI_PANEL_X - 5 && y <= ui_height + 10) ||
+               (x <= BRUSH_PANEL_X + BRUSH_PANEL_WIDTH + 5 && y <= 240);
+    }
+
+    // Queue a (2 * half + 1)² square of cells for stamping
+    void push_square_spans(int32_t x, int32_t y, int32_t half) {
+        for (int32_t ty = -half; ty <= half; ty++) {
+            stamp_spans_.push_back({y + ty, x - half, x + half});
         }
     }
 
-    // Draw a line of material using Bresenham's algorithm with thickness
-    void draw_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, MaterialID material, int32_t thickness = 3) {
+    // Queue the spans swept by a brush moved along the Bresenham line
+    // (x0, y0) -> (x1, y1). profile[r + dy] is the brush's half width on
+    // row dy (r = profile.size() / 2). Steps are at most one cell, so every
+    // row the stroke touches is a single run: one span per row.
+    void push_stroke_spans(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const std::vector<int32_t>& profile) {
+        int32_t r = static_cast<int32_t>(profile.size()) / 2;
+        int32_t top = std::min(y0, y1) - r;
+        int32_t rows = std::abs(y1 - y0) + 2 * r + 1;
+        stroke_row_min_.assign(rows, INT32_MAX);
+        stroke_row_max_.assign(rows, INT32_MIN);
+
         int32_t dx = std::abs(x1 - x0);
         int32_t dy = std::abs(y1 - y0);
         int32_t sx = (x0 < x1) ? 1 : -1;
@@ -552,11 +472,11 @@ private:
         int32_t err = dx - dy;
 
         while (true) {
-            // Draw a thick point at current position
-            for (int32_t ty = -thickness/2; ty <= thickness/2; ty++) {
-                for (int32_t tx = -thickness/2; tx <= thickness/2; tx++) {
-                    place_material_cell(x0 + tx, y0 + ty, material);
-                }
+            for (int32_t ty = -r; ty <= r; ty++) {
+                int32_t row = y0 + ty - top;
+                int32_t half = profile[ty + r];
+                stroke_row_min_[row] = std::min(stroke_row_min_[row], x0 - half);
+                stroke_row_max_[row] = std::max(stroke_row_max_[row], x0 + half);
             }
 
             if (x0 == x1 && y0 == y1) break;
@@ -571,6 +491,32 @@ private:
                 y0 += sy;
             }
         }
+
+        for (int32_t row = 0; row < rows; row++) {
+            if (stroke_row_min_[row] <= stroke_row_max_[row]) {
+                stamp_spans_.push_back({top + row, stroke_row_min_[row], stroke_row_max_[row]});
+            }
+        }
+    }
+
+    // Half width per row of a brush: a disc (dx² + dy² <= r²) or a square
+    void build_brush_profile(int32_t radius, BrushShape shape, std::vector<int32_t>& profile) {
+        profile.resize(2 * radius + 1);
+        for (int32_t dy = -radius; dy <= radius; dy++) {
+            int32_t half = radius;
+            if (shape == BrushShape::Circle) {
+                while (half * half + dy * dy > radius * radius) --half;
+            }
+            profile[dy + radius] = half;
+        }
+    }
+
+    // Draw a line of material using Bresenham's algorithm with thickness
+    void draw_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, MaterialID material, int32_t thickness = 3) {
+        build_brush_profile(thickness / 2, BrushShape::Square, brush_profile_);
+        stamp_spans_.clear();
+        push_stroke_spans(x0, y0, x1, y1, brush_profile_);
+        world_.stamp_spans(stamp_spans_, material);
     }
 
     // Draw a rectangle (filled or outline)
@@ -580,30 +526,25 @@ private:
         int32_t top = std::min(y0, y1);
         int32_t bottom = std::max(y0, y1);
 
+        stamp_spans_.clear();
         if (filled) {
             for (int32_t y = top; y <= bottom; y++) {
-                for (int32_t x = left; x <= right; x++) {
-                    place_material_cell(x, y, material);
-                }
+                stamp_spans_.push_back({y, left, right});
             }
         } else {
-            // Draw outline with thickness
+            // Outline with thickness: full rows at the top and bottom, two
+            // short runs per row for the sides
             int32_t thickness = 2;
-            // Top and bottom edges
-            for (int32_t x = left; x <= right; x++) {
-                for (int32_t t = 0; t < thickness; t++) {
-                    place_material_cell(x, top + t, material);
-                    place_material_cell(x, bottom - t, material);
-                }
-            }
-            // Left and right edges
             for (int32_t y = top; y <= bottom; y++) {
-                for (int32_t t = 0; t < thickness; t++) {
-                    place_material_cell(left + t, y, material);
-                    place_material_cell(right - t, y, material);
+                if (y - top < thickness || bottom - y < thickness) {
+                    stamp_spans_.push_back({y, left, right});
+                } else {
+                    stamp_spans_.push_back({y, left, left + thickness - 1});
+                    stamp_spans_.push_back({y, right - thickness + 1, right});
                 }
             }
         }
+        world_.stamp_spans(stamp_spans_, material);
     }
 
     // Draw an ellipse (filled or outline) using midpoint algorithm
@@ -619,6 +560,7 @@ private:
             return;
         }
 
+        stamp_spans_.clear();
         if (filled) {
             // Filled ellipse - scan each row
             for (int32_t y = -ry; y <= ry; y++) {
@@ -629,9 +571,7 @@ private:
                 float xf = std::sqrt(1.0f - yf * yf);
                 int32_t xExtent = static_cast<int32_t>(xf * rx);
 
-                for (int32_t x = -xExtent; x <= xExtent; x++) {
-                    place_material_cell(cx + x, cy + y, material);
-                }
+                stamp_spans_.push_back({cy + y, cx - xExtent, cx + xExtent});
             }
         } else {
             // Outline ellipse using parametric approach
@@ -641,45 +581,63 @@ private:
                 float angle = 2.0f * 3.14159f * i / steps;
                 int32_t x = cx + static_cast<int32_t>(rx * std::cos(angle));
                 int32_t y = cy + static_cast<int32_t>(ry * std::sin(angle));
-                for (int32_t ty = -thickness/2; ty <= thickness/2; ty++) {
-                    for (int32_t tx = -thickness/2; tx <= thickness/2; tx++) {
-                        place_material_cell(x + tx, y + ty, material);
-                    }
-                }
+                push_square_spans(x, y, thickness / 2);
             }
         }
+        world_.stamp_spans(stamp_spans_, material);
     }
 
-    // Flood fill algorithm
+    // Scanline flood fill: grows each seed into its full row run of the
+    // target material, marks the run visited and seeds one cell per run on
+    // the rows above and below. The runs are written by one stamp_spans
+    // call, which wakes each touched chunk once.
     void flood_fill(int32_t x, int32_t y, MaterialID fill_material) {
         if (!world_.in_bounds(x, y)) return;
 
         MaterialID target_material = world_.get_material(x, y);
         if (target_material == fill_material) return;  // Already the fill color
 
-        // Use a stack-based flood fill to avoid recursion depth issues
-        std::vector<std::pair<int32_t, int32_t>> stack;
-        stack.push_back({x, y});
+        const int32_t width = world_.get_width();
+        fill_visited_.resize(static_cast<size_t>(width) * world_.get_height(), 0);
+        auto open = [&](int32_t cx, int32_t cy) {
+            return world_.in_bounds(cx, cy) && !fill_visited_[static_cast<size_t>(cy) * width + cx] &&
+                   world_.get_material(cx, cy) == target_material;
+        };
+
+        stamp_spans_.clear();
+        fill_stack_.clear();
+        fill_stack_.push_back({x, y});
 
-        int max_fill = 50000;  // Safety limit
-        int filled = 0;
+        while (!fill_stack_.empty()) {
+            auto [sx, sy] = fill_stack_.back();
+            fill_stack_.pop_back();
+            if (!open(sx, sy)) continue;
 
-        while (!stack.empty() && filled < max_fill) {
-            auto [cx, cy] = stack.back();
-            stack.pop_back();
+            int32_t x0 = sx;
+            int32_t x1 = sx;
+            while (open(x0 - 1, sy)) --x0;
+            while (open(x1 + 1, sy)) ++x1;
 
-            if (!world_.in_bounds(cx, cy)) continue;
-            if (world_.get_material(cx, cy) != target_material) continue;
+            uint8_t* row = &fill_visited_[static_cast<size_t>(sy) * width];
+            std::fill(row + x0, row + x1 + 1, 1);
+            stamp_spans_.push_back({sy, x0, x1});
 
-            place_material_cell(cx, cy, fill_material);
-            filled++;
+            // One seed per run of target cells on the rows above and below
+            for (int32_t ny : {sy - 1, sy + 1}) {
+                for (int32_t cx = x0; cx <= x1; ++cx) {
+                    if (!open(cx, ny)) continue;
+                    fill_stack_.push_back({cx, ny});
+                    while (cx + 1 <= x1 && open(cx + 1, ny)) ++cx;
+                }
+            }
+        }
 
-            // Add neighbors
-            stack.push_back({cx + 1, cy});
-            stack.push_back({cx - 1, cy});
-            stack.push_back({cx, cy + 1});
-            stack.push_back({cx, cy - 1});
+        // Unmark only what was filled, so the next fill starts clean
+        for (const RowSpan& span : stamp_spans_) {
+            uint8_t* row = &fill_visited_[static_cast<size_t>(span.y) * width];
+            std::fill(row + span.x0, row + span.x1 + 1, 0);
         }
+        world_.stamp_spans(stamp_spans_, fill_material);
     }
 
     // Returns: 0 = no click in UI, 1 = material selected, 2 = category toggled, 3 = favorite clicked
@@ -812,11 +770,9 @@ private:
                 case MenuSelection::Sandbox:
                     game_state_.current_mode = GameMode::Sandbox;
                     // Disable story mode hooks
-                    set_story_mode(false);
-                    set_discovery_callback(nullptr);
-                    set_material_unlock_checker(nullptr);
-                    world_.set_material_spawn_callback(nullptr);
-                    g_discovery_system_ptr = nullptr;
+                    world_.set_reaction_filter(nullptr);
+                    world_.set_discovery_events_enabled(false);
+                    world_.discovery_events().clear();
                     world_.clear_world();
                     create_initial_world();
                     std::cout << "Starting SANDBOX mode - all materials unlocked!\n";
@@ -825,13 +781,13 @@ private:
                 case MenuSelection::StoryMode:
                     game_state_.current_mode = GameMode::StoryMode;
                     discovery_system_.reset_to_starter_set();
-                    // Enable story mode hooks
-                    g_discovery_system_ptr = &discovery_system_;
-                    set_story_mode(true);
-                    set_discovery_callback(discovery_callback);
-                    set_material_unlock_checker(material_unlock_checker);
-                    // Safety net: unlock any material that spawns in the world
-                    world_.set_material_spawn_callback(material_spawn_callback);
+                    // Enable story mode hooks: reactions only between unlocked materials
+                    reaction_filter_ = discovery_system_.get_unlocked_materials();
+                    world_.set_reaction_filter(&reaction_filter_);
+                    // Combinations and the spawn safety net (unlock any material
+                    // that appears in the world) arrive as queued events
+                    world_.discovery_events().clear();
+                    world_.set_discovery_events_enabled(true);
                     world_.clear_world();
                     create_initial_world();
                     std::cout << "Starting STORY mode - discover materials by combining!\n";
@@ -988,6 +944,15 @@ private:
     void handle_input() {
         auto& input = const_cast<InputState&>(platform_.get_input_state());
 
+        // Take this update's mouse samples; whatever doesn't paint them
+        // drops them, and a stroke interrupted by another tool starts over
+        stroke_samples_.assign(input.mouse_samples, input.mouse_samples + input.mouse_sample_count);
+        input.mouse_sample_count = 0;
+        if (input.tool_mode != ToolMode::Brush || game_state_.current_mode != last_input_mode_) {
+            stroke_active_ = false;
+        }
+        last_input_mode_ = game_state_.current_mode;
+
         // Handle input based on current game mode
         switch (game_state_.current_mode) {
             case GameMode::MainMenu:
@@ -1203,13 +1168,9 @@ private:
         int32_t mx = input.mouse_x;
         int32_t my = input.mouse_y;
 
-        // Don't interact if clicking in the right UI area
+        // Don't interact if clicking in the UI panels
         int ui_height = get_ui_total_height();
-        bool in_ui = (mx >= UI_PANEL_X - 5 && my <= ui_height + 10);
-        // Also check left brush palette area
-        if (mx <= BRUSH_PANEL_X + BRUSH_PANEL_WIDTH + 5 && my <= 240) {
-            in_ui = true;
-        }
+        bool in_ui = is_over_ui(mx, my, ui_height);
 
         // ===== SHAPE TOOLS (Line, Rectangle, Circle) =====
         if (input.tool_mode == ToolMode::Line ||
@@ -1287,65 +1248,69 @@ private:
             int32_t y = my;
 
             if (in_ui) {
+                stroke_active_ = false;
                 return;
             }
 
             // Use configurable brush for all materials (including Life)
-            int32_t brush_radius = input.brush_radius;
-            BrushShape brush_shape = input.brush_shape;
-
-            for (int32_t dy = -brush_radius; dy <= brush_radius; ++dy) {
-                for (int32_t dx = -brush_radius; dx <= brush_radius; ++dx) {
-                    bool in_brush = false;
-
-                    // Check if pixel is within brush shape
-                    if (brush_shape == BrushShape::Circle) {
-                        // Circular brush - use distance check
-                        in_brush = (dx * dx + dy * dy <= brush_radius * brush_radius);
-                    } else {
-                        // Square brush - all pixels in square
-                        in_brush = true;
-                    }
-
-                    if (in_brush) {
-                        int32_t px = x + dx;
-                        int32_t py = y + dy;
-
-                        if (world_.in_bounds(px, py)) {
-                            if (input.mouse_left_down) {
-                                // CRITICAL: Clear cell state before placing new material
-                                // This prevents grass from inheriting burn state from previous fire/smoke
-                                Cell& cell = world_.get_cell(px, py);
-                                cell.flags = 0;  // Clear all flags (lifetime, flow_direction, updated)
-                                cell.velocity_y = 0;  // Clear velocity
-
-                                // Place selected material
-                                world_.set_material(px, py, input.selected_material);
-
-                                // Initialize properties for materials that need it
-                                if (input.selected_material == MaterialID::Fire) {
-                                    cell.set_lifetime(30);
-                                    cell.velocity_y = -5;  // Start rising
-                                } else if (input.selected_material == MaterialID::Steam) {
-                                    cell.velocity_y = -5;  // Start rising (no lifetime!)
-                                } else if (input.selected_material == MaterialID::Smoke) {
-                                    cell.set_lifetime(40);
-                                    cell.velocity_y = -3;  // Start rising
-                                } else if (input.selected_material == MaterialID::Ash) {
-                                    cell.velocity_y = -2;  // Start rising
-                                }
-                                // NOTE: Person material handled separately above
-                            } else if (input.mouse_right_down) {
-                                // Erase (place empty) - also clear state
-                                Cell& cell = world_.get_cell(px, py);
-                                cell.flags = 0;
-                                cell.velocity_y = 0;
-                                world_.set_material(px, py, MaterialID::Empty);
-                            }
-                        }
-                    }
-                }
+            build_brush_profile(input.brush_radius, input.brush_shape, brush_profile_);
+
+            // Sweep the brush through every mouse sample since the last
+            // update (continuing from where the stroke left off), so fast
+            // strokes stay continuous; stamp_spans merges the overlaps.
+            // Samples over the UI break the stroke: nothing is painted
+            // under a panel or swept across it
+            stamp_spans_.clear();
+            bool connected = stroke_active_;
+            int32_t from_x = stroke_x_;
+            int32_t from_y = stroke_y_;
+            for (const MouseSample& sample : stroke_samples_) {
+                if (is_over_ui(sample.x, sample.y, ui_height)) {
+                    connected = false;
+                    continue;
+                }
+                if (connected) {
+                    push_stroke_spans(from_x, from_y, sample.x, sample.y, brush_profile_);
+                } else {
+                    push_stroke_spans(sample.x, sample.y, sample.x, sample.y, brush_profile_);
+                    connected = true;
+                }
+                from_x = sample.x;
+                from_y = sample.y;
+            }
+            if (!connected) {
+                from_x = x;
+                from_y = y;
+            }
+            push_stroke_spans(from_x, from_y, x, y, brush_profile_);
+            stroke_active_ = true;
+            stroke_x_ = x;
+            stroke_y_ = y;
+
+            if (input.mouse_left_down) {
+                // Fresh cell state, so grass doesn't inherit burn state from
+                // previous fire/smoke; rising materials start with an upward push
+                MaterialID material = input.selected_material;
+                uint8_t lifetime = 0;
+                int8_t velocity_y = 0;
+                if (material == MaterialID::Fire) {
+                    lifetime = 30;
+                    velocity_y = -5;
+                } else if (material == MaterialID::Steam) {
+                    velocity_y = -5;  // No lifetime!
+                } else if (material == MaterialID::Smoke) {
+                    lifetime = 40;
+                    velocity_y = -3;
+                } else if (material == MaterialID::Ash) {
+                    velocity_y = -2;
+                }
+                world_.stamp_spans(stamp_spans_, material, lifetime, velocity_y);
+            } else {
+                // Erase (place empty) - also clears state
+                world_.stamp_spans(stamp_spans_, MaterialID::Empty);
             }
+        } else {
+            stroke_active_ = false;
         }
     }
 
@@ -1464,17 +1429,6 @@ private:
     }
 
     // Find material name by ID (searches all categories)
-    const char* find_material_name(MaterialID id) const {
-        for (int cat = 0; cat < NUM_CATEGORIES; cat++) {
-            for (int i = 0; i < categories_[cat].count; i++) {
-                if (categories_[cat].materials[i].id == id) {
-                    return categories_[cat].materials[i].name;
-                }
-            }
-        }
-        return "Unknown";
-    }
-
     void render_material_palette() {
         // Colors (fully opaque for transparency support)
         const uint32_t bg_color = 0xFF181818;        // Dark gray background
@@ -1689,7 +1643,7 @@ private:
         draw_filled_rect(x - 5, y, UI_PANEL_WIDTH + 10, 25, 0xFF000000);
 
         // Get selected material info
-        const char* selected_name = find_material_name(input.selected_material);
+        const char* selected_name = get_material_name(input.selected_material);
         Color sel_color = material_system_.get_material(input.selected_material).base_color;
 
         // Draw selected material swatch
@@ -1846,9 +1800,26 @@ private:
         const uint32_t text_color = 0xFFFFFFFF;
         const uint32_t warning_color = 0xFF0000FF;
 
+        // Top materials by cell count, straight from the world's census
+        const int histogram_rows = 6;
+        std::array<uint32_t, MaterialCensus::MATERIAL_COUNT> histogram;
+        world_.census().get_histogram(histogram);
+        std::array<int, histogram_rows> top;
+        top.fill(-1);
+        for (int material = 1; material < static_cast<int>(histogram.size()); ++material) {
+            if (histogram[material] == 0) continue;
+            for (int rank = 0; rank < histogram_rows; ++rank) {
+                if (top[rank] < 0 || histogram[material] > histogram[top[rank]]) {
+                    std::copy_backward(top.begin() + rank, top.end() - 1, top.end());
+                    top[rank] = material;
+                    break;
+                }
+            }
+        }
+
         // Draw background panel (shifted right to not overlap brush palette)
         int panel_x = BRUSH_PANEL_X + BRUSH_PANEL_WIDTH + 10;
-        draw_filled_rect(panel_x, 5, 150, 55, bg_color);
+        draw_filled_rect(panel_x, 5, 150, 75 + histogram_rows * 14, bg_color);
 
         // Draw FPS
         int y = 10;
@@ -1862,6 +1833,22 @@ private:
         // Draw active cells
         y += 15;
         draw_text(panel_x + 5, y, "Cells: " + std::to_string(active_cells_display_), text_color);
+
+        // Draw Person agents
+        y += 15;
+        draw_text(panel_x + 5, y, "People: " + std::to_string(world_.agents().get_count()), text_color);
+
+        // Material histogram: bar length relative to the most common material
+        y += 20;
+        const uint32_t bar_color = 0xFF808080;
+        for (int rank = 0; rank < histogram_rows && top[rank] >= 0; ++rank) {
+            uint32_t count = histogram[top[rank]];
+            int bar_width = static_cast<int>(140ull * count / histogram[top[0]]);
+            draw_filled_rect(panel_x + 5, y - 1, bar_width, 12, bar_color);
+            draw_text(panel_x + 7, y, std::string(get_material_name(static_cast<MaterialID>(top[rank]))) +
+                      " " + std::to_string(count), text_color);
+            y += 14;
+        }
     }
 
     void render_speed_indicator() {
@@ -2187,13 +2174,8 @@ private:
         int32_t x = input.mouse_x;
         int32_t y = input.mouse_y;
 
-        // Don't show preview if in right UI area
-        int ui_height = get_ui_total_height();
-        if (x >= UI_PANEL_X - 5 && y <= ui_height + 10) {
-            return;
-        }
-        // Don't show preview if in left brush palette area
-        if (x <= BRUSH_PANEL_X + BRUSH_PANEL_WIDTH + 5 && y <= 240) {
+        // Don't show preview over the UI panels
+        if (is_over_ui(x, y, get_ui_total_height())) {
             return;
         }
 
@@ -2362,153 +2344,133 @@ private:
     }
 
     void render_enhanced_people() {
-        // Make people more visible with AI STATE COLORS and animations
-        for (int32_t y = 0; y < WORLD_HEIGHT; y++) {
-            for (int32_t x = 0; x < WORLD_WIDTH; x++) {
-                if (world_.get_material(x, y) == MaterialID::Person) {
-                    Cell& cell = world_.get_cell(x, y);
-                    uint8_t health = cell.get_health();
-
-                    if (health == 0) continue;  // Dead, don't render
-
-                    // ========================================
-                    // DETECT AI STATE for visual feedback
-                    // ========================================
-
-                    bool touching_fire = false;
-                    bool touching_lava = false;
-                    bool in_water = false;
-
-                    for (int dy = -1; dy <= 1; dy++) {
-                        for (int dx = -1; dx <= 1; dx++) {
-                            int nx = x + dx;
-                            int ny = y + dy;
-                            if (world_.in_bounds(nx, ny)) {
-                                MaterialID neighbor = world_.get_material(nx, ny);
-                                if (neighbor == MaterialID::Fire) touching_fire = true;
-                                if (neighbor == MaterialID::Lava) touching_lava = true;
-                                if (neighbor == MaterialID::Water) in_water = true;
-                            }
-                        }
-                    }
-
-                    // ========================================
-                    // COLOR based on AI STATE (visible behavior)
-                    // ========================================
-
-                    uint32_t person_color;
-                    uint32_t outline_color = 0xFFFFFFFF;  // Default white outline
-
-                    if (touching_fire || touching_lava) {
-                        // PANIC STATE: Bright orange-red (on fire / panicking)
-                        person_color = 0xFFFF6000;
-                        outline_color = 0xFFFF0000;  // Red outline when burning
-                    } else if (in_water) {
-                        // SWIMMING STATE: Cyan-blue (in water)
-                        person_color = 0xFF00FFFF;
-                        outline_color = 0xFF0080FF;  // Blue outline when wet
-                    } else if (health < 30) {
-                        // LOW HEALTH STATE: Dark red (dying)
-                        person_color = 0xFF800000;
-                        outline_color = 0xFFFF0000;  // Red outline when dying
-                    } else if (health < 60) {
-                        // INJURED STATE: Yellow (hurt but ok)
-                        person_color = 0xFFFFFF00;
-                        outline_color = 0xFFFFAA00;  // Orange outline when injured
-                    } else {
-                        // HEALTHY STATE: Bright magenta (happy and healthy)
-                        person_color = 0xFFFF00FF;
-                        outline_color = 0xFFFFFFFF;  // White outline when healthy
-                    }
-
-                    // ========================================
-                    // DRAW 2x2 person block
-                    // ========================================
-
-                    for (int dy = 0; dy < 2; dy++) {
-                        for (int dx = 0; dx < 2; dx++) {
-                            int px = x + dx;
-                            int py = y + dy;
-                            if (px < WORLD_WIDTH && py < WORLD_HEIGHT) {
-                                pixel_buffer_[py * WORLD_WIDTH + px] = person_color;
-                            }
-                        }
+        // Make people more visible with AI STATE COLORS and animations.
+        // Cost scales with the number of people: the agent table lists them,
+        // the census says whether any hazard is near, and sprites are
+        // blitted from precomputed stamps.
+        const AgentTable& agents = world_.agents();
+        overlay_people_.clear();
+        agents.for_each([&](AgentHandle agent) {
+            uint8_t health = agents.get_health(agent);
+            if (health == 0) return;  // Dead, don't render
+
+            int32_t x = agents.get_x(agent);
+            int32_t y = agents.get_y(agent);
+
+            // ========================================
+            // COLOR based on AI STATE (visible behavior)
+            // ========================================
+            PersonMood mood = PersonMood::Healthy;
+            if (health < 30) {
+                mood = PersonMood::Dying;
+            } else if (health < 60) {
+                mood = PersonMood::Injured;
+            }
+
+            // Only look at the neighbors when the census puts a hazard nearby
+            bool hot_nearby = census_near(x, y, MaterialID::Fire) || census_near(x, y, MaterialID::Lava);
+            bool wet_nearby = census_near(x, y, MaterialID::Water);
+            if (hot_nearby || wet_nearby) {
+                bool touching_hot = false;
+                bool in_water = false;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        MaterialID neighbor = world_.get_material(x + dx, y + dy);
+                        if (neighbor == MaterialID::Fire || neighbor == MaterialID::Lava) touching_hot = true;
+                        if (neighbor == MaterialID::Water) in_water = true;
                     }
+                }
+                if (touching_hot) {
+                    mood = PersonMood::Panicking;
+                } else if (in_water) {
+                    mood = PersonMood::Swimming;
+                }
+            }
 
-                    // ========================================
-                    // DRAW STATE-COLORED OUTLINE
-                    // ========================================
+            overlay_people_.push_back({static_cast<int16_t>(x), static_cast<int16_t>(y), mood,
+                                       agents.is_facing_right(agent)});
+        });
 
-                    int outline_positions[][2] = {
-                        {-1, -1}, {0, -1}, {1, -1}, {2, -1},
-                        {-1, 0}, {2, 0},
-                        {-1, 1}, {2, 1},
-                        {-1, 2}, {0, 2}, {1, 2}, {2, 2}
-                    };
+        // Outlines first, so no outline ever covers another person's body
+        for (const OverlayPerson& person : overlay_people_) {
+            blit_stamp(person.x, person.y, PERSON_OUTLINE_STAMP,
+                       PERSON_MOOD_COLORS[static_cast<size_t>(person.mood)][1]);
+        }
 
-                    for (auto& pos : outline_positions) {
-                        int px = x + pos[0];
-                        int py = y + pos[1];
-                        if (px >= 0 && px < WORLD_WIDTH && py >= 0 && py < WORLD_HEIGHT) {
-                            // Only draw outline if not overlapping another person
-                            if (world_.get_material(px, py) != MaterialID::Person) {
-                                pixel_buffer_[py * WORLD_WIDTH + px] = outline_color;
-                            }
-                        }
-                    }
+        // 2x2 bodies, then the black "eye" showing facing
+        for (const OverlayPerson& person : overlay_people_) {
+            blit_stamp(person.x, person.y, PERSON_BODY_STAMP,
+                       PERSON_MOOD_COLORS[static_cast<size_t>(person.mood)][0]);
+            int eye_x = person.x + (person.facing_right ? 1 : 0);
+            if (eye_x < WORLD_WIDTH) {
+                pixel_buffer_[person.y * WORLD_WIDTH + eye_x] = 0xFF000000;
+            }
+        }
 
-                    // ========================================
-                    // FACING DIRECTION INDICATOR (small marker)
-                    // ========================================
+        // Also render Life particles with a sparkle effect
+        world_.for_each_cell_of(MaterialID::Life, [&](int32_t x, int32_t y, Cell& cell) {
+            uint8_t sparkle = cell.get_lifetime();
 
-                    bool facing_right = cell.get_person_facing_right();
-                    int eye_x = x + (facing_right ? 1 : 0);
-                    int eye_y = y;
+            // Animated sparkle color - cycles between pink and white
+            uint8_t intensity = 200 + (sparkle & 0x1F) * 2;
+            uint32_t life_color;
+            if ((sparkle & 0x08) != 0) {
+                // Pink phase
+                life_color = (0xFF << 24) | (intensity << 16) | ((intensity * 3 / 4) << 8) | intensity;
+            } else {
+                // White-ish phase
+                life_color = (0xFF << 24) | (intensity << 16) | (intensity << 8) | (intensity * 3 / 4);
+            }
 
-                    if (eye_x >= 0 && eye_x < WORLD_WIDTH && eye_y >= 0 && eye_y < WORLD_HEIGHT) {
-                        pixel_buffer_[eye_y * WORLD_WIDTH + eye_x] = 0xFF000000;  // Black "eye" shows facing
-                    }
-                }
+            // Draw the Life particle with a small glow over empty neighbors
+            pixel_buffer_[y * WORLD_WIDTH + x] = life_color;
+            blit_stamp(x, y, LIFE_GLOW_STAMP, 0x40FF80FF, [&](int32_t gx, int32_t gy) {
+                return world_.get_material(gx, gy) == MaterialID::Empty;
+            });
+        });
+    }
 
-                // Also render Life particles with a sparkle effect
-                if (world_.get_material(x, y) == MaterialID::Life) {
-                    Cell& cell = world_.get_cell(x, y);
-                    uint8_t sparkle = cell.get_lifetime();
-
-                    // Animated sparkle color - cycles between pink and white
-                    uint8_t intensity = 200 + (sparkle & 0x1F) * 2;
-                    uint32_t life_color;
-                    if ((sparkle & 0x08) != 0) {
-                        // Pink phase
-                        life_color = (0xFF << 24) | (intensity << 16) | ((intensity * 3 / 4) << 8) | intensity;
-                    } else {
-                        // White-ish phase
-                        life_color = (0xFF << 24) | (intensity << 16) | (intensity << 8) | (intensity * 3 / 4);
-                    }
+    // True if a chunk touched by the 3x3 block around (x, y) holds the material
+    bool census_near(int32_t x, int32_t y, MaterialID material) const {
+        const MaterialCensus& census = world_.census();
+        int32_t chunk_x0 = std::max(x - 1, 0) / CHUNK_SIZE;
+        int32_t chunk_x1 = std::min(x + 1, WORLD_WIDTH - 1) / CHUNK_SIZE;
+        int32_t chunk_y0 = std::max(y - 1, 0) / CHUNK_SIZE;
+        int32_t chunk_y1 = std::min(y + 1, WORLD_HEIGHT - 1) / CHUNK_SIZE;
+        for (int32_t chunk_y = chunk_y0; chunk_y <= chunk_y1; ++chunk_y) {
+            for (int32_t chunk_x = chunk_x0; chunk_x <= chunk_x1; ++chunk_x) {
+                if (census.chunk_contains(chunk_y * world_.get_chunks_wide() + chunk_x, material)) return true;
+            }
+        }
+        return false;
+    }
 
-                    // Draw the Life particle with a small glow
-                    pixel_buffer_[y * WORLD_WIDTH + x] = life_color;
-
-                    // Add glow effect around it
-                    uint32_t glow_color = 0x40FF80FF;  // Semi-transparent magenta
-                    for (int dy = -1; dy <= 1; dy++) {
-                        for (int dx = -1; dx <= 1; dx++) {
-                            if (dx == 0 && dy == 0) continue;
-                            int gx = x + dx, gy = y + dy;
-                            if (gx >= 0 && gx < WORLD_WIDTH && gy >= 0 && gy < WORLD_HEIGHT) {
-                                MaterialID neighbor = world_.get_material(gx, gy);
-                                if (neighbor == MaterialID::Empty) {
-                                    // Blend glow with existing pixel (simple additive)
-                                    pixel_buffer_[gy * WORLD_WIDTH + gx] = glow_color;
-                                }
-                            }
-                        }
-                    }
-                }
+    // Draw a stamp anchored at (x, y) where keep(px, py) allows. Sprites
+    // clear of the world edge skip clipping and use the precomputed offsets.
+    template <size_t N, typename Keep>
+    void blit_stamp(int32_t x, int32_t y, const StampPixel (&stamp)[N], uint32_t color, Keep&& keep) {
+        if (x >= STAMP_REACH && x < WORLD_WIDTH - STAMP_REACH &&
+            y >= STAMP_REACH && y < WORLD_HEIGHT - STAMP_REACH) {
+            uint32_t* anchor = pixel_buffer_.data() + y * WORLD_WIDTH + x;
+            for (const StampPixel& pixel : stamp) {
+                if (keep(x + pixel.dx, y + pixel.dy)) anchor[pixel.offset] = color;
+            }
+            return;
+        }
+        for (const StampPixel& pixel : stamp) {
+            int32_t px = x + pixel.dx;
+            int32_t py = y + pixel.dy;
+            if (px >= 0 && px < WORLD_WIDTH && py >= 0 && py < WORLD_HEIGHT && keep(px, py)) {
+                pixel_buffer_[py * WORLD_WIDTH + px] = color;
             }
         }
     }
 
+    template <size_t N>
+    void blit_stamp(int32_t x, int32_t y, const StampPixel (&stamp)[N], uint32_t color) {
+        blit_stamp(x, y, stamp, color, [](int32_t, int32_t) { return true; });
+    }
+
     void render() {
         // Render based on current game mode
         switch (game_state_.current_mode) {
@@ -3037,21 +2999,22 @@ private:
     }
 
     const char* get_material_name(MaterialID id) const {
-        for (int c = 0; c < NUM_CATEGORIES; c++) {
-            for (int m = 0; m < categories_[c].count; m++) {
-                if (categories_[c].materials[m].id == id) {
-                    return categories_[c].materials[m].name;
-                }
-            }
-        }
-        return "Unknown";
+        if (id >= MaterialID::COUNT) return "Unknown";
+        return Materials::MATERIAL_LABELS[static_cast<size_t>(id)];
     }
 };
 
 // Main entry point
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    // Headless batch mode: step many independent worlds across all cores
+    if (argc > 1 && std::strcmp(argv[1], "--farm") == 0) {
+        return run_world_farm_cli(argc, argv);
+    }
+
+    // Headless per-material timing of the cell rules
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        return run_material_bench_cli(argc, argv);
+    }
 
     PixelEngineApp app;
 